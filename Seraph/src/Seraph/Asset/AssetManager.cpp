@@ -5,17 +5,21 @@ namespace Seraph
 
 Ref<AssetManagerBase> AssetManager::s_Active;
 std::mutex AssetManager::s_Mutex;
+std::atomic<u64> AssetManager::s_Generation{0};
+std::atomic<u64> AssetManager::s_LoadGeneration{0};
 
 void AssetManager::Init(Ref<AssetManagerBase> manager)
 {
     std::lock_guard lock(s_Mutex);
     s_Active = manager;
+    BumpGeneration();
 }
 
 void AssetManager::Shutdown()
 {
     std::lock_guard lock(s_Mutex);
     s_Active = nullptr;
+    BumpGeneration();
 }
 
 Ref<AssetManagerBase> AssetManager::Get()
@@ -11,6 +11,7 @@
 #include "Seraph/Asset/AssetManagerBase.h"
 #include "Seraph/Core/Ref.h"
 
+#include <atomic>
 #include <mutex>
 #include <type_traits>
 #include <utility>
@@ -59,9 +60,25 @@ public:
     static bool IsAsyncEnabled();
     static void SyncFinalizeMainThread();
 
+    // Counters for caches of resolved asset handles (material bind blocks),
+    // compared instead of looking every handle up again:
+    //   * Generation — bumped when a loaded asset object is replaced or dropped
+    //     (reload, unload, removal, a memory asset re-added under its handle).
+    //     Anything resolved before may now point at a stale object.
+    //   * LoadGeneration — bumped when a handle's asset first appears (load
+    //     finished, memory asset added). Only a cache that found a handle
+    //     missing can be affected, so one that resolved everything ignores it;
+    //     streaming a level in does not recompile every material.
+    static u64 GetGeneration() { return s_Generation.load(std::memory_order_acquire); }
+    static void BumpGeneration() { s_Generation.fetch_add(1, std::memory_order_acq_rel); }
+    static u64 GetLoadGeneration() { return s_LoadGeneration.load(std::memory_order_acquire); }
+    static void BumpLoadGeneration() { s_LoadGeneration.fetch_add(1, std::memory_order_acq_rel); }
+
 private:
     static Ref<AssetManagerBase> s_Active;
     static std::mutex s_Mutex;
+    static std::atomic<u64> s_Generation;
+    static std::atomic<u64> s_LoadGeneration;
 };
 
 } // namespace Seraph
@@ -1,6 +1,7 @@
 #include "EditorAssetManager.h"
 
 #include "Seraph/Asset/AssetImporter.h"
+#include "Seraph/Asset/AssetManager.h"
 #include "Seraph/Asset/AssetSource.h"
 #include "Seraph/Core/FileSystem.h"
 #include "Seraph/Core/Log.h"
@@ -128,6 +129,7 @@ Ref<Asset> EditorAssetManager::GetAsset(AssetHandle handle)
         return it->second;
     m_LoadedAssets[handle] = asset;
     m_Status[handle] = AssetStatus::Ready;
+    AssetManager::BumpLoadGeneration();
     if (auto it = m_Registry.find(handle); it != m_Registry.end())
         it->second.IsDataLoaded = true;
     return asset;
@@ -200,6 +202,7 @@ void EditorAssetManager::SyncFinalizeMainThread()
             std::unique_lock lock(m_Mutex);
             m_LoadedAssets[result.handle] = result.asset;
             m_Status[result.handle] = AssetStatus::Ready;
+            AssetManager::BumpLoadGeneration();
             if (auto it = m_Registry.find(result.handle); it != m_Registry.end())
                 it->second.IsDataLoaded = true;
         } else {
@@ -281,9 +284,15 @@ AssetHandle EditorAssetManager::AddMemoryAsset(Ref<Asset> asset)
     metadata.IsDataLoaded = true;
 
     std::unique_lock lock(m_Mutex);
+    const bool replaced = m_MemoryAssets.find(handle) != m_MemoryAssets.end() ||
+                          m_LoadedAssets.find(handle) != m_LoadedAssets.end();
     m_MemoryAssets[handle] = asset;
     m_Registry[handle] = metadata;
     m_Status[handle] = AssetStatus::Ready;
+    if (replaced)
+        AssetManager::BumpGeneration();
+    else
+        AssetManager::BumpLoadGeneration();
     return handle;
 }
 
@@ -298,6 +307,7 @@ bool EditorAssetManager::ReloadData(AssetHandle handle)
         metadata = it->second;
         m_LoadedAssets.erase(handle);
         m_Status[handle] = AssetStatus::None;
+        AssetManager::BumpGeneration();
     }
     return GetAsset(handle) != nullptr;
 }
@@ -360,6 +370,7 @@ void EditorAssetManager::RemoveAsset(AssetHandle handle, bool deleteFile)
         m_LoadedAssets.erase(handle);
         m_MemoryAssets.erase(handle);
         m_Status.erase(handle);
+        AssetManager::BumpGeneration();
     }
 
     if (!fileToDelete.empty()) {
@@ -707,6 +718,7 @@ AssetHandle EditorAssetManager::SaveAssetAs(
         m_LoadedAssets[handle] = asset; // now file-backed
         m_MemoryAssets.erase(handle);   // in case it was procedural
         m_Status[handle] = AssetStatus::Ready;
+        AssetManager::BumpGeneration();
     }
 
     SerializeAssetRegistry();
@@ -812,6 +824,7 @@ AssetHandle EditorAssetManager::RegisterCookedShader(
         m_LoadedAssets.erase(handle); // drop any cached program; forces a reload
         m_Registry[handle] = metadata;
         m_Status[handle] = AssetStatus::None;
+        AssetManager::BumpGeneration();
     }
     ShaderManager::RegisterCooked(name, handle);
     return handle;
@@ -876,6 +889,7 @@ void EditorAssetManager::ReloadShaders()
                 m_LoadedAssets.erase(o.Handle);
                 m_Status.erase(o.Handle);
             }
+            AssetManager::BumpGeneration();
         }
         for (const Orphan& o : orphans) {
             ShaderManager::UnregisterCooked(o.Name);
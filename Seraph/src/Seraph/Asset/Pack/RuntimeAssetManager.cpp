@@ -1,6 +1,7 @@
 #include "RuntimeAssetManager.h"
 
 #include "Seraph/Asset/AssetImporter.h"
+#include "Seraph/Asset/AssetManager.h"
 #include "Seraph/Core/Buffer.h"
 #include "Seraph/Core/Log.h"
 
@@ -75,6 +76,7 @@ Ref<Asset> RuntimeAssetManager::GetAsset(AssetHandle handle)
         return it->second;
     m_LoadedAssets[handle] = asset;
     m_Status[handle] = AssetStatus::Ready;
+    AssetManager::BumpLoadGeneration();
     return asset;
 }
 
@@ -147,9 +149,15 @@ AssetHandle RuntimeAssetManager::AddMemoryAsset(Ref<Asset> asset)
     metadata.IsDataLoaded = true;
 
     std::unique_lock lock(m_Mutex);
+    const bool replaced = m_MemoryAssets.find(handle) != m_MemoryAssets.end() ||
+                          m_LoadedAssets.find(handle) != m_LoadedAssets.end();
     m_MemoryAssets[handle] = asset;
     m_Metadata[handle] = metadata;
     m_Status[handle] = AssetStatus::Ready;
+    if (replaced)
+        AssetManager::BumpGeneration();
+    else
+        AssetManager::BumpLoadGeneration();
     return handle;
 }
 
@@ -161,6 +169,7 @@ bool RuntimeAssetManager::ReloadData(AssetHandle handle)
             return false;
         m_LoadedAssets.erase(handle);
         m_Status[handle] = AssetStatus::None;
+        AssetManager::BumpGeneration();
     }
     return GetAsset(handle) != nullptr;
 }
@@ -2,12 +2,18 @@
 
 #include "Seraph/Core/Log.h"
 #include "Seraph/Graphics/Mesh.h"
+#include "Seraph/Graphics/MeshOptimizer.h"
+#include "Seraph/Graphics/MeshSimplifier.h"
+#include "Seraph/Graphics/RenderSystem.h"
 
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
 
+#include <glm/gtc/packing.hpp>
+
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <limits>
@@ -23,15 +29,27 @@ namespace
 // Native binary mesh format. Same house style as ShaderSerializer: fixed POD
 // structs, memcpy'd via a manual cursor, native endianness, reserved fields for
 // forward-compat, all section sizes derivable from the header (bounds-checked).
-// Section order: header -> attribute directory -> submesh table -> vertex blob
-// -> index blob. No material-slot table: slots are binding points, the file
-// stores only their count and the submesh->slot mapping.
+// Section order: header -> attribute directory -> submesh table -> slot table
+// (v2+) -> bounds table (v3+) -> LOD tables (v4+) -> vertex decode (v5+) ->
+// vertex blob -> index blob.
+// No material-slot table: slots are binding points, the file stores only their
+// count and the submesh->slot mapping.
 
 constexpr char c_MeshMagic[4] = {'S', 'M', 'S', 'H'};
 // v1: header + attributes + submeshes + vertex blob + index blob.
 // v2: adds a per-slot default-material table (u64 handle * MaterialSlotCount)
 //     between the submesh table and the vertex blob.
-constexpr u32 c_MeshVersion = 2;
+// v3: adds an object-space bounds table (whole mesh, then one per submesh) after
+//     the slot table. Older files get their bounds computed on load.
+// v4: adds the level-of-detail chain after the bounds table: LodCount - 1 level
+//     entries, then one index range per submesh for each level. The level
+//     indices live in the index blob after LOD 0's.
+// v5: adds the position decode (scale + offset) for quantized vertex formats
+//     after the LOD tables. Older files are float-position (identity).
+// v6: same layout; submesh indices (every LOD) are now relative to the
+//     submesh's BaseVertex. Older files stored absolute indices, so their
+//     BaseVertex is read as 0.
+constexpr u32 c_MeshVersion = 6;
 
 struct MeshFileHeader
 {
@@ -44,7 +62,8 @@ struct MeshFileHeader
     u32 AttributeCount;
     u32 SubmeshCount;
     u32 MaterialSlotCount; // binding-point count; validates submesh indices
-    u32 Reserved[4];       // future: AABB, LOD count, flags, slot-metadata offset
+    u32 LodCount;          // v4+: levels incl. LOD 0; 0 (older files) or 1 = none
+    u32 Reserved[3];       // future: flags, slot-metadata offset
 };
 
 struct MeshAttributeEntry
@@ -63,7 +82,55 @@ struct MeshSubmeshEntry
     u32 BaseIndex;
     u32 IndexCount;
     u32 MaterialSlot;
-    u32 Reserved[2]; // future: per-submesh AABB
+    u32 Reserved[2];
+};
+
+// v3 bounds table entry (AABB). Entry 0 is the whole mesh, entry 1 + i is
+// submesh i.
+struct MeshBoundsEntry
+{
+    float Min[3];
+    float Max[3];
+};
+
+MeshBoundsEntry EncodeBounds(const AABB& box)
+{
+    MeshBoundsEntry e{};
+    for (int i = 0; i < 3; ++i) {
+        e.Min[i] = box.Min[i];
+        e.Max[i] = box.Max[i];
+    }
+    return e;
+}
+
+AABB DecodeBounds(const MeshBoundsEntry& e)
+{
+    return {{e.Min[0], e.Min[1], e.Min[2]}, {e.Max[0], e.Max[1], e.Max[2]}};
+}
+
+// v4 LOD table entry: one per level past LOD 0, coarsest last. The per-submesh
+// ranges follow all level entries, SubmeshCount per level in level order.
+struct MeshLodEntry
+{
+    float Error;      // object-space simplification error
+    u32 BaseIndex;    // whole-level range
+    u32 IndexCount;
+    u32 Reserved;
+};
+
+struct MeshLodRangeEntry
+{
+    u32 BaseIndex;
+    u32 IndexCount;
+};
+
+// v5 vertex decode: object-space position = stored * PositionScale +
+// PositionOffset (see Mesh::SetPositionDecode).
+struct MeshVertexDecodeEntry
+{
+    float PositionScale[3];
+    float PositionOffset[3];
+    u32 Reserved[2];
 };
 
 // Our own stable codes for vertex-attribute semantics/types. We translate to and
@@ -245,10 +312,20 @@ Ref<Asset> ParseSMesh(const Buffer& bytes)
     // v2+ stores a u64 default-material handle per slot after the submesh table.
     const u64 slotBytes =
         header.Version >= 2 ? static_cast<u64>(slotCount) * sizeof(u64) : 0;
+    // v3+ stores the mesh AABB then one per submesh after the slot table.
+    const u64 boundsBytes = header.Version >= 3
+        ? (1 + static_cast<u64>(header.SubmeshCount)) * sizeof(MeshBoundsEntry)
+        : 0;
+    // v4+ stores LodCount - 1 level entries then their per-submesh ranges.
+    const u32 lodLevels = header.Version >= 4 && header.LodCount > 1 ? header.LodCount - 1 : 0;
+    const u32 lodRangesPerLevel = std::max(header.SubmeshCount, 1u);
+    const u64 lodBytes = static_cast<u64>(lodLevels) *
+        (sizeof(MeshLodEntry) + static_cast<u64>(lodRangesPerLevel) * sizeof(MeshLodRangeEntry));
+    const u64 decodeBytes = header.Version >= 5 ? sizeof(MeshVertexDecodeEntry) : 0;
     const u64 vertexBytes = static_cast<u64>(header.VertexCount) * header.VertexStride;
     const u64 indexBytes = static_cast<u64>(header.IndexCount) * header.IndexSize;
     const u64 required = sizeof(header) + attrBytes + submeshBytes + slotBytes +
-        vertexBytes + indexBytes;
+        boundsBytes + lodBytes + decodeBytes + vertexBytes + indexBytes;
     if (bytes.Size() < required) {
         SP_CORE_ERROR_TAG("Mesh", ".smesh is truncated");
         return nullptr;
@@ -274,6 +351,51 @@ Ref<Asset> ParseSMesh(const Buffer& bytes)
         cursor += slotBytes;
     }
 
+    std::vector<MeshBoundsEntry> boundsEntries;
+    if (boundsBytes > 0) {
+        boundsEntries.resize(1 + header.SubmeshCount);
+        std::memcpy(boundsEntries.data(), cursor, boundsBytes);
+        cursor += boundsBytes;
+    }
+
+    std::vector<Mesh::Lod> lods(lodLevels);
+    for (Mesh::Lod& lod : lods) {
+        MeshLodEntry e{};
+        std::memcpy(&e, cursor, sizeof(e));
+        cursor += sizeof(e);
+        lod.Error = e.Error;
+        lod.Range = {e.BaseIndex, e.IndexCount};
+    }
+    for (Mesh::Lod& lod : lods) {
+        lod.Submeshes.resize(lodRangesPerLevel);
+        for (Mesh::IndexRange& range : lod.Submeshes) {
+            MeshLodRangeEntry e{};
+            std::memcpy(&e, cursor, sizeof(e));
+            cursor += sizeof(e);
+            range = {e.BaseIndex, e.IndexCount};
+        }
+    }
+    // Every range must lie inside the index blob; a bad chain is dropped rather
+    // than failing the whole mesh (LOD 0 is still drawable).
+    const auto rangeValid = [&](const Mesh::IndexRange& r) {
+        return static_cast<u64>(r.BaseIndex) + r.IndexCount <= header.IndexCount;
+    };
+    const bool lodsValid = lods.size() < Mesh::c_MaxLods &&
+        std::all_of(lods.begin(), lods.end(), [&](const Mesh::Lod& lod) {
+            return rangeValid(lod.Range) &&
+                std::all_of(lod.Submeshes.begin(), lod.Submeshes.end(), rangeValid);
+        });
+    if (!lodsValid) {
+        SP_CORE_WARN_TAG("Mesh", ".smesh LOD table is invalid; using LOD 0 only");
+        lods.clear();
+    }
+
+    MeshVertexDecodeEntry decode{{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {}};
+    if (decodeBytes > 0) {
+        std::memcpy(&decode, cursor, sizeof(decode));
+        cursor += sizeof(decode);
+    }
+
     const u8* vertexData = cursor;
     cursor += vertexBytes;
     const u8* indexData = cursor;
@@ -290,12 +412,29 @@ Ref<Asset> ParseSMesh(const Buffer& bytes)
 
     std::vector<Mesh::Submesh> submeshes;
     submeshes.reserve(submeshEntries.size());
-    for (const MeshSubmeshEntry& e : submeshEntries)
-        submeshes.push_back({e.BaseVertex, e.BaseIndex, e.IndexCount, e.MaterialSlot});
+    for (size_t i = 0; i < submeshEntries.size(); ++i) {
+        const MeshSubmeshEntry& e = submeshEntries[i];
+        const u32 baseVertex = header.Version >= 6 ? e.BaseVertex : 0;
+        Mesh::Submesh submesh{baseVertex, e.BaseIndex, e.IndexCount, e.MaterialSlot};
+        if (!boundsEntries.empty())
+            submesh.Bounds = DecodeBounds(boundsEntries[1 + i]);
+        submeshes.push_back(submesh);
+    }
     mesh->SetSubmeshes(std::move(submeshes));
     mesh->SetMaterialSlotCount(slotCount);
     if (!slotDefaults.empty())
         mesh->SetMaterialSlotDefaults(std::move(slotDefaults));
+    mesh->SetLods(std::move(lods));
+    mesh->SetPositionDecode(
+        {decode.PositionScale[0], decode.PositionScale[1], decode.PositionScale[2]},
+        {decode.PositionOffset[0], decode.PositionOffset[1], decode.PositionOffset[2]});
+
+    // Pre-v3 files (or a v3 file saved without bounds) carry none; derive them
+    // from the staged geometry.
+    if (!boundsEntries.empty() && DecodeBounds(boundsEntries[0]).IsValid())
+        mesh->SetBounds(DecodeBounds(boundsEntries[0]));
+    else
+        mesh->ComputeBounds();
 
     return mesh; // Upload happens in Finalize (main thread)
 }
@@ -327,6 +466,175 @@ bgfx::VertexLayout BuildMeshLayout()
     return layout;
 }
 
+// MeshVertexFormat::Compressed / Quantized. Same attributes in the same order;
+// the shader-side decode is shader/vertex.sh. Position is 4 x snorm16 when
+// quantized (the 4th component pads to a 4-byte boundary).
+struct CompressedSurface
+{
+    u32 abgr;
+    u16 u, v;           // half floats
+    s16 nx, ny;         // octahedral normal, snorm16
+    u8 tx, ty, tw, pad; // octahedral tangent (unorm8 of [-1, 1]), handedness 0/255
+};
+
+struct CompressedMeshVertex
+{
+    float x, y, z;
+    CompressedSurface surface;
+};
+
+struct QuantizedMeshVertex
+{
+    s16 x, y, z, w; // (p - offset) / scale, snorm16
+    CompressedSurface surface;
+};
+
+bgfx::VertexLayout BuildCompressedMeshLayout(bool quantizedPositions)
+{
+    bgfx::VertexLayout layout;
+    layout.begin();
+    if (quantizedPositions)
+        layout.add(bgfx::Attrib::Position, 4, bgfx::AttribType::Int16, true);
+    else
+        layout.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float);
+    layout.add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true)
+        .add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Half)
+        .add(bgfx::Attrib::Normal, 2, bgfx::AttribType::Int16, true)
+        .add(bgfx::Attrib::Tangent, 4, bgfx::AttribType::Uint8, true)
+        .end();
+    return layout;
+}
+
+// Octahedral encoding of a direction into [-1, 1]^2: project onto the octahedron
+// |x| + |y| + |z| = 1 and fold the lower hemisphere over the diagonals.
+glm::vec2 OctEncode(const glm::vec3& n)
+{
+    const float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    if (l1 <= 0.0f)
+        return {0.0f, 0.0f}; // decodes to +Z
+    glm::vec2 e = glm::vec2(n) / l1;
+    if (n.z < 0.0f) {
+        const glm::vec2 sign(e.x >= 0.0f ? 1.0f : -1.0f, e.y >= 0.0f ? 1.0f : -1.0f);
+        e = (1.0f - glm::abs(glm::vec2(e.y, e.x))) * sign;
+    }
+    return e;
+}
+
+s16 PackSnorm16(float value)
+{
+    return static_cast<s16>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+u8 PackUnorm8(float value)
+{
+    return static_cast<u8>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+CompressedSurface CompressSurface(const MeshVertex& vertex)
+{
+    CompressedSurface out{};
+    out.abgr = vertex.abgr;
+    out.u = glm::packHalf1x16(vertex.u);
+    out.v = glm::packHalf1x16(vertex.v);
+    const glm::vec2 n = OctEncode({vertex.nx, vertex.ny, vertex.nz});
+    out.nx = PackSnorm16(n.x);
+    out.ny = PackSnorm16(n.y);
+    const glm::vec2 t = OctEncode({vertex.tx, vertex.ty, vertex.tz});
+    out.tx = PackUnorm8(t.x * 0.5f + 0.5f);
+    out.ty = PackUnorm8(t.y * 0.5f + 0.5f);
+    out.tw = vertex.tw < 0.0f ? 0 : 255;
+    return out;
+}
+
+// Convert imported float vertices to `format`, staging the vertex data and
+// layout (and, for quantized positions, the decode) on `mesh`.
+void StageImportedVertices(
+    Mesh& mesh, const std::vector<MeshVertex>& vertices, MeshVertexFormat format)
+{
+    if (format == MeshVertexFormat::Float) {
+        mesh.SetVertexLayout(BuildMeshLayout());
+        mesh.StageVertexData(
+            vertices.data(), static_cast<u32>(vertices.size() * sizeof(MeshVertex)));
+        return;
+    }
+
+    mesh.SetVertexLayout(BuildCompressedMeshLayout(format == MeshVertexFormat::Quantized));
+    if (format == MeshVertexFormat::Compressed) {
+        std::vector<CompressedMeshVertex> packed(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i)
+            packed[i] = {vertices[i].x, vertices[i].y, vertices[i].z,
+                         CompressSurface(vertices[i])};
+        mesh.StageVertexData(
+            packed.data(), static_cast<u32>(packed.size() * sizeof(CompressedMeshVertex)));
+        return;
+    }
+
+    // Quantize to the vertex bounds: stored = (p - centre) / halfExtent.
+    AABB box;
+    for (const MeshVertex& vertex : vertices)
+        box.Expand({vertex.x, vertex.y, vertex.z});
+    const glm::vec3 offset = box.Center();
+    const glm::vec3 scale = glm::max(box.Extents(), glm::vec3(1e-6f));
+    std::vector<QuantizedMeshVertex> packed(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const glm::vec3 p(vertices[i].x, vertices[i].y, vertices[i].z);
+        const glm::vec3 q = (p - offset) / scale;
+        packed[i] = {PackSnorm16(q.x), PackSnorm16(q.y), PackSnorm16(q.z), 0,
+                     CompressSurface(vertices[i])};
+    }
+    mesh.SetPositionDecode(scale, offset);
+    mesh.StageVertexData(
+        packed.data(), static_cast<u32>(packed.size() * sizeof(QuantizedMeshVertex)));
+}
+
+// Largest vertex run one 16-bit submesh addresses. 0xFFFF itself is left
+// unused (the primitive-restart value on some backends).
+constexpr u32 c_MaxChunkVertices16 = std::numeric_limits<u16>::max();
+
+// Append one source mesh's triangles as submeshes of at most `maxVertices`
+// distinct vertices each, with indices relative to their own BaseVertex.
+// Triangles keep their order; a vertex used on both sides of a split is
+// duplicated into each chunk.
+void AppendChunked(
+    const std::vector<MeshVertex>& source, const std::vector<u32>& triangles,
+    const u32 materialSlot, const u32 maxVertices, std::vector<MeshVertex>& vertices,
+    std::vector<u32>& indices, std::vector<Mesh::Submesh>& submeshes)
+{
+    constexpr u32 unmapped = ~0u;
+    std::vector<u32> local(source.size(), unmapped); // source -> chunk vertex
+    std::vector<u32> used;                           // source vertices in the chunk
+    Mesh::Submesh chunk{static_cast<u32>(vertices.size()), static_cast<u32>(indices.size()),
+                        0, materialSlot};
+    const auto close = [&] {
+        chunk.IndexCount = static_cast<u32>(indices.size()) - chunk.BaseIndex;
+        if (chunk.IndexCount > 0)
+            submeshes.push_back(chunk);
+        for (const u32 v : used)
+            local[v] = unmapped;
+        used.clear();
+        chunk.BaseVertex = static_cast<u32>(vertices.size());
+        chunk.BaseIndex = static_cast<u32>(indices.size());
+    };
+
+    for (size_t t = 0; t + 2 < triangles.size(); t += 3) {
+        u32 added = 0;
+        for (u32 k = 0; k < 3; ++k)
+            added += local[triangles[t + k]] == unmapped ? 1 : 0;
+        if (used.size() + added > maxVertices)
+            close();
+        for (u32 k = 0; k < 3; ++k) {
+            const u32 v = triangles[t + k];
+            if (local[v] == unmapped) {
+                local[v] = static_cast<u32>(used.size());
+                used.push_back(v);
+                vertices.push_back(source[v]);
+            }
+            indices.push_back(local[v]);
+        }
+    }
+    close();
+}
+
 Ref<Asset> LoadFromAssimp(const AssetMetadata& metadata, const Buffer& bytes)
 {
     Assimp::Importer importer;
@@ -349,23 +657,19 @@ Ref<Asset> LoadFromAssimp(const AssetMetadata& metadata, const Buffer& bytes)
         return nullptr;
     }
 
+    const bool index32 = RenderSystem::GetSettings().MeshImport32BitIndices;
+    const u32 maxChunkVertices =
+        index32 ? std::numeric_limits<u32>::max() : c_MaxChunkVertices16;
     std::vector<MeshVertex> vertices;
-    std::vector<u16> indices;
+    std::vector<u32> indices;
     std::vector<Mesh::Submesh> submeshes;
 
+    std::vector<MeshVertex> source;
+    std::vector<u32> triangles;
     for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
         const aiMesh* mesh = scene->mMeshes[m];
-        const auto baseVertex = static_cast<u32>(vertices.size());
-        const auto baseIndex = static_cast<u32>(indices.size());
-
-        if (baseVertex + mesh->mNumVertices > std::numeric_limits<u16>::max()) {
-            SP_CORE_ERROR_TAG(
-                "Assimp",
-                "'{}' exceeds the 65535-vertex limit for 16-bit indices; "
-                "truncating import.",
-                metadata.FilePath.string());
-            break;
-        }
+        source.clear();
+        triangles.clear();
 
         for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
             MeshVertex vertex{};
@@ -397,7 +701,7 @@ Ref<Asset> LoadFromAssimp(const AssetMetadata& metadata, const Buffer& bytes)
             } else {
                 vertex.tw = 1.0f;
             }
-            vertices.push_back(vertex);
+            source.push_back(vertex);
         }
 
         for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
@@ -405,13 +709,16 @@ Ref<Asset> LoadFromAssimp(const AssetMetadata& metadata, const Buffer& bytes)
             if (face.mNumIndices != 3)
                 continue; // triangulated above; skip anything degenerate
             for (unsigned int i = 0; i < 3; ++i)
-                indices.push_back(static_cast<u16>(baseVertex + face.mIndices[i]));
+                triangles.push_back(face.mIndices[i]);
         }
 
-        const auto indexCount = static_cast<u32>(indices.size()) - baseIndex;
-        if (indexCount > 0)
-            submeshes.push_back(
-                {baseVertex, baseIndex, indexCount, mesh->mMaterialIndex});
+        const size_t before = submeshes.size();
+        AppendChunked(source, triangles, mesh->mMaterialIndex, maxChunkVertices,
+                      vertices, indices, submeshes);
+        if (submeshes.size() - before > 1)
+            SP_CORE_INFO_TAG(
+                "Assimp", "'{}': source mesh {} has {} vertices; split into {} 16-bit submeshes",
+                metadata.FilePath.string(), m, mesh->mNumVertices, submeshes.size() - before);
     }
 
     if (vertices.empty() || indices.empty()) {
@@ -423,18 +730,32 @@ Ref<Asset> LoadFromAssimp(const AssetMetadata& metadata, const Buffer& bytes)
 
     Ref<Mesh> outMesh = Ref<Mesh>::Create();
     outMesh->SetName(metadata.FilePath.filename().string());
-    outMesh->SetVertexLayout(BuildMeshLayout());
-    outMesh->StageVertexData(
-        vertices.data(), static_cast<u32>(vertices.size() * sizeof(MeshVertex)));
-    outMesh->StageIndexData(
-        indices.data(), static_cast<u32>(indices.size() * sizeof(u16)), sizeof(u16));
+    const MeshVertexFormat format = RenderSystem::GetSettings().MeshImportFormat;
+    StageImportedVertices(*outMesh, vertices, format);
+    if (index32) {
+        outMesh->StageIndexData(
+            indices.data(), static_cast<u32>(indices.size() * sizeof(u32)), sizeof(u32));
+    } else {
+        const std::vector<u16> narrow(indices.begin(), indices.end());
+        outMesh->StageIndexData(
+            narrow.data(), static_cast<u32>(narrow.size() * sizeof(u16)), sizeof(u16));
+    }
     outMesh->SetSubmeshes(std::move(submeshes));
     outMesh->SetMaterialSlotCount(scene->mNumMaterials > 0 ? scene->mNumMaterials : 1);
+    // Triangle order for the vertex cache and overdraw, then vertex fetch order.
+    const MeshOptimizeResult optimized = MeshOptimizer::Optimize(*outMesh);
+    // Simplified levels are appended to the staged indices (LOD 0 unchanged).
+    MeshSimplifier::GenerateLods(*outMesh);
+    outMesh->ComputeBounds();
 
     SP_CORE_INFO_TAG(
-        "Assimp", "Imported '{}': {} vertices, {} indices, {} submeshes",
-        metadata.FilePath.string(), vertices.size(), indices.size(),
-        outMesh->Submeshes().size());
+        "Assimp",
+        "Imported '{}': {} vertices ({} bytes each), {} indices, {} submeshes, {} LODs; "
+        "ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+        metadata.FilePath.string(), outMesh->VertexCount(), outMesh->Layout()->getStride(),
+        indices.size(), outMesh->Submeshes().size(), outMesh->LodCount(),
+        optimized.Before.Acmr(), optimized.After.Acmr(), optimized.Before.Atvr(),
+        optimized.After.Atvr());
     return outMesh;
 }
 
@@ -491,7 +812,7 @@ bool MeshSerializer::Serialize(
     // Submeshes default to a single full-range submesh if none were assigned.
     std::vector<Mesh::Submesh> submeshes = mesh->Submeshes();
     if (submeshes.empty())
-        submeshes.push_back({0, 0, mesh->IndexCount(), 0});
+        submeshes.push_back({0, 0, mesh->LevelRange(0).IndexCount, 0, mesh->Bounds()});
 
     std::vector<MeshSubmeshEntry> submeshEntries;
     submeshEntries.reserve(submeshes.size());
@@ -504,6 +825,30 @@ bool MeshSerializer::Serialize(
         submeshEntries.push_back(e);
     }
 
+    // Bounds table (v3): whole mesh, then each submesh in table order.
+    std::vector<MeshBoundsEntry> boundsEntries;
+    boundsEntries.reserve(1 + submeshes.size());
+    boundsEntries.push_back(EncodeBounds(mesh->Bounds()));
+    for (const Mesh::Submesh& s : submeshes)
+        boundsEntries.push_back(EncodeBounds(s.Bounds));
+
+    // LOD tables (v4): level entries, then each level's per-submesh ranges.
+    std::vector<MeshLodEntry> lodEntries;
+    std::vector<MeshLodRangeEntry> lodRangeEntries;
+    for (const Mesh::Lod& lod : mesh->Lods()) {
+        if (lod.Submeshes.size() != submeshes.size()) {
+            SP_CORE_WARN_TAG(
+                "Mesh", "Mesh '{}' LOD ranges do not match its submeshes; saving LOD 0 only",
+                mesh->Name());
+            lodEntries.clear();
+            lodRangeEntries.clear();
+            break;
+        }
+        lodEntries.push_back({lod.Error, lod.Range.BaseIndex, lod.Range.IndexCount, 0});
+        for (const Mesh::IndexRange& range : lod.Submeshes)
+            lodRangeEntries.push_back({range.BaseIndex, range.IndexCount});
+    }
+
     MeshFileHeader header{};
     std::memcpy(header.Magic, c_MeshMagic, sizeof(c_MeshMagic));
     header.Version = c_MeshVersion;
@@ -515,6 +860,7 @@ bool MeshSerializer::Serialize(
     header.SubmeshCount = static_cast<u32>(submeshEntries.size());
     const u32 slotCount = mesh->MaterialSlotCount() == 0 ? 1 : mesh->MaterialSlotCount();
     header.MaterialSlotCount = slotCount;
+    header.LodCount = 1 + static_cast<u32>(lodEntries.size());
 
     // Per-slot default material handles (v2). Missing entries serialize as null.
     std::vector<u64> slotDefaults(slotCount, c_NullAssetHandle);
@@ -525,8 +871,17 @@ bool MeshSerializer::Serialize(
     const u64 attrBytes = attrs.size() * sizeof(MeshAttributeEntry);
     const u64 submeshBytes = submeshEntries.size() * sizeof(MeshSubmeshEntry);
     const u64 slotBytes = slotDefaults.size() * sizeof(u64);
+    const u64 boundsBytes = boundsEntries.size() * sizeof(MeshBoundsEntry);
+    const u64 lodBytes = lodEntries.size() * sizeof(MeshLodEntry) +
+        lodRangeEntries.size() * sizeof(MeshLodRangeEntry);
+    MeshVertexDecodeEntry decode{};
+    for (int i = 0; i < 3; ++i) {
+        decode.PositionScale[i] = mesh->PositionScale()[i];
+        decode.PositionOffset[i] = mesh->PositionOffset()[i];
+    }
+
     const u64 total = sizeof(header) + attrBytes + submeshBytes + slotBytes +
-        vertexData.size() + indexData.size();
+        boundsBytes + lodBytes + sizeof(decode) + vertexData.size() + indexData.size();
 
     out.Allocate(total);
     if (!out)
@@ -541,6 +896,17 @@ bool MeshSerializer::Serialize(
     cursor += submeshBytes;
     std::memcpy(cursor, slotDefaults.data(), slotBytes);
     cursor += slotBytes;
+    std::memcpy(cursor, boundsEntries.data(), boundsBytes);
+    cursor += boundsBytes;
+    if (!lodEntries.empty()) {
+        std::memcpy(cursor, lodEntries.data(), lodEntries.size() * sizeof(MeshLodEntry));
+        cursor += lodEntries.size() * sizeof(MeshLodEntry);
+        std::memcpy(cursor, lodRangeEntries.data(),
+                    lodRangeEntries.size() * sizeof(MeshLodRangeEntry));
+        cursor += lodRangeEntries.size() * sizeof(MeshLodRangeEntry);
+    }
+    std::memcpy(cursor, &decode, sizeof(decode));
+    cursor += sizeof(decode);
     std::memcpy(cursor, vertexData.data(), vertexData.size());
     cursor += vertexData.size();
     std::memcpy(cursor, indexData.data(), indexData.size());
@@ -1,10 +1,14 @@
 //
 // Serializer for Mesh. Handles two byte formats behind one AssetType::Mesh:
 //
-//   * .smesh — the engine's native binary mesh (magic 'SMSH'): a self-describing
-//     header (vertex layout + submesh table + material-slot count) followed by
-//     the raw vertex and index blobs. This is what Serialize writes and what the
-//     editor/runtime load for meshes authored in-engine. Lossless.
+//   * .smesh — the engine's native binary mesh (magic 'SMSH', version 6): a
+//     header (counts, index size, LOD count) followed by self-describing
+//     sections — attribute directory, submesh table, per-slot default materials
+//     (v2), object-space bounds (v3), the LOD chain (v4), the quantized
+//     position decode (v5) — then the raw vertex and index blobs. v6 keeps the
+//     layout with submesh indices relative to BaseVertex. This is what
+//     Serialize writes and what the editor/runtime load for meshes authored
+//     in-engine. Lossless; older versions still load (see MeshSerializer.cpp).
 //   * import formats (.obj/.gltf/.glb/.fbx) — parsed via Assimp into the same
 //     in-memory Mesh (one submesh per source mesh). Import-only; never written.
 //
@@ -43,7 +43,7 @@ Application::Application(const ApplicationSpecification& specification)
     m_Window = Ref<Seraph::Window>::Create(m_Specification.Window);
     s_Instance = this;
 
-    Renderer::Init();
+    Renderer::Init(m_Specification.RenderThread);
     DebugRenderer::Init();
 
     // Register serializers (needs the renderer up). The asset manager itself is
@@ -26,6 +26,9 @@ struct ApplicationSpecification
 {
     std::string Name = "Seraph";
     WindowProperties Window{1280, 720, "Seraph", false};
+    // Run bgfx on its own render thread (see Renderer::Init). The game loop and
+    // SDL window/events stay on the main thread.
+    bool RenderThread = false;
 };
 
 class Application
@@ -72,7 +72,14 @@ AssetInfo BuildAssetInfo(AssetHandle handle)
         Ref<Mesh> mesh = asset.As<Mesh>();
         info.Fields.emplace_back("Vertices", std::to_string(mesh->VertexCount()));
         info.Fields.emplace_back("Indices", std::to_string(mesh->IndexCount()));
-        info.Fields.emplace_back("Triangles", std::to_string(mesh->IndexCount() / 3));
+        info.Fields.emplace_back(
+            "Triangles", std::to_string(mesh->LevelRange(0).IndexCount / 3));
+        if (mesh->LodCount() > 1) {
+            std::string lods;
+            for (u32 lod = 1; lod < mesh->LodCount(); ++lod)
+                lods += (lod > 1 ? ", " : "") + std::to_string(mesh->LevelRange(lod).IndexCount / 3);
+            info.Fields.emplace_back("LOD triangles", lods);
+        }
         info.Fields.emplace_back("Submeshes", std::to_string(mesh->Submeshes().size()));
         info.Fields.emplace_back("Material slots", std::to_string(mesh->MaterialSlotCount()));
     }
@@ -11,12 +11,11 @@
 #include "Seraph/Asset/EditorAssetManager.h"
 #include "Seraph/Asset/Pack/AssetPackBuilder.h"
 #include "Seraph/Editor/AssetFactory.h"
+#include "Seraph/Graphics/DynamicResolution.h"
 #include "Seraph/Graphics/Material/Material.h"
 #include "Seraph/Graphics/Material/MaterialInstance.h"
-#include "Seraph/Graphics/RenderPass.h"
 #include "Seraph/Graphics/RenderSystem.h"
 #include "Seraph/Graphics/Renderer.h"
-#include "Seraph/Graphics/ViewId.h"
 #include "Seraph/Scene/SceneAsset.h"
 #include "Seraph/Core/Application.h"
 #include "Seraph/Core/Buffer.h"
@@ -42,10 +41,10 @@
 #include <yaml-cpp/yaml.h>
 
 #include <cctype>
+#include <cmath>
 #include <cstdio>
 #include <exception>
 #include <filesystem>
-#include <optional>
 
 namespace Seraph
 {
@@ -67,19 +66,11 @@ void EditorLayer::SetScene(Ref<Scene> scene)
 void EditorLayer::OnAttach()
 {
     auto [w, h] = Application::Instance().Window().Size();
-    m_RenderTarget.Create(w, h, HDRColorFormat()); // HDR scene target (RGBA16F)
-    m_ViewportTarget.Create(w, h);                 // LDR tonemap output shown in the viewport
-    m_Picker.Create(w, h);
+    m_ViewportTarget.Create(w, h); // LDR tonemap output shown in the viewport
 
     m_EditorCamera.SetViewportBounds(0, 0, w, h);
-    m_EditorCamera.SetViewId(ViewId::Scene);
     m_EditorCamera.SetActive(true);
 
-    glm::vec3 clearColor = m_SceneRenderer->GetSettings().ClearColor;
-    u32 rgba = EncodeColorRgba8(clearColor.r, clearColor.g, clearColor.b, 1.0f);
-    bgfx::setViewClear(ViewId::Scene,
-        BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH, rgba, 0.0f, 0);
-
     PointPanelsAt(m_EditorScene, UUID(0));
 
     LoadRecents();
@@ -89,10 +80,8 @@ void EditorLayer::OnDetach()
 {
     if (m_ScriptCompileThread.joinable())
         m_ScriptCompileThread.join();
-    m_RenderTarget.Destroy();
     m_ViewportTarget.Destroy();
-    m_RuntimeTarget.Destroy();
-    m_Picker.Destroy();
+    m_RenderGraph.Destroy();
 }
 
 void EditorLayer::OnUpdate(f64 dt)
@@ -123,61 +112,55 @@ void EditorLayer::OnUpdate(f64 dt)
     {
         auto [w, h] = Application::Instance().Window().Size();
 
-        // Play-in-editor renders fullscreen through the HDR pipeline: scene -> HDR
-        // target (view 1), then a tonemap resolve -> backbuffer (view 4).
-        if (!m_RuntimeTarget.IsValid())
-            m_RuntimeTarget.Create(w, h, HDRColorFormat());
-        else if (m_RuntimeTarget.width != w || m_RuntimeTarget.height != h)
-            m_RuntimeTarget.Resize(w, h);
-
-        RenderPass::ToTarget(ViewId::Scene, m_RuntimeTarget.fb,
-            static_cast<u16>(w), static_cast<u16>(h)).Bind();
-
         Ref<Scene> scene = ActiveScene();
         scene->SetViewportBounds(0, 0, w, h);
         scene->OnUpdateRuntime(dt);
-        scene->OnRenderRuntime(m_SceneRenderer);
 
-        RenderPass::ToBackbuffer(ViewId::Tonemap,
-            static_cast<u16>(w), static_cast<u16>(h)).Bind();
-        const ProjectGraphicsSettings& gs = RenderSystem::GetSettings();
-        Renderer::TonemapResolve(ViewId::Tonemap, m_RuntimeTarget.color,
-            gs.Exposure, static_cast<int>(gs.Tonemap));
+        // Play-in-editor renders fullscreen through the HDR pipeline: scene -> a
+        // transient HDR target (its dynamic-resolution region), then the tonemap
+        // (+ FXAA) resolve -> backbuffer. The scene's own camera drives it (not
+        // the editor camera), on the graph's view.
+        const f32 scale = m_DynamicResolution.Update(dt);
+        const RenderGraphResource hdr =
+            m_RenderGraph.CreateTarget("SceneHDR", RenderSystem::SceneColorDesc(w, h));
+        const RenderGraphResource backbuffer =
+            m_RenderGraph.ImportBackbuffer(static_cast<u16>(w), static_cast<u16>(h));
+        m_RenderGraph.AddPass("Scene", [&](const RenderGraphPassContext& pass) {
+                if (Entity camera = scene->GetMainCameraEntity())
+                    camera.GetComponent<CameraComponent>().Camera.SetViewId(pass.ViewId);
+                m_SceneRenderer->SetTargetHeight(pass.Height);
+                scene->OnRenderRuntime(m_SceneRenderer);
+                DynamicResolution::SetViewRect(pass, scale);
+            })
+            .Write(hdr);
+        RenderSystem::AddResolvePasses(m_RenderGraph, hdr, backbuffer, scale);
+        m_RenderGraph.Execute();
     }
     else
     {
-        if (m_RenderTarget.IsValid())
-            RenderPass::ToTarget(ViewId::Scene, m_RenderTarget.fb,
-                static_cast<u16>(m_RenderTarget.width),
-                static_cast<u16>(m_RenderTarget.height)).Bind();
-
         m_EditorCamera.SetViewportHovered(m_ViewportPanel.IsHovered());
         m_EditorCamera.OnUpdate(dt);
         m_EditorScene->OnUpdateEditor(dt);
-        m_EditorScene->OnRenderEditor(m_SceneRenderer, m_EditorCamera);
 
-        // Resolve the HDR scene target to the LDR viewport texture the panel shows.
-        if (m_RenderTarget.IsValid() && m_ViewportTarget.IsValid())
+        // Scene -> a transient HDR target, resolved to the LDR viewport texture the
+        // panel shows (imported: ImGui samples it after the graph has run).
+        if (m_ViewportTarget.IsValid())
         {
-            RenderPass::ToTarget(ViewId::Tonemap, m_ViewportTarget.fb,
-                static_cast<u16>(m_ViewportTarget.width),
-                static_cast<u16>(m_ViewportTarget.height)).Bind();
-            const ProjectGraphicsSettings& gs = RenderSystem::GetSettings();
-            Renderer::TonemapResolve(ViewId::Tonemap, m_RenderTarget.color,
-                gs.Exposure, static_cast<int>(gs.Tonemap));
+            const f32 scale = m_DynamicResolution.Update(dt);
+            const RenderGraphResource hdr = m_RenderGraph.CreateTarget("SceneHDR",
+                RenderSystem::SceneColorDesc(m_ViewportTarget.width, m_ViewportTarget.height));
+            const RenderGraphResource viewport =
+                m_RenderGraph.ImportTarget("Viewport", m_ViewportTarget);
+            m_RenderGraph.AddPass("Scene", [&](const RenderGraphPassContext& pass) {
+                    m_EditorCamera.SetViewId(pass.ViewId);
+                    m_SceneRenderer->SetTargetHeight(pass.Height);
+                    m_EditorScene->OnRenderEditor(m_SceneRenderer, m_EditorCamera);
+                    DynamicResolution::SetViewRect(pass, scale);
+                })
+                .Write(hdr);
+            RenderSystem::AddResolvePasses(m_RenderGraph, hdr, viewport, scale);
+            m_RenderGraph.Execute();
         }
-
-        // Entity picking: consume a completed readback (from a click a couple of
-        // frames ago), then render/kick off any pending pick into its own views
-        // (2-3) as part of this same frame.
-        if (std::optional<UUID> picked = m_Picker.Poll())
-        {
-            Entity entity = (*picked == UUID(0))
-                ? Entity{}
-                : m_EditorScene->TryGetEntityWithUUID(*picked);
-            m_EntityBrowser.SetSelectedEntity(entity);
-        }
-        m_Picker.RenderPickPass(*m_EditorScene, m_EditorCamera);
     }
 }
 
@@ -686,31 +669,14 @@ void EditorLayer::OnImGuiRender()
         if (m_ViewportPanel.ConsumeDroppedAsset(droppedAsset))
             InstantiateAsset(droppedAsset);
 
-        // Left-click in the viewport selects the entity under the cursor via a
-        // color-ID pick — unless the click lands on the gizmo (which owns it) or
-        // is mid-drag. The pick renders + reads back over the next few frames.
-        if (m_ViewportPanel.IsHovered() &&
-            ImGui::IsMouseClicked(ImGuiMouseButton_Left) &&
-            !m_Gizmo.IsUsing() && !m_Gizmo.IsOver())
-        {
-            const ImVec2 mouse  = ImGui::GetMousePos();
-            const ImVec2 origin = m_ViewportPanel.GetContentPos();
-            const float  localX = mouse.x - origin.x;
-            const float  localY = mouse.y - origin.y;
-            if (localX >= 0.0f && localY >= 0.0f)
-                m_Picker.RequestPick(
-                    static_cast<u32>(localX), static_cast<u32>(localY));
-        }
+        UpdateViewportSelection();
 
         const ImVec2 sz = m_ViewportPanel.GetContentSize();
         if (sz.x > 0.0f && sz.y > 0.0f &&
-            (static_cast<u32>(sz.x) != m_RenderTarget.width || static_cast<u32>(sz.y) != m_RenderTarget.height))
+            (static_cast<u32>(sz.x) != m_ViewportTarget.width || static_cast<u32>(sz.y) != m_ViewportTarget.height))
         {
-            m_RenderTarget.Resize(
-                static_cast<u32>(sz.x), static_cast<u32>(sz.y));
             m_ViewportTarget.Resize(
                 static_cast<u32>(sz.x), static_cast<u32>(sz.y));
-            m_Picker.Resize(static_cast<u32>(sz.x), static_cast<u32>(sz.y));
             m_EditorCamera.SetViewportBounds(0, 0, static_cast<u32>(sz.x), static_cast<u32>(sz.y));
             m_EditorScene->SetViewportBounds(0, 0, static_cast<u32>(sz.x), static_cast<u32>(sz.y));
         }
@@ -731,6 +697,7 @@ void EditorLayer::EnterRuntime()
 {
     m_RuntimeMode = true;
     m_EditorCamera.SetActive(false);
+    m_SelectionPressed = false;
     Input::SetCursorMode(CursorMode::Normal);
 
     const UUID selection = SelectedUUID();
@@ -742,15 +709,11 @@ void EditorLayer::EnterRuntime()
     auto [w, h] = Application::Instance().Window().Size();
     m_RuntimeScene->SetViewportBounds(0, 0, w, h);
 
-    // The scene's own camera drives play-in-editor (not the editor camera). A
-    // data-copied camera keeps its default view id (0), so point it at the scene
-    // view or it renders to view 0 instead of the HDR target — matching
-    // RuntimeLayer::OnAttach.
-    if (Entity camera = m_RuntimeScene->GetMainCameraEntity())
-        camera.GetComponent<CameraComponent>().Camera.SetViewId(ViewId::Scene);
-
     m_RuntimeScene->OnRuntimeStart();
 
+    // Fullscreen play costs differently from the viewport: measure afresh.
+    m_DynamicResolution.Reset();
+
     PointPanelsAt(m_RuntimeScene, selection);
 }
 
@@ -765,6 +728,7 @@ void EditorLayer::ExitRuntime()
     m_RuntimeMode = false;
     m_EditorCamera.SetActive(true);
     Input::SetCursorMode(CursorMode::Normal);
+    m_DynamicResolution.Reset();
 
     PointPanelsAt(m_EditorScene, selection);
 }
@@ -775,6 +739,65 @@ UUID EditorLayer::SelectedUUID() const
     return selected ? selected.GetUUID() : UUID(0);
 }
 
+void EditorLayer::UpdateViewportSelection()
+{
+    // Drags shorter than this (pixels, either axis) still count as a click.
+    constexpr float c_MarqueeThreshold = 4.0f;
+
+    const ImGuiIO& io = ImGui::GetIO();
+    // Not over the gizmo (which owns the press) and not Alt (camera orbit).
+    if (m_ViewportPanel.IsHovered() && ImGui::IsMouseClicked(ImGuiMouseButton_Left) &&
+        !m_Gizmo.IsUsing() && !m_Gizmo.IsOver() && !io.KeyAlt)
+    {
+        m_SelectionPressed = true;
+        m_SelectionStart = io.MousePos;
+    }
+    if (!m_SelectionPressed)
+        return;
+
+    const ImVec2 origin = m_ViewportPanel.GetContentPos();
+    const ImVec2 size   = m_ViewportPanel.GetContentSize();
+    const ImVec2 mouse  = io.MousePos;
+    const bool dragged = std::abs(mouse.x - m_SelectionStart.x) >= c_MarqueeThreshold ||
+                         std::abs(mouse.y - m_SelectionStart.y) >= c_MarqueeThreshold;
+
+    if (ImGui::IsMouseDown(ImGuiMouseButton_Left))
+    {
+        if (dragged)
+        {
+            ImDrawList* draw = ImGui::GetForegroundDrawList();
+            draw->PushClipRect(origin, ImVec2(origin.x + size.x, origin.y + size.y));
+            draw->AddRectFilled(m_SelectionStart, mouse, IM_COL32(90, 150, 255, 40));
+            draw->AddRect(m_SelectionStart, mouse, IM_COL32(90, 150, 255, 200));
+            draw->PopClipRect();
+        }
+        return;
+    }
+
+    // Released: resolve the pick right away, against this frame's scene.
+    m_SelectionPressed = false;
+    const glm::vec2 viewportSize(size.x, size.y);
+    const glm::vec2 start(m_SelectionStart.x - origin.x, m_SelectionStart.y - origin.y);
+    const glm::vec2 end(mouse.x - origin.x, mouse.y - origin.y);
+
+    std::vector<Entity> selection;
+    if (io.KeyShift)
+        selection = m_EntityBrowser.GetSelection();
+
+    if (dragged)
+    {
+        m_Picker.PickRect(*m_EditorScene, m_EditorCamera, viewportSize,
+                          glm::clamp(start, glm::vec2(0.0f), viewportSize),
+                          glm::clamp(end, glm::vec2(0.0f), viewportSize), m_PickedEntities);
+        selection.insert(selection.end(), m_PickedEntities.begin(), m_PickedEntities.end());
+    }
+    else if (Entity picked = m_Picker.Pick(*m_EditorScene, m_EditorCamera, viewportSize, start))
+    {
+        selection.push_back(picked);
+    }
+    m_EntityBrowser.SetSelection(selection);
+}
+
 void EditorLayer::InstantiateAsset(AssetHandle handle)
 {
     if (m_RuntimeMode || static_cast<u64>(handle) == c_NullAssetHandle)
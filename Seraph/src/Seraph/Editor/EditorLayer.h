@@ -24,6 +24,8 @@
 #include "Seraph/Editor/Panels/MaterialEditorPanel.h"
 #include "Seraph/Editor/Panels/SettingsPanel.h"
 #include "Seraph/Editor/Panels/ViewportPanel.h"
+#include "Seraph/Graphics/DynamicResolution.h"
+#include "Seraph/Graphics/RenderGraph.h"
 #include "Seraph/Graphics/RenderTarget.h"
 #include "Seraph/Graphics/SceneRenderer.h"
 #include "Seraph/Scene/Scene.h"
@@ -70,6 +72,10 @@ private:
     // Spawn an entity for an asset dropped into the viewport (mesh -> entity
     // with a MeshComponent). No-op for unsupported types or during play.
     void InstantiateAsset(AssetHandle handle);
+    // Viewport click / drag selection (edit mode): a click picks the entity
+    // under the cursor, a drag selects every entity inside the marquee. Shift
+    // adds to the current selection. Runs after the viewport panel is drawn.
+    void UpdateViewportSelection();
     // Minimal Play/Stop toolbar, drawn in both modes (the menu bar is hidden
     // during play). The button defers the actual swap via m_PendingRuntimeToggle.
     void UI_Toolbar();
@@ -125,10 +131,13 @@ private:
     SettingsPanel        m_SettingsPanel;
     ConsolePanel         m_ConsolePanel;
     EditorGizmo          m_Gizmo;
-    RenderTarget         m_RenderTarget;   // HDR scene target (edit mode, viewport-sized)
     RenderTarget         m_ViewportTarget; // LDR tonemap output shown in the viewport
-    RenderTarget         m_RuntimeTarget;  // HDR scene target for play-in-editor (window-sized)
+    RenderGraph          m_RenderGraph;    // scene + tonemap passes; pools the HDR target
+    DynamicResolution    m_DynamicResolution; // scene scale for m_RenderGraph's frames
     EntityPicker         m_Picker;
+    bool                 m_SelectionPressed = false; // left press began in the viewport
+    ImVec2               m_SelectionStart;           // press position (screen space)
+    std::vector<Entity>  m_PickedEntities;           // scratch for marquee picks
 
     bool                 m_RuntimeMode = false;
     bool                 m_PendingRuntimeToggle = false; // processed at top of OnUpdate
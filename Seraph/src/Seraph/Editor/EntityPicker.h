@@ -1,31 +1,33 @@
 //
-// Color-ID ("pick buffer") entity selection, after bgfx's 30-picking example.
+// Editor entity picking on the CPU, against the scene's spatial index.
 //
-// On request, the scene's meshes are re-rendered into an offscreen RGBA8 target
-// with each entity flat-shaded in a unique color ID, using the SAME camera
-// matrices as the visible viewport — so a pick texel corresponds 1:1 to what the
-// user sees, with no ray/projection math. The single texel under the cursor is
-// then blitted into a 1x1 CPU-readable texture and read back asynchronously
-// (bgfx completes the copy a couple of frames later). Decoding the color yields
-// the picked entity's UUID, or UUID(0) for empty space.
+// A click casts the ray under the cursor (from the editor camera's near plane)
+// through SceneSpatialIndex: the box hits come back nearest first and each
+// candidate's mesh is tested exactly, triangle by triangle, against its
+// retained CPU geometry (Mesh::RayCast) in object space. The walk stops once a
+// box starts farther than the best triangle hit, so only the meshes the ray
+// actually reaches are touched. The result is available immediately — no pick
+// render pass, no GPU readback, no frames of latency.
 //
-// Usage (editor mode, once per frame, before the frame is flushed):
-//   picker.Poll()   -> consume a completed readback (sets selection)
-//   picker.RenderPickPass(scene, camera)  -> render + kick off a pending request
-// and, on a viewport click:
-//   picker.RequestPick(localPixelX, localPixelY)
+// A marquee (drag rectangle) narrows the camera frustum to the rectangle and
+// queries the index with it: entities whose bounds lie wholly inside are taken
+// as they are, the rest are accepted when one of their triangles reaches into
+// the sub-frustum (Mesh::Intersects).
+//
+// Usage (editor mode, on a viewport click / marquee release):
+//   Entity picked = picker.Pick(scene, camera, viewportSize, localPixel);
+//   picker.PickRect(scene, camera, viewportSize, cornerA, cornerB, selection);
+// Pixels are viewport-local, top-left origin.
 //
 
 #pragma once
 
 #include "Seraph/Core/Base.h"
-#include "Seraph/Core/UUID.h"
-#include "Seraph/Graphics/RenderTarget.h"
-#include "Seraph/Graphics/ViewId.h"
+#include "Seraph/Physics/SceneQueries.h"
+#include "Seraph/Scene/Entity.h"
 
-#include <bgfx/bgfx.h>
+#include <glm/glm.hpp>
 
-#include <optional>
 #include <vector>
 
 namespace Seraph
@@ -36,52 +38,21 @@ class EditorCamera;
 class EntityPicker
 {
 public:
-    // The picker owns the color-ID render + blit views; ids are the canonical
-    // ones from Seraph/Graphics/ViewId.h (Pick = 2, PickBlit = 3).
-    static constexpr u16 k_PickViewId     = ViewId::Pick;
-    static constexpr u16 k_PickBlitViewId = ViewId::PickBlit;
-
     EntityPicker() = default;
 
-    // Create/destroy GPU resources (main thread). `w`,`h` should match the
-    // viewport render target so pick texels line up with the visible image.
-    void Create(u32 w, u32 h);
-    void Destroy();
-    void Resize(u32 w, u32 h);
-
-    [[nodiscard]] bool HasResources() const { return m_Target.IsValid(); }
-
-    // Queue a pick at viewport-local pixel (x,y), top-left origin. The render +
-    // readback happen over the next few frames; the latest request wins if one
-    // is still in flight.
-    void RequestPick(u32 x, u32 y);
+    // Nearest entity whose mesh triangles lie under viewport pixel `pixel`, or
+    // an empty Entity for empty space.
+    [[nodiscard]] Entity Pick(Scene& scene, const EditorCamera& camera,
+                              const glm::vec2& viewportSize, const glm::vec2& pixel);
 
-    // Render the color-ID pass for a pending request and kick off the readback.
-    // No-op unless a request is pending. Call once per frame during the editor
-    // scene render (before FlushFrame), passing the same camera as the visible
-    // view so the two rasterize identically.
-    void RenderPickPass(Scene& scene, const EditorCamera& camera);
-
-    // If a readback has completed, returns the picked entity's UUID (UUID(0) for
-    // empty space) and clears the in-flight state. Otherwise std::nullopt.
-    std::optional<UUID> Poll();
+    // Every entity with a mesh triangle inside the viewport rectangle spanned by
+    // corners `a` and `b` (any order). `out` is cleared first.
+    void PickRect(Scene& scene, const EditorCamera& camera, const glm::vec2& viewportSize,
+                  const glm::vec2& a, const glm::vec2& b, std::vector<Entity>& out);
 
 private:
-    enum class State { Idle, Pending, Reading };
-
-    RenderTarget        m_Target;                          // RGBA8 + depth
-    bgfx::TextureHandle m_Readback  = BGFX_INVALID_HANDLE;  // 1x1 READ_BACK|BLIT_DST
-    bgfx::UniformHandle m_IdUniform = BGFX_INVALID_HANDLE;  // vec4 u_id
-
-    State m_State      = State::Idle;
-    u32   m_PickX      = 0;
-    u32   m_PickY      = 0;
-    u32   m_ReadyFrame = 0;     // frame at which m_Pixel becomes valid
-    u8    m_Pixel[4]   = {};    // readback destination (RGBA8, one texel)
-
-    // Color ID (1-based) -> entity UUID for the in-flight request. Index 0 is
-    // the background sentinel (UUID(0) == no selection).
-    std::vector<UUID> m_IdToEntity;
+    std::vector<SceneQueryHit> m_Hits; // scratch: box hits along the pick ray
+    std::vector<Entity> m_Candidates;  // scratch: entities touching the marquee
 };
 
 } // namespace Seraph
@@ -10,6 +10,7 @@
 #include "Seraph/Scene/Components/TagComponent.h"
 
 #include <imgui.h>
+#include <algorithm>
 #include <cstring>
 #include <vector>
 
@@ -24,14 +25,36 @@ EntityBrowserPanel::EntityBrowserPanel(Ref<Scene> scene)
 void EntityBrowserPanel::SetScene(Ref<Scene> scene)
 {
     m_Scene = scene;
-    m_SelectedEntity = {};
+    SetSelectedEntity({});
     m_RenamingEntity = {};
-    m_EntityToDelete = {};
+    m_EntitiesToDelete.clear();
     m_EntityToReparent = {};
     m_NewParentEntity = {};
     m_UnparentRequested = false;
 }
 
+void EntityBrowserPanel::SetSelectedEntity(Entity entity)
+{
+    m_SelectedEntity = entity;
+    m_Selection.clear();
+    if (entity)
+        m_Selection.push_back(entity);
+}
+
+void EntityBrowserPanel::SetSelection(const std::vector<Entity>& entities)
+{
+    m_Selection.clear();
+    for (const Entity entity : entities)
+        if (entity && !IsSelected(entity))
+            m_Selection.push_back(entity);
+    m_SelectedEntity = m_Selection.empty() ? Entity{} : m_Selection.front();
+}
+
+bool EntityBrowserPanel::IsSelected(Entity entity) const
+{
+    return std::find(m_Selection.begin(), m_Selection.end(), entity) != m_Selection.end();
+}
+
 void EntityBrowserPanel::OnImGuiRender()
 {
     ImGui::Begin("Entity Browser");
@@ -45,12 +68,12 @@ void EntityBrowserPanel::OnImGuiRender()
 
     // Toolbar
     if (ImGui::Button("+ New Entity"))
-        m_SelectedEntity = m_Scene->CreateEntity("Entity");
+        SetSelectedEntity(m_Scene->CreateEntity("Entity"));
 
     ImGui::SameLine();
-    ImGui::BeginDisabled(!m_SelectedEntity);
+    ImGui::BeginDisabled(m_Selection.empty());
     if (ImGui::Button("Delete"))
-        m_EntityToDelete = m_SelectedEntity;
+        m_EntitiesToDelete = m_Selection;
     ImGui::EndDisabled();
 
     ImGui::Separator();
@@ -125,12 +148,15 @@ void EntityBrowserPanel::OnImGuiRender()
     // -------------------------------------------------------------------------
     // Apply deferred actions — safe to mutate the scene after tree drawing
     // -------------------------------------------------------------------------
-    if (m_EntityToDelete)
+    if (!m_EntitiesToDelete.empty())
     {
-        if (m_SelectedEntity == m_EntityToDelete)
-            m_SelectedEntity = {};
-        m_Scene->DestroyEntity(m_EntityToDelete);
-        m_EntityToDelete = {};
+        for (const Entity entity : m_EntitiesToDelete)
+        {
+            std::erase(m_Selection, entity);
+            m_Scene->DestroyEntity(entity);
+        }
+        m_EntitiesToDelete.clear();
+        SetSelection(std::vector<Entity>(m_Selection));
     }
 
     if (m_EntityToReparent)
@@ -164,7 +190,7 @@ void EntityBrowserPanel::DrawEntityNode(Entity entity)
     const std::string& displayName = tag ? tag->Tag : "(unnamed)";
     const u64 entityUUID = static_cast<u64>(entity.GetUUID());
     bool hasChildren = !entity.Children().empty();
-    bool isSelected = (m_SelectedEntity == entity);
+    bool isSelected = IsSelected(entity);
 
     ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow
                              | ImGuiTreeNodeFlags_SpanAvailWidth
@@ -179,7 +205,7 @@ void EntityBrowserPanel::DrawEntityNode(Entity entity)
 
     // Selection on left-click (ignore arrow toggle clicks)
     if (ImGui::IsItemClicked(ImGuiMouseButton_Left) && !ImGui::IsItemToggledOpen())
-        m_SelectedEntity = entity;
+        SetSelectedEntity(entity);
 
     DrawContextMenu(entity);
 
@@ -232,10 +258,10 @@ void EntityBrowserPanel::DrawContextMenu(Entity entity)
     if (!ImGui::BeginPopupContextItem())
         return;
 
-    m_SelectedEntity = entity;
+    SetSelectedEntity(entity);
 
     if (ImGui::MenuItem("Add Child Entity"))
-        m_SelectedEntity = m_Scene->CreateChildEntity(entity, "Entity");
+        SetSelectedEntity(m_Scene->CreateChildEntity(entity, "Entity"));
 
     if (ImGui::MenuItem("Rename"))
     {
@@ -251,7 +277,7 @@ void EntityBrowserPanel::DrawContextMenu(Entity entity)
     ImGui::Separator();
 
     if (ImGui::MenuItem("Delete"))
-        m_EntityToDelete = entity;
+        m_EntitiesToDelete = {entity};
 
     ImGui::EndPopup();
 }
@@ -8,6 +8,8 @@
 #include "Seraph/Scene/Entity.h"
 #include "Seraph/Scene/Scene.h"
 
+#include <vector>
+
 namespace Seraph
 {
 
@@ -20,15 +22,22 @@ public:
     void SetScene(Ref<Scene> scene);
     void OnImGuiRender();
 
+    // The primary selection drives the inspector and gizmo. A multi-selection
+    // (viewport marquee) keeps every entity highlighted; its first is primary.
     Entity GetSelectedEntity() const { return m_SelectedEntity; }
-    void SetSelectedEntity(Entity entity) { m_SelectedEntity = entity; }
+    void SetSelectedEntity(Entity entity);
+    const std::vector<Entity>& GetSelection() const { return m_Selection; }
+    void SetSelection(const std::vector<Entity>& entities);
 
 private:
+    [[nodiscard]] bool IsSelected(Entity entity) const;
+
     void DrawEntityNode(Entity entity);
     void DrawContextMenu(Entity entity);
 
     Ref<Scene> m_Scene;
     Entity m_SelectedEntity;
+    std::vector<Entity> m_Selection; // includes m_SelectedEntity when set
 
     // Rename state
     Entity m_RenamingEntity;
@@ -36,7 +45,7 @@ private:
     bool m_StartedRename = false;
 
     // Deferred actions (applied after the tree is fully drawn)
-    Entity m_EntityToDelete;
+    std::vector<Entity> m_EntitiesToDelete;
     Entity m_EntityToReparent;
     Entity m_NewParentEntity;
     bool m_UnparentRequested = false;
@@ -299,6 +299,9 @@ void RegisterInspectorCustomizations()
             if (const Property* meshProp =
                     Reflection::Get<MeshComponent>().FindProperty("Mesh"))
                 changed |= PropertyDrawer::DrawProperty(mc, *meshProp);
+            if (const Property* occluderProp =
+                    Reflection::Get<MeshComponent>().FindProperty("Occluder"))
+                changed |= PropertyDrawer::DrawProperty(mc, *occluderProp);
 
             if (mc->Mesh) {
                 ImGui::TextUnformatted(
@@ -0,0 +1,137 @@
+//
+// Created by ruben on 2026/10/17.
+//
+
+#include "DynamicResolution.h"
+
+#include "RenderGraph.h"
+#include "RenderSystem.h"
+#include "Renderer.h"
+#include "Seraph/Console/ConsoleCommand.h"
+#include "Seraph/Core/Log.h"
+
+#include <bgfx/bgfx.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Seraph
+{
+
+namespace
+{
+// The controller that updated last, for r.resolution.
+const DynamicResolution* s_LastUpdated = nullptr;
+
+// Last frame's GPU time in milliseconds, or 0 when the backend has no timer.
+f64 GpuFrameTimeMs()
+{
+    const bgfx::Stats* stats = bgfx::getStats();
+    if (stats == nullptr || stats->gpuTimerFreq <= 0 || stats->gpuTimeEnd <= stats->gpuTimeBegin)
+        return 0.0;
+    return static_cast<f64>(stats->gpuTimeEnd - stats->gpuTimeBegin) * 1000.0 /
+           static_cast<f64>(stats->gpuTimerFreq);
+}
+} // namespace
+
+SP_CONSOLE_COMMAND("r.resolution", "Print the dynamic resolution scale and its frame time",
+    [](const ConsoleCommandArgs&)
+    {
+        if (s_LastUpdated == nullptr) {
+            SP_CONSOLE_LOG_INFO("No scene has rendered");
+            return;
+        }
+        const ProjectGraphicsSettings& gs = RenderSystem::GetSettings();
+        SP_CONSOLE_LOG_INFO("Scale {:.2f} ({}, range {:.2f}-{:.2f})", s_LastUpdated->GetScale(),
+                            !gs.DynamicResolutionEnabled ? "fixed"
+                            : s_LastUpdated->IsHeld()    ? "held: no GPU timer under VSync"
+                                                         : "dynamic",
+                            gs.MinResolutionScale, gs.MaxResolutionScale);
+        SP_CONSOLE_LOG_INFO("Frame time {:.2f} ms, target {:.2f} ms",
+                            s_LastUpdated->GetFrameTimeMs(), gs.TargetFrameTime);
+    });
+
+DynamicResolution::~DynamicResolution()
+{
+    if (s_LastUpdated == this)
+        s_LastUpdated = nullptr;
+}
+
+f32 DynamicResolution::Update(f64 frameTime)
+{
+    s_LastUpdated = this;
+
+    const ProjectGraphicsSettings& gs = RenderSystem::GetSettings();
+    const f32 lo = std::clamp(std::min(gs.MinResolutionScale, gs.MaxResolutionScale),
+                              c_MinScale, 1.0f);
+    const f32 hi = std::clamp(std::max(gs.MinResolutionScale, gs.MaxResolutionScale), lo, 1.0f);
+
+    const f64 gpuMs = GpuFrameTimeMs();
+    const f64 measuredMs = gpuMs > 0.0 ? gpuMs : frameTime * 1000.0;
+    m_SmoothedMs = m_SmoothedMs > 0.0
+                       ? m_SmoothedMs + (measuredMs - m_SmoothedMs) * c_Smoothing
+                       : measuredMs;
+    // The CPU delta under VSync is a whole number of refresh intervals: it
+    // can't show headroom, and any frame over budget reads as a full interval
+    // late, so it would only ever step down.
+    m_Held = gpuMs <= 0.0 && Renderer::IsVSync();
+
+    if (!gs.DynamicResolutionEnabled) {
+        m_Scale = hi;
+        m_Settle = 0;
+        return m_Scale;
+    }
+
+    m_Scale = std::clamp(m_Scale, lo, hi);
+    if (m_Held) {
+        m_Settle = 0;
+        return m_Scale;
+    }
+    if (m_Settle > 0) {
+        --m_Settle;
+        return m_Scale;
+    }
+
+    const f64 target = std::max(static_cast<f64>(gs.TargetFrameTime), 0.1);
+    if (!(m_SmoothedMs > 0.0))
+        return m_Scale;
+
+    // Cost follows the pixel count (scale squared).
+    f32 next = m_Scale;
+    if (m_SmoothedMs > target) {
+        const auto ideal = static_cast<f32>(m_Scale * std::sqrt(target / m_SmoothedMs));
+        next = std::max(ideal, m_Scale - c_StepDown);
+    } else if (m_SmoothedMs < target * c_Headroom) {
+        const auto ideal =
+            static_cast<f32>(m_Scale * std::sqrt(target * c_Headroom / m_SmoothedMs));
+        next = std::min(ideal, m_Scale + c_StepUp);
+    }
+    next = std::clamp(next, lo, hi);
+
+    if (std::abs(next - m_Scale) >= c_MinStep) {
+        m_Scale = next;
+        m_Settle = c_SettleFrames;
+    }
+    return m_Scale;
+}
+
+void DynamicResolution::Reset()
+{
+    m_Scale = 1.0f;
+    m_SmoothedMs = 0.0;
+    m_Settle = 0;
+    m_Held = false;
+}
+
+u32 DynamicResolution::ScaledSize(u32 size, f32 scale)
+{
+    return std::max(1u, static_cast<u32>(std::lround(static_cast<f32>(size) * scale)));
+}
+
+void DynamicResolution::SetViewRect(const RenderGraphPassContext& pass, f32 scale)
+{
+    bgfx::setViewRect(pass.ViewId, 0, 0, static_cast<u16>(ScaledSize(pass.Width, scale)),
+                      static_cast<u16>(ScaledSize(pass.Height, scale)));
+}
+
+} // namespace Seraph
@@ -0,0 +1,79 @@
+//
+// Dynamic resolution: picks, each frame, the fraction of the output the scene
+// renders at, so the frame holds engine.graphics.targetFrameTime on slower
+// hardware instead of dropping frames.
+//
+// The HDR scene target keeps the output's full size (so the render graph's pool
+// never churns through sizes); the scene pass renders into its scaled top-left
+// region (SetViewRect) and the resolve upscales that region to the output —
+// bilinearly in the tonemap pass, or through the upscaler installed with
+// RenderSystem::SetUpscaler.
+//
+// The controller is fed the GPU frame time bgfx measures, or the CPU frame delta
+// when the backend has no GPU timer. With VSync that delta is quantised to the
+// refresh interval and never drops below it, so without a GPU timer under VSync
+// the controller holds its scale instead of chasing it downwards. Shading cost
+// follows the pixel count, i.e. scale squared, so the scale that would hit the
+// target is scale * sqrt(target / measured). It steps towards that from a
+// smoothed measurement: down quickly when over budget, up in small steps only
+// with clear headroom, then holds for c_SettleFrames so the (latent) GPU timings
+// reflect the new scale before it acts again.
+//
+// Off, the scene renders at engine.graphics.maxResolutionScale.
+//
+
+#pragma once
+
+#include "Seraph/Core/Base.h"
+
+namespace Seraph
+{
+struct RenderGraphPassContext;
+
+class DynamicResolution
+{
+public:
+    static constexpr f32 c_MinScale = 0.25f;     // floor for the min/max settings
+    static constexpr f32 c_StepDown = 0.1f;      // largest drop per adjustment
+    static constexpr f32 c_StepUp = 0.05f;       // largest raise per adjustment
+    static constexpr f32 c_MinStep = 0.01f;      // smaller changes are ignored
+    static constexpr f64 c_Headroom = 0.9;       // raise only below this share of the target
+    static constexpr f64 c_Smoothing = 0.2;      // weight of the newest frame time
+    static constexpr u32 c_SettleFrames = 8;
+
+    DynamicResolution() = default;
+    ~DynamicResolution();
+
+    DynamicResolution(const DynamicResolution&) = delete;
+    DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+    // Pick this frame's scale from the last frame's timings. `frameTime` is the
+    // CPU frame delta in seconds.
+    f32 Update(f64 frameTime);
+
+    // Forget the measurements (e.g. after a stall such as a scene load) and
+    // return to the maximum scale.
+    void Reset();
+
+    [[nodiscard]] f32 GetScale() const { return m_Scale; }
+    [[nodiscard]] f64 GetFrameTimeMs() const { return m_SmoothedMs; } // smoothed input
+    // True when the last Update held the scale for lack of a usable frame time
+    // (no GPU timer under VSync).
+    [[nodiscard]] bool IsHeld() const { return m_Held; }
+
+    // Pixels `size` covers at `scale` (at least 1).
+    [[nodiscard]] static u32 ScaledSize(u32 size, f32 scale);
+
+    // Restrict the scene pass's view to the scaled top-left region of its
+    // target. Call after the scene is submitted: the camera sets the view rect
+    // while rendering, and the last rect set in a frame wins.
+    static void SetViewRect(const RenderGraphPassContext& pass, f32 scale);
+
+private:
+    f32 m_Scale = 1.0f;
+    f64 m_SmoothedMs = 0.0;
+    u32 m_Settle = 0;
+    bool m_Held = false;
+};
+
+} // namespace Seraph
@@ -0,0 +1,209 @@
+//
+// Created by ruben on 2026/10/17.
+//
+
+#include "LightGrid.h"
+
+#include "SceneRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Seraph
+{
+
+namespace
+{
+
+constexpr u64 kTextureFlags = BGFX_SAMPLER_POINT | BGFX_SAMPLER_UVW_CLAMP;
+
+void DestroyTexture(bgfx::TextureHandle& handle)
+{
+    if (bgfx::isValid(handle)) {
+        bgfx::destroy(handle);
+        handle = BGFX_INVALID_HANDLE;
+    }
+}
+
+} // namespace
+
+LightGrid::~LightGrid()
+{
+    DestroyTexture(m_LightData);
+    DestroyTexture(m_Grid);
+    DestroyTexture(m_Indices);
+}
+
+void LightGrid::EnsureTextures()
+{
+    if (!bgfx::isValid(m_LightData))
+        m_LightData = bgfx::createTexture2D(c_LightDataTexels, c_MaxLights, false, 1,
+            bgfx::TextureFormat::RGBA32F, kTextureFlags);
+    if (!bgfx::isValid(m_Grid))
+        m_Grid = bgfx::createTexture2D(c_ClusterTilesX * c_ClusterTilesY, c_ClusterSlices,
+            false, 1, bgfx::TextureFormat::RG32F, kTextureFlags);
+    if (!bgfx::isValid(m_Indices))
+        m_Indices = bgfx::createTexture2D(c_LightIndexWidth, c_MaxLightIndices / c_LightIndexWidth,
+            false, 1, bgfx::TextureFormat::R32F, kTextureFlags);
+}
+
+u32 LightGrid::SliceOf(float z) const
+{
+    const float slice = std::floor(std::log(std::max(z, m_Near)) * m_SliceScale - m_SliceBias);
+    return static_cast<u32>(std::clamp(slice, 0.0f, static_cast<float>(c_ClusterSlices - 1)));
+}
+
+void LightGrid::Build(const std::vector<SceneRendererLight>& lights, const glm::mat4& view,
+                      const glm::mat4& proj, float nearClip, float farClip)
+{
+    EnsureTextures();
+    m_Stats = {};
+
+    // slice(z) = floor(log(z / near) * slices / log(far / near)), written as
+    // log(z) * scale - bias so the shader does one log + one mad.
+    m_Near = std::max(nearClip, 1e-3f);
+    const float farZ = std::max(farClip, m_Near * 1.01f);
+    m_SliceScale = static_cast<float>(c_ClusterSlices) / std::log(farZ / m_Near);
+    m_SliceBias = std::log(m_Near) * m_SliceScale;
+    const auto sliceStart = [this](u32 slice) {
+        return std::exp((static_cast<float>(slice) + m_SliceBias) / m_SliceScale);
+    };
+
+    m_LightTexels.clear();
+    const auto pushLight = [this](const SceneRendererLight& light) {
+        m_LightTexels.emplace_back(light.Position, light.Range);
+        m_LightTexels.emplace_back(light.Color, light.Intensity);
+        m_LightTexels.emplace_back(light.Direction, static_cast<float>(light.Type));
+        m_LightTexels.emplace_back(light.SpotScale, light.SpotOffset, 0.0f, 0.0f);
+    };
+
+    // Directional lights first: rows [0, DirectionalLights).
+    for (const SceneRendererLight& light : lights) {
+        if (light.Type == 0 && m_Stats.DirectionalLights < c_MaxDirectionalLights) {
+            pushLight(light);
+            ++m_Stats.DirectionalLights;
+        }
+    }
+
+    // Local lights: cull against the view depth range, then record the tile
+    // rectangle the light covers in each slice it spans.
+    m_Footprints.clear();
+    for (const SceneRendererLight& light : lights) {
+        if (light.Type == 0)
+            continue;
+        const auto row = static_cast<u32>(m_LightTexels.size() / c_LightDataTexels);
+        if (row >= c_MaxLights)
+            break;
+
+        const glm::vec3 center = glm::vec3(view * glm::vec4(light.Position, 1.0f));
+        const float depth = -center.z;
+        // Range 0 is unbounded (the shader applies no range window).
+        const bool bounded = light.Range > 0.0f;
+        const float z0 = bounded ? std::max(depth - light.Range, m_Near) : m_Near;
+        const float z1 = bounded ? std::min(depth + light.Range, farZ) : farZ;
+        if (z0 > z1)
+            continue;
+
+        pushLight(light);
+        ++m_Stats.LocalLights;
+
+        for (u32 slice = SliceOf(z0), last = SliceOf(z1); slice <= last; ++slice) {
+            Footprint footprint{row, slice, 0, c_ClusterTilesX - 1, 0, c_ClusterTilesY - 1};
+            if (bounded) {
+                // The sphere's widest cross-section inside the slice bounds its
+                // extent there; project that box's corners to tiles.
+                const float d0 = std::max(sliceStart(slice), z0);
+                const float d1 = std::min(sliceStart(slice + 1), z1);
+                const float nearest = std::clamp(depth, d0, d1) - depth;
+                const float radius = std::sqrt(
+                    std::max(light.Range * light.Range - nearest * nearest, 0.0f));
+
+                glm::vec2 ndcMin(1.0f);
+                glm::vec2 ndcMax(-1.0f);
+                for (int corner = 0; corner < 8; ++corner) {
+                    const glm::vec4 p(center.x + ((corner & 1) ? radius : -radius),
+                                      center.y + ((corner & 2) ? radius : -radius),
+                                      (corner & 4) ? -d1 : -d0, 1.0f);
+                    const glm::vec4 clip = proj * p;
+                    const glm::vec2 ndc = glm::vec2(clip) / std::max(clip.w, 1e-6f);
+                    ndcMin = glm::min(ndcMin, ndc);
+                    ndcMax = glm::max(ndcMax, ndc);
+                }
+                if (ndcMax.x < -1.0f || ndcMax.y < -1.0f || ndcMin.x > 1.0f || ndcMin.y > 1.0f)
+                    continue;
+
+                const auto tile = [](float ndc, u32 tiles) {
+                    const float t = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(tiles));
+                    return static_cast<u32>(std::clamp(t, 0.0f, static_cast<float>(tiles - 1)));
+                };
+                footprint.X0 = tile(ndcMin.x, c_ClusterTilesX);
+                footprint.X1 = tile(ndcMax.x, c_ClusterTilesX);
+                footprint.Y0 = tile(ndcMin.y, c_ClusterTilesY);
+                footprint.Y1 = tile(ndcMax.y, c_ClusterTilesY);
+            }
+            m_Footprints.push_back(footprint);
+        }
+    }
+
+    // Count per cluster, clamp, prefix-sum into (first, count), then fill. The
+    // footprints are in light order, so every cluster's list is too.
+    const auto clusterIndex = [](u32 slice, u32 x, u32 y) {
+        return (slice * c_ClusterTilesY + y) * c_ClusterTilesX + x;
+    };
+    m_ClusterCounts.assign(c_ClusterCount, 0);
+    for (const Footprint& fp : m_Footprints)
+        for (u32 y = fp.Y0; y <= fp.Y1; ++y)
+            for (u32 x = fp.X0; x <= fp.X1; ++x)
+                ++m_ClusterCounts[clusterIndex(fp.Slice, x, y)];
+
+    m_GridTexels.assign(c_ClusterCount * 2, 0.0f);
+    m_ClusterCursor.resize(c_ClusterCount);
+    u32 total = 0;
+    for (u32 c = 0; c < c_ClusterCount; ++c) {
+        const u32 wanted = m_ClusterCounts[c];
+        const u32 kept = std::min({wanted, c_MaxClusterLights, c_MaxLightIndices - total});
+        m_Stats.DroppedEntries += wanted - kept;
+        m_GridTexels[c * 2 + 0] = static_cast<float>(total);
+        m_GridTexels[c * 2 + 1] = static_cast<float>(kept);
+        m_ClusterCounts[c] = kept;
+        m_ClusterCursor[c] = total;
+        total += kept;
+    }
+    m_Stats.IndexEntries = total;
+
+    const u32 indexRows = (total + c_LightIndexWidth - 1) / c_LightIndexWidth;
+    m_IndexTexels.assign(indexRows * c_LightIndexWidth, 0.0f);
+    for (const Footprint& fp : m_Footprints) {
+        for (u32 y = fp.Y0; y <= fp.Y1; ++y) {
+            for (u32 x = fp.X0; x <= fp.X1; ++x) {
+                const u32 c = clusterIndex(fp.Slice, x, y);
+                if (m_ClusterCounts[c] == 0)
+                    continue;
+                --m_ClusterCounts[c];
+                m_IndexTexels[m_ClusterCursor[c]++] = static_cast<float>(fp.Light);
+            }
+        }
+    }
+
+    // Upload only the rows in use; the shader never reads past them.
+    const auto lightRows = static_cast<u16>(m_LightTexels.size() / c_LightDataTexels);
+    if (lightRows > 0)
+        bgfx::updateTexture2D(m_LightData, 0, 0, 0, 0, c_LightDataTexels, lightRows,
+            bgfx::copy(m_LightTexels.data(),
+                static_cast<u32>(m_LightTexels.size() * sizeof(glm::vec4))));
+    bgfx::updateTexture2D(m_Grid, 0, 0, 0, 0, c_ClusterTilesX * c_ClusterTilesY, c_ClusterSlices,
+        bgfx::copy(m_GridTexels.data(), static_cast<u32>(m_GridTexels.size() * sizeof(float))));
+    if (indexRows > 0)
+        bgfx::updateTexture2D(m_Indices, 0, 0, 0, 0, c_LightIndexWidth,
+            static_cast<u16>(indexRows),
+            bgfx::copy(m_IndexTexels.data(),
+                static_cast<u32>(m_IndexTexels.size() * sizeof(float))));
+
+    m_Binding.lightData = m_LightData;
+    m_Binding.grid = m_Grid;
+    m_Binding.indices = m_Indices;
+    m_Binding.sliceScale = m_SliceScale;
+    m_Binding.sliceBias = m_SliceBias;
+}
+
+} // namespace Seraph
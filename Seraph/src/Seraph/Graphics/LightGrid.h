@@ -0,0 +1,115 @@
+//
+// Clustered forward (Forward+) light list. Once per frame the scene's staged
+// lights are binned on the CPU into view-space froxels: c_ClusterTilesX x
+// c_ClusterTilesY screen tiles by c_ClusterSlices depth slices, spaced
+// exponentially between the camera's near and far planes. A point/spot light is
+// added to every froxel its range sphere overlaps; directional lights reach
+// every fragment and are kept out of the grid. The result goes to the PBR shader
+// (shader/lights.sh mirrors the constants below) as three point-sampled
+// textures, so each fragment loops over its own cluster's lights only:
+//
+//   light data    RGBA32F, c_LightDataTexels x c_MaxLights: row i is light i
+//                 (posRange, colorIntensity, dirType, spot — the old uniform
+//                 packing). Directional lights take the first rows.
+//   light grid    RG32F, (tilesX * tilesY) x slices: per cluster the first
+//                 entry in the index list and the entry count.
+//   light index   R32F, c_LightIndexWidth wide: the concatenated per-cluster
+//                 lists of light data rows.
+//
+
+#pragma once
+
+#include "Renderer.h"
+#include "Seraph/Core/Base.h"
+
+#include <bgfx/bgfx.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Seraph
+{
+struct SceneRendererLight;
+
+// Grid resolution. MUST match CLUSTER_X/Y/Z in shader/lights.sh.
+inline constexpr u32 c_ClusterTilesX = 16;
+inline constexpr u32 c_ClusterTilesY = 9;
+inline constexpr u32 c_ClusterSlices = 24;
+inline constexpr u32 c_ClusterCount = c_ClusterTilesX * c_ClusterTilesY * c_ClusterSlices;
+
+// Max lights per frame (light data rows) and, of those, directional lights
+// (looped unconditionally by every fragment). MUST match MAX_LIGHTS /
+// MAX_DIRECTIONAL_LIGHTS in shader/lights.sh.
+inline constexpr u32 c_MaxLights = 1024;
+inline constexpr u32 c_MaxDirectionalLights = 4;
+// Per-cluster list length cap (bounds the shader loop); MAX_CLUSTER_LIGHTS.
+inline constexpr u32 c_MaxClusterLights = 128;
+
+inline constexpr u32 c_LightDataTexels = 4;   // vec4s per light
+inline constexpr u32 c_LightIndexWidth = 256; // LIGHT_INDEX_WIDTH
+inline constexpr u32 c_MaxLightIndices = c_LightIndexWidth * 256;
+
+// Per-build counters (SceneRendererStats copies them for r.stats).
+struct LightGridStats
+{
+    u32 DirectionalLights = 0;
+    u32 LocalLights = 0;     // point/spot lights inside the view depth range
+    u32 IndexEntries = 0;    // (cluster, light) pairs written
+    u32 DroppedEntries = 0;  // pairs over the per-cluster or total capacity
+};
+
+class LightGrid
+{
+public:
+    LightGrid() = default;
+    ~LightGrid();
+
+    LightGrid(const LightGrid&) = delete;
+    LightGrid& operator=(const LightGrid&) = delete;
+
+    // Bin `lights` for the camera and upload the textures. `view` is the camera
+    // view matrix, `proj` its un-reversed projection; near/far are the
+    // un-reversed clip distances. Main thread only. Directional lights beyond
+    // c_MaxDirectionalLights and lights beyond c_MaxLights are ignored.
+    void Build(const std::vector<SceneRendererLight>& lights, const glm::mat4& view,
+               const glm::mat4& proj, float nearClip, float farClip);
+
+    // Textures + slice parameters of the last Build, for Renderer::SetLightGrid.
+    const Renderer::LightGridBinding& GetBinding() const { return m_Binding; }
+
+    const LightGridStats& GetStats() const { return m_Stats; }
+
+private:
+    void EnsureTextures();
+
+    // Exponential slice of view depth `z` (positive, in front of the camera).
+    u32 SliceOf(float z) const;
+
+    bgfx::TextureHandle m_LightData = BGFX_INVALID_HANDLE;
+    bgfx::TextureHandle m_Grid = BGFX_INVALID_HANDLE;
+    bgfx::TextureHandle m_Indices = BGFX_INVALID_HANDLE;
+
+    Renderer::LightGridBinding m_Binding;
+    LightGridStats m_Stats;
+    float m_Near = 0.1f;
+    float m_SliceScale = 0.0f; // slices / log(far / near)
+    float m_SliceBias = 0.0f;  // log(near) * m_SliceScale
+
+    // A local light's footprint in one depth slice: an inclusive tile rectangle.
+    struct Footprint
+    {
+        u32 Light;
+        u32 Slice;
+        u32 X0, X1, Y0, Y1;
+    };
+
+    // Scratch, reused every frame.
+    std::vector<Footprint> m_Footprints;
+    std::vector<u32> m_ClusterCounts;
+    std::vector<u32> m_ClusterCursor;
+    std::vector<glm::vec4> m_LightTexels;
+    std::vector<float> m_GridTexels;
+    std::vector<float> m_IndexTexels;
+};
+
+} // namespace Seraph
@@ -30,19 +30,21 @@ void Material::SetParameter(const MaterialParameter& param)
     for (MaterialParameter& existing : m_Parameters) {
         if (existing.Name == param.Name) {
             existing = param;
-            m_ResolveDirty = true;
+            MarkDirty();
             return;
         }
     }
     m_Parameters.push_back(param);
-    m_ResolveDirty = true;
+    MarkDirty();
 }
 
 MaterialParameter* Material::FindParameter(const std::string& name)
 {
     for (MaterialParameter& param : m_Parameters)
-        if (param.Name == name)
+        if (param.Name == name) {
+            MarkDirty(); // the caller may edit through the pointer
             return &param;
+        }
     return nullptr;
 }
 
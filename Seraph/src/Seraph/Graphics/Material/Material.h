@@ -37,7 +37,7 @@ public:
     void SetShaderName(std::string name)
     {
         m_ShaderName = std::move(name);
-        m_ResolveDirty = true;
+        MarkDirty();
     }
     [[nodiscard]] const std::string& ShaderName() const { return m_ShaderName; }
 
@@ -48,12 +48,12 @@ public:
     void ClearParameters()
     {
         m_Parameters.clear();
-        m_ResolveDirty = true;
+        MarkDirty();
     }
 
     [[nodiscard]] MaterialRenderState& RenderState()
     {
-        m_ResolveDirty = true;
+        MarkDirty();
         return m_State;
     }
     [[nodiscard]] const MaterialRenderState& RenderState() const { return m_State; }
@@ -74,6 +74,7 @@ public:
 
     // --- MaterialAsset -----------------------------------------------------
     const ResolvedMaterial& Resolve() override;
+    [[nodiscard]] u64 ContentVersion() override { return m_Version; }
 
     // Shader (resolved from its name) + any texture parameters.
     [[nodiscard]] std::vector<AssetHandle> GetDependencies() const override;
@@ -87,6 +88,12 @@ public:
     static Ref<Material> GetDefault();
 
 private:
+    void MarkDirty()
+    {
+        m_ResolveDirty = true;
+        m_Version = NextEditStamp();
+    }
+
     std::string m_ShaderName;
     std::vector<MaterialParameter> m_Parameters;
     MaterialRenderState m_State;
@@ -94,6 +101,7 @@ private:
 
     ResolvedMaterial m_Resolved;
     bool m_ResolveDirty = true;
+    u64 m_Version = 0; // edit stamp of the latest change (see ContentVersion)
 };
 
 } // namespace Seraph
@@ -7,6 +7,8 @@
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include <atomic>
+
 namespace Seraph
 {
 
@@ -23,22 +25,65 @@ Ref<MaterialAsset> MaterialAsset::Get(AssetHandle handle)
     return nullptr;
 }
 
-void MaterialAsset::Bind()
+namespace
+{
+std::atomic<u64> s_EditStamp{0};
+} // namespace
+
+u64 MaterialAsset::NextEditStamp()
+{
+    return s_EditStamp.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+u64 MaterialAsset::LatestEditStamp()
+{
+    return s_EditStamp.load(std::memory_order_relaxed);
+}
+
+void MaterialAsset::Bind(bgfx::Encoder* encoder)
 {
-    BindResolved(Resolve());
+    const MaterialBindBlock& block = BindBlock();
+    encoder = encoder ? encoder : bgfx::begin();
+
+    encoder->setState(block.State);
+    for (const MaterialBindBlock::Uniform& uniform : block.Uniforms)
+        encoder->setUniform(uniform.Handle, glm::value_ptr(block.Data[uniform.Offset]), 1);
+    for (const MaterialBindBlock::Texture& texture : block.Textures)
+        encoder->setTexture(texture.Stage, texture.Sampler, texture.Handle, texture.Flags);
+}
+
+const MaterialBindBlock& MaterialAsset::BindBlock()
+{
+    // Generations are read first so a load racing the compile only causes an
+    // extra one.
+    const u64 generation = AssetManager::GetGeneration();
+    const u64 loadGeneration = AssetManager::GetLoadGeneration();
+    const u64 version = ContentVersion();
+    if (!m_BindCompiled || version != m_BindVersion || generation != m_BindGeneration ||
+        (m_BindPending && loadGeneration != m_BindLoadGeneration)) {
+        m_BindPending = !CompileBindBlock(Resolve(), m_BindBlock);
+        m_BindVersion = version;
+        m_BindGeneration = generation;
+        m_BindLoadGeneration = loadGeneration;
+        m_BindCompiled = true;
+    }
+    return m_BindBlock;
 }
 
 bgfx::ProgramHandle MaterialAsset::Program()
 {
-    const AssetHandle shader = Resolve().Shader;
-    if (Ref<ShaderAsset> asset = AssetManager::GetAsset<ShaderAsset>(shader))
-        return asset->Program();
-    return BGFX_INVALID_HANDLE;
+    return BindBlock().Program;
 }
 
-void MaterialAsset::BindResolved(const ResolvedMaterial& resolved)
+bool MaterialAsset::CompileBindBlock(const ResolvedMaterial& resolved, MaterialBindBlock& block)
 {
-    bgfx::setState(resolved.State.ToBgfxState());
+    block = MaterialBindBlock{};
+    block.State = resolved.State.ToBgfxState();
+    bool complete = true;
+    if (Ref<ShaderAsset> shader = AssetManager::GetAsset<ShaderAsset>(resolved.Shader))
+        block.Program = shader->Program();
+    else if (static_cast<u64>(resolved.Shader) != c_NullAssetHandle)
+        complete = false;
 
     for (const MaterialParameter& param : resolved.Params) {
         const bgfx::UniformHandle uniform =
@@ -46,40 +91,39 @@ void MaterialAsset::BindResolved(const ResolvedMaterial& resolved)
         if (!bgfx::isValid(uniform))
             continue;
 
+        const auto offset = static_cast<u32>(block.Data.size());
         switch (param.Type) {
             case MaterialParameterType::Texture: {
                 Ref<Texture2D> texture =
                     AssetManager::GetAsset<Texture2D>(param.Texture.Texture);
-                if (!texture || !texture->IsValid())
+                if (!texture || !texture->IsValid()) {
+                    if (static_cast<u64>(param.Texture.Texture) != c_NullAssetHandle)
+                        complete = false;
                     texture = Texture2D::GetDefaultWhite();
+                }
                 if (texture && texture->IsValid())
-                    bgfx::setTexture(
-                        param.Texture.Stage, uniform, texture->Handle(),
-                        param.Texture.SamplerFlags);
-                break;
+                    block.Textures.push_back({uniform, texture->Handle(),
+                        param.Texture.SamplerFlags, param.Texture.Stage});
+                continue;
             }
             case MaterialParameterType::Mat4:
-                bgfx::setUniform(uniform, glm::value_ptr(param.Matrix), 1);
+                for (int col = 0; col < 4; ++col)
+                    block.Data.push_back(param.Matrix[col]);
                 break;
-            case MaterialParameterType::Mat3: {
+            case MaterialParameterType::Mat3:
                 // bgfx Mat3 uniforms are 3 vec4 registers; pack the upper-left
                 // 3x3 (column-major) with a trailing 0 per column.
-                float packed[12];
-                for (int col = 0; col < 3; ++col) {
-                    packed[col * 4 + 0] = param.Matrix[col][0];
-                    packed[col * 4 + 1] = param.Matrix[col][1];
-                    packed[col * 4 + 2] = param.Matrix[col][2];
-                    packed[col * 4 + 3] = 0.0f;
-                }
-                bgfx::setUniform(uniform, packed, 1);
+                for (int col = 0; col < 3; ++col)
+                    block.Data.emplace_back(glm::vec3(param.Matrix[col]), 0.0f);
                 break;
-            }
             default:
                 // Bool/Int/Float/Vec2/Vec3/Vec4/Color: always a full vec4.
-                bgfx::setUniform(uniform, glm::value_ptr(param.Vector), 1);
+                block.Data.push_back(param.Vector);
                 break;
         }
+        block.Uniforms.push_back({uniform, offset});
     }
+    return complete;
 }
 
 } // namespace Seraph
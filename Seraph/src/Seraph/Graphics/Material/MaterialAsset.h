@@ -16,6 +16,7 @@
 #include "Seraph/Graphics/Material/MaterialRenderState.h"
 
 #include <bgfx/bgfx.h>
+#include <glm/glm.hpp>
 
 #include <vector>
 
@@ -30,6 +31,32 @@ struct ResolvedMaterial
     MaterialRenderState State;
 };
 
+// A resolved material compiled down to exactly what a draw binds: the bgfx
+// state word, the program, pre-resolved uniform handles over packed vec4 data,
+// and texture handles. Binding it is a straight walk with no name, asset or
+// state-word work.
+struct MaterialBindBlock
+{
+    struct Uniform
+    {
+        bgfx::UniformHandle Handle = BGFX_INVALID_HANDLE;
+        u32 Offset = 0; // first vec4 in Data (Vec4: 1, Mat3: 3, Mat4: 4 registers)
+    };
+    struct Texture
+    {
+        bgfx::UniformHandle Sampler = BGFX_INVALID_HANDLE;
+        bgfx::TextureHandle Handle = BGFX_INVALID_HANDLE;
+        u32 Flags = UINT32_MAX;
+        u8 Stage = 0;
+    };
+
+    u64 State = 0;
+    bgfx::ProgramHandle Program = BGFX_INVALID_HANDLE;
+    std::vector<Uniform> Uniforms;
+    std::vector<glm::vec4> Data;
+    std::vector<Texture> Textures;
+};
+
 class MaterialAsset : public Asset
 {
 public:
@@ -45,18 +72,47 @@ public:
     // merged with overrides.
     virtual const ResolvedMaterial& Resolve() = 0;
 
-    // Bind render state + uniforms + textures for the next draw. Does NOT submit.
-    void Bind();
+    // Changes whenever Resolve()'s output may have: the newest edit stamp of
+    // this material and (for an instance) its parent chain.
+    [[nodiscard]] virtual u64 ContentVersion() = 0;
 
-    // Resolve the bgfx program for this material's shader (via the AssetManager),
-    // or BGFX_INVALID_HANDLE if unavailable.
+    // Bind render state + uniforms + textures for the next draw on `encoder`
+    // (null = the main-thread encoder). Does NOT submit. Main thread only: a
+    // stale bind block is recompiled here (uniform creation, asset lookups).
+    void Bind(bgfx::Encoder* encoder = nullptr);
+
+    // This material's compiled bind block, recompiled only when ContentVersion()
+    // or the asset manager's generation (an asset was reloaded or dropped) moved
+    // since the last compile, or — while the block is waiting on a texture or
+    // shader that was not loaded yet — when the load generation moved. Main
+    // thread only.
+    const MaterialBindBlock& BindBlock();
+
+    // The bgfx program for this material's shader, or BGFX_INVALID_HANDLE if
+    // unavailable (from the bind block).
     [[nodiscard]] bgfx::ProgramHandle Program();
 
 protected:
-    // Shared bind used by both material kinds. Sets state, uploads every
-    // parameter through the UniformCache, and binds textures (falling back to
-    // the default white texture for unassigned/unresolved samplers).
-    static void BindResolved(const ResolvedMaterial& resolved);
+    // Process-wide increasing stamp for an edit, so versions from different
+    // materials in a chain can be combined with max.
+    static u64 NextEditStamp();
+    // The newest stamp handed out so far (0 before any edit). Unchanged means no
+    // material anywhere was edited, so cached chain versions still hold.
+    static u64 LatestEditStamp();
+
+private:
+    // Compile `resolved`: uniforms through the UniformCache, textures through the
+    // AssetManager (falling back to the default white texture for
+    // unassigned/unresolved samplers), the state word, the shader's program.
+    // Returns false if an assigned texture or the shader is not loaded yet.
+    static bool CompileBindBlock(const ResolvedMaterial& resolved, MaterialBindBlock& block);
+
+    MaterialBindBlock m_BindBlock;
+    u64 m_BindVersion = 0;
+    u64 m_BindGeneration = 0;
+    u64 m_BindLoadGeneration = 0;
+    bool m_BindCompiled = false;
+    bool m_BindPending = false; // compiled with a fallback for a missing asset
 };
 
 } // namespace Seraph
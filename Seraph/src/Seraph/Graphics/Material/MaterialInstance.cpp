@@ -3,6 +3,8 @@
 #include "Seraph/Asset/AssetManager.h"
 #include "Seraph/Core/Log.h"
 
+#include <algorithm>
+
 namespace Seraph
 {
 
@@ -37,15 +39,18 @@ void MaterialInstance::SetOverride(const MaterialParameter& param)
     for (MaterialParameter& existing : m_Overrides) {
         if (existing.Name == param.Name) {
             existing = param;
+            m_Version = NextEditStamp();
             return;
         }
     }
     m_Overrides.push_back(param);
+    m_Version = NextEditStamp();
 }
 
 void MaterialInstance::ClearOverride(const std::string& name)
 {
-    std::erase_if(m_Overrides, [&](const MaterialParameter& p) { return p.Name == name; });
+    if (std::erase_if(m_Overrides, [&](const MaterialParameter& p) { return p.Name == name; }) > 0)
+        m_Version = NextEditStamp();
 }
 
 bool MaterialInstance::HasOverride(const std::string& name) const
@@ -56,20 +61,102 @@ bool MaterialInstance::HasOverride(const std::string& name) const
     return false;
 }
 
+void MaterialInstance::RefreshParent(u64 generation, u64 loadGeneration)
+{
+    const bool parentMissing = !m_ParentRef && static_cast<u64>(m_Parent) != c_NullAssetHandle;
+    if (m_ParentLookedUp && generation == m_ParentGeneration &&
+        (!parentMissing || loadGeneration == m_ParentLoadGeneration))
+        return;
+    Ref<MaterialAsset> parent = MaterialAsset::Get(m_Parent);
+    // A reloaded (or newly loaded) parent is a new object whose stamps need not
+    // be newer than what was cached against the old one.
+    if (m_ParentLookedUp && parent.Raw() != m_ParentRef.Raw())
+        m_Version = NextEditStamp();
+    m_ParentRef = std::move(parent);
+    m_ParentGeneration = generation;
+    m_ParentLoadGeneration = loadGeneration;
+    m_ParentLookedUp = true;
+}
+
+u64 MaterialInstance::ContentVersion()
+{
+    return WalkVersion(0).Version;
+}
+
+MaterialInstance::VersionWalk MaterialInstance::WalkVersion(int depth)
+{
+    const u64 generation = AssetManager::GetGeneration();
+    const u64 loadGeneration = AssetManager::GetLoadGeneration();
+    if (m_ChainValid && LatestEditStamp() == m_ChainStamp && generation == m_ChainGeneration &&
+        (!m_ChainParentMissing || loadGeneration == m_ChainLoadGeneration))
+        return {m_ChainVersion, m_ChainParentMissing, false};
+
+    RefreshParent(generation, loadGeneration);
+    // Stamps are global and increasing, so the newest edit anywhere in the
+    // chain (including a SetParent here) always moves the max.
+    VersionWalk walk{m_Version, !m_ParentRef && static_cast<u64>(m_Parent) != c_NullAssetHandle};
+    if (m_ParentRef) {
+        if (depth + 1 >= k_MaxParentDepth) {
+            walk.Cycle = true;
+        } else if (m_ParentRef->GetAssetType() == AssetType::MaterialInstance) {
+            const VersionWalk parent =
+                static_cast<MaterialInstance*>(m_ParentRef.Raw())->WalkVersion(depth + 1);
+            walk.Version = std::max(walk.Version, parent.Version);
+            walk.ParentMissing = walk.ParentMissing || parent.ParentMissing;
+            walk.Cycle = parent.Cycle;
+        } else {
+            walk.Version = std::max(walk.Version, m_ParentRef->ContentVersion());
+        }
+    }
+
+    if (walk.Cycle) {
+        if (depth == 0 && !m_CycleReported) {
+            SP_CORE_ERROR_TAG(
+                "Material", "MaterialInstance {} parent chain too deep (cycle?)",
+                static_cast<u64>(Handle));
+            m_CycleReported = true;
+        }
+        m_ChainValid = false;
+        return walk;
+    }
+
+    m_ChainVersion = walk.Version;
+    // Read after the walk: a parent refresh above may have taken a stamp.
+    m_ChainStamp = LatestEditStamp();
+    m_ChainGeneration = generation;
+    m_ChainLoadGeneration = loadGeneration;
+    m_ChainParentMissing = walk.ParentMissing;
+    m_ChainValid = true;
+    if (depth == 0)
+        m_CycleReported = false;
+    return walk;
+}
+
 const ResolvedMaterial& MaterialInstance::Resolve()
 {
+    // Reuse the cached set until this instance or an ancestor is edited, or the
+    // loaded asset set changes (a reloaded parent is a new object whose stamps
+    // need not be newer). Generation is read first so a load racing the
+    // version walk only causes an extra rebuild.
+    const u64 generation = AssetManager::GetGeneration();
+    const VersionWalk walk = WalkVersion(0); // also refreshes m_ParentRef
+    const u64 version = walk.Version;
+    if (m_ResolveValid && version == m_ResolvedVersion && generation == m_ResolvedGeneration)
+        return m_Resolved;
+
     // Start from the parent's resolved set (walk the chain, depth-guarded).
     m_Resolved = ResolvedMaterial{};
 
-    if (s_ResolveDepth >= k_MaxParentDepth) {
-        SP_CORE_ERROR_TAG(
-            "Material", "MaterialInstance {} parent chain too deep (cycle?)",
-            static_cast<u64>(Handle));
+    // A cyclic chain resolves to nothing (no shader, so nothing draws) rather
+    // than to whatever part of the loop the depth cap cut off, and is not
+    // cached: fixing any link takes an edit stamp and resolves it again.
+    if (walk.Cycle || s_ResolveDepth >= k_MaxParentDepth) {
+        m_ResolveValid = false;
         return m_Resolved;
     }
     ResolveDepthGuard guard;
 
-    Ref<MaterialAsset> parent = MaterialAsset::Get(m_Parent);
+    const Ref<MaterialAsset>& parent = m_ParentRef;
     if (parent) {
         m_Resolved = parent->Resolve();
     } else if (static_cast<u64>(m_Parent) != c_NullAssetHandle) {
@@ -95,6 +182,9 @@ const ResolvedMaterial& MaterialInstance::Resolve()
     if (m_StateOverride)
         m_Resolved.State = *m_StateOverride;
 
+    m_ResolvedVersion = version;
+    m_ResolvedGeneration = generation;
+    m_ResolveValid = true;
     return m_Resolved;
 }
 
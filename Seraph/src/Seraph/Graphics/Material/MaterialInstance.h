@@ -29,7 +29,12 @@ public:
     explicit MaterialInstance(AssetHandle parent) : m_Parent(parent) {}
     ~MaterialInstance() override = default;
 
-    void SetParent(AssetHandle parent) { m_Parent = parent; }
+    void SetParent(AssetHandle parent)
+    {
+        m_Parent = parent;
+        m_ParentLookedUp = false;
+        m_Version = NextEditStamp();
+    }
     [[nodiscard]] AssetHandle Parent() const { return m_Parent; }
 
     // Add or replace an override by parameter name. The override carries its own
@@ -40,21 +45,70 @@ public:
     [[nodiscard]] const std::vector<MaterialParameter>& Overrides() const { return m_Overrides; }
     [[nodiscard]] bool HasOverride(const std::string& name) const;
 
-    void SetStateOverride(const MaterialRenderState& state) { m_StateOverride = state; }
-    void ClearStateOverride() { m_StateOverride.reset(); }
+    void SetStateOverride(const MaterialRenderState& state)
+    {
+        m_StateOverride = state;
+        m_Version = NextEditStamp();
+    }
+    void ClearStateOverride()
+    {
+        m_StateOverride.reset();
+        m_Version = NextEditStamp();
+    }
     [[nodiscard]] const std::optional<MaterialRenderState>& StateOverride() const { return m_StateOverride; }
 
     const ResolvedMaterial& Resolve() override;
+    // Newest of this instance's edit stamp and its parent's ContentVersion. The
+    // parent is looked up again only after SetParent, a generation change, or
+    // (while it is missing) a load generation change; finding a different
+    // parent object counts as an edit. The result is cached until any material
+    // is edited or the parent is reloaded, so a steady-state call is O(1)
+    // rather than a walk of the chain. A cyclic (or deeper than
+    // k_MaxParentDepth) chain is an error: it is logged, never cached, and
+    // Resolve() yields an empty set for it.
+    [[nodiscard]] u64 ContentVersion() override;
 
     // Parent material + any texture overrides.
     [[nodiscard]] std::vector<AssetHandle> GetDependencies() const override;
 
 private:
+    // One step of the ContentVersion walk: the combined version, whether an
+    // ancestor's parent is missing (so a load may change it) and whether the
+    // walk hit the depth cap.
+    struct VersionWalk
+    {
+        u64 Version = 0;
+        bool ParentMissing = false;
+        bool Cycle = false;
+    };
+    VersionWalk WalkVersion(int depth);
+    void RefreshParent(u64 generation, u64 loadGeneration);
+
     AssetHandle m_Parent = c_NullAssetHandle;
     std::vector<MaterialParameter> m_Overrides;
     std::optional<MaterialRenderState> m_StateOverride;
 
-    ResolvedMaterial m_Resolved; // rebuilt each Resolve() to track parent edits
+    // Cached Resolve() output, valid for (ContentVersion, asset generation).
+    ResolvedMaterial m_Resolved;
+    u64 m_ResolvedVersion = 0;
+    u64 m_ResolvedGeneration = 0;
+    bool m_ResolveValid = false;
+
+    u64 m_Version = 0; // edit stamp of the latest change above
+    Ref<MaterialAsset> m_ParentRef; // cached parent lookup (ContentVersion/Resolve)
+    u64 m_ParentGeneration = 0;
+    u64 m_ParentLoadGeneration = 0;
+    bool m_ParentLookedUp = false;
+
+    // Cached ContentVersion(), valid while LatestEditStamp() and the asset
+    // generation hold (and the load generation, while an ancestor is missing).
+    u64 m_ChainVersion = 0;
+    u64 m_ChainStamp = 0;
+    u64 m_ChainGeneration = 0;
+    u64 m_ChainLoadGeneration = 0;
+    bool m_ChainParentMissing = false;
+    bool m_ChainValid = false;
+    bool m_CycleReported = false;
 };
 
 } // namespace Seraph
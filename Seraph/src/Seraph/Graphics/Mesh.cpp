@@ -6,7 +6,11 @@
 
 #include "Seraph/Asset/AssetRef.h"
 #include "Seraph/Core/Log.h"
+#include "Seraph/Math/DynamicAABBTree.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstring>
 
 namespace Seraph
@@ -21,6 +25,137 @@ const bool k_MeshAssetRefReflected = [] {
     RegisterAssetRefType<Mesh>();
     return true;
 }();
+
+// Walks a mesh's LOD 0 triangles submesh by submesh for the CPU queries.
+// Positions are read straight from the vertex bytes when they are plain float3,
+// otherwise decoded through Mesh::VertexPosition.
+class TriangleWalker
+{
+public:
+    explicit TriangleWalker(const Mesh& mesh) : m_Mesh(mesh)
+    {
+        const bgfx::VertexLayout* layout = mesh.Layout();
+        if (layout == nullptr || !layout->has(bgfx::Attrib::Position))
+            return;
+        m_Valid = true;
+        u8 num = 0;
+        bgfx::AttribType::Enum type = bgfx::AttribType::Float;
+        bool normalized = false, asInt = false;
+        layout->decode(bgfx::Attrib::Position, num, type, normalized, asInt);
+        m_Stride = layout->getStride();
+        m_Offset = layout->getOffset(bgfx::Attrib::Position);
+        m_DirectFloat3 = num >= 3 && type == bgfx::AttribType::Float && !asInt &&
+                         mesh.PositionScale() == glm::vec3(1.0f) &&
+                         mesh.PositionOffset() == glm::vec3(0.0f);
+    }
+
+    [[nodiscard]] bool IsValid() const { return m_Valid; }
+
+    // Calls fn(a, b, c) for each triangle of `submesh`; stops when fn returns
+    // false (and then returns false itself).
+    template<typename Fn>
+    bool ForEachTriangle(u32 submesh, Fn&& fn) const
+    {
+        u32 first = 0, count = 0;
+        if (!m_Mesh.SubmeshRange(submesh, 0, first, count))
+            return true;
+        const u32 base = m_Mesh.SubmeshBaseVertex(submesh);
+        const u32 vertexCount = m_Mesh.VertexCount();
+        const u32 end = std::min(first + count, m_Mesh.IndexCount());
+        for (u32 i = first; i + 2 < end; i += 3) {
+            const u32 a = base + Index(i), b = base + Index(i + 1), c = base + Index(i + 2);
+            if (a >= vertexCount || b >= vertexCount || c >= vertexCount)
+                continue;
+            if (!fn(Position(a), Position(b), Position(c)))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    [[nodiscard]] u32 Index(u32 i) const
+    {
+        const u8* data = m_Mesh.IndexData().data();
+        if (m_Mesh.IndexSize() == sizeof(u32)) {
+            u32 v;
+            std::memcpy(&v, data + static_cast<size_t>(i) * sizeof(u32), sizeof(u32));
+            return v;
+        }
+        u16 v;
+        std::memcpy(&v, data + static_cast<size_t>(i) * sizeof(u16), sizeof(u16));
+        return v;
+    }
+
+    [[nodiscard]] glm::vec3 Position(u32 vertex) const
+    {
+        if (!m_DirectFloat3)
+            return m_Mesh.VertexPosition(vertex);
+        glm::vec3 p;
+        std::memcpy(&p[0],
+                    m_Mesh.VertexData().data() + static_cast<size_t>(vertex) * m_Stride + m_Offset,
+                    sizeof(float) * 3);
+        return p;
+    }
+
+    const Mesh& m_Mesh;
+    bool m_Valid = false;
+    bool m_DirectFloat3 = false;
+    u32 m_Stride = 0;
+    u32 m_Offset = 0;
+};
+
+// Two-sided Moller-Trumbore: the ray parameter of the hit, or a negative value.
+float RayTriangle(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& a,
+                  const glm::vec3& b, const glm::vec3& c)
+{
+    constexpr float c_Epsilon = 1e-12f;
+    const glm::vec3 e1 = b - a;
+    const glm::vec3 e2 = c - a;
+    const glm::vec3 p = glm::cross(direction, e2);
+    const float det = glm::dot(e1, p);
+    if (std::abs(det) < c_Epsilon)
+        return -1.0f;
+    const float invDet = 1.0f / det;
+    const glm::vec3 s = origin - a;
+    const float u = glm::dot(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f)
+        return -1.0f;
+    const glm::vec3 q = glm::cross(s, e1);
+    const float v = glm::dot(direction, q) * invDet;
+    if (v < 0.0f || u + v > 1.0f)
+        return -1.0f;
+    return glm::dot(e2, q) * invDet;
+}
+
+// Whether triangle abc reaches inside the frustum: clipped against each plane
+// in turn (Sutherland-Hodgman), it intersects iff something survives.
+bool TriangleInFrustum(const Frustum& frustum, const glm::vec3& a, const glm::vec3& b,
+                       const glm::vec3& c)
+{
+    // Each plane adds at most one vertex.
+    std::array<glm::vec3, 3 + Frustum::Count> polygon{a, b, c};
+    std::array<glm::vec3, 3 + Frustum::Count> clipped{};
+    size_t count = 3;
+    for (const glm::vec4& plane : frustum.Planes) {
+        const glm::vec3 n(plane);
+        size_t out = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const glm::vec3& p = polygon[i];
+            const glm::vec3& q = polygon[(i + 1) % count];
+            const float dp = glm::dot(n, p) + plane.w;
+            const float dq = glm::dot(n, q) + plane.w;
+            if (dp >= 0.0f)
+                clipped[out++] = p;
+            if ((dp >= 0.0f) != (dq >= 0.0f))
+                clipped[out++] = p + (q - p) * (dp / (dp - dq));
+        }
+        if (out == 0)
+            return false;
+        polygon = clipped;
+        count = out;
+    }
+    return true;
+}
 } // namespace
 
 Mesh::~Mesh()
@@ -29,6 +164,7 @@ Mesh::~Mesh()
         bgfx::destroy(m_VertexBuffer);
     if (bgfx::isValid(m_IndexBuffer))
         bgfx::destroy(m_IndexBuffer);
+    DestroyPositionBuffer();
 }
 
 void Mesh::SetName(const std::string& name)
@@ -54,6 +190,7 @@ void Mesh::SetVertexData(const void* data, const u32 byteSize)
         bgfx::destroy(m_VertexBuffer);
         m_VertexBuffer = BGFX_INVALID_HANDLE;
     }
+    DestroyPositionBuffer();
 
     if (m_Layout == nullptr) {
         SP_CORE_ERROR_TAG("Mesh", "Vertex data for mesh '{}' set with no layout", m_Name);
@@ -64,6 +201,7 @@ void Mesh::SetVertexData(const void* data, const u32 byteSize)
     // for serialization.
     m_VertexBuffer =
         bgfx::createVertexBuffer(bgfx::copy(m_Vertices.data(), byteSize), *m_Layout);
+    CreatePositionBuffer();
 }
 
 void Mesh::SetIndexData(const void* data, const u32 byteSize, const u32 indexSize)
@@ -109,9 +247,170 @@ bool Mesh::Upload()
         SP_CORE_ERROR_TAG("Mesh", "Cannot upload mesh '{}' with no staged data", m_Name);
         return false;
     }
+    if (!m_Bounds.IsValid())
+        ComputeBounds();
     return CreateBuffers();
 }
 
+void Mesh::ComputeBounds()
+{
+    m_Bounds = {};
+    m_Sphere = {};
+    if (m_Layout == nullptr || !m_Layout->has(bgfx::Attrib::Position) ||
+        m_Vertices.empty() || m_Indices.empty())
+        return;
+
+    const u32 vertexCount = VertexCount();
+    const u32 indexCount = IndexCount();
+    const auto indexAt = [&](u32 i) -> u32 {
+        if (m_IndexSize == sizeof(u32)) {
+            u32 v;
+            std::memcpy(&v, m_Indices.data() + static_cast<size_t>(i) * sizeof(u32), sizeof(u32));
+            return v;
+        }
+        u16 v;
+        std::memcpy(&v, m_Indices.data() + static_cast<size_t>(i) * sizeof(u16), sizeof(u16));
+        return v;
+    };
+
+    // Box of every vertex referenced by [first, first + count), relative to
+    // baseVertex.
+    const auto rangeBounds = [&](u32 baseVertex, u32 first, u32 count) {
+        AABB box;
+        const u32 end = std::min(first + count, indexCount);
+        for (u32 i = first; i < end; ++i) {
+            const u32 vertex = baseVertex + indexAt(i);
+            if (vertex < vertexCount)
+                box.Expand(VertexPosition(vertex));
+        }
+        return box;
+    };
+
+    if (m_Submeshes.empty()) {
+        m_Bounds = rangeBounds(0, 0, indexCount);
+    } else {
+        for (Submesh& submesh : m_Submeshes) {
+            submesh.Bounds =
+                rangeBounds(submesh.BaseVertex, submesh.BaseIndex, submesh.IndexCount);
+            m_Bounds.Expand(submesh.Bounds);
+        }
+    }
+    if (m_Bounds.IsValid())
+        m_Sphere = BoundingSphere::FromAABB(m_Bounds);
+}
+
+void Mesh::SetBounds(const AABB& bounds)
+{
+    m_Bounds = bounds;
+    m_Sphere = bounds.IsValid() ? BoundingSphere::FromAABB(bounds) : BoundingSphere{};
+}
+
+bool Mesh::HasOctahedralNormals() const
+{
+    if (m_Layout == nullptr || !m_Layout->has(bgfx::Attrib::Normal))
+        return false;
+    u8 num;
+    bgfx::AttribType::Enum type;
+    bool normalized, asInt;
+    m_Layout->decode(bgfx::Attrib::Normal, num, type, normalized, asInt);
+    return num == 2;
+}
+
+glm::vec3 Mesh::VertexPosition(u32 vertex) const
+{
+    float pos[4];
+    bgfx::vertexUnpack(pos, bgfx::Attrib::Position, *m_Layout, m_Vertices.data(), vertex);
+    return glm::vec3(pos[0], pos[1], pos[2]) * m_PositionScale + m_PositionOffset;
+}
+
+bool Mesh::RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxT,
+                   float& t) const
+{
+    const TriangleWalker walker(*this);
+    if (!walker.IsValid())
+        return false;
+
+    const glm::vec3 invDirection = 1.0f / direction;
+    const u32 submeshCount = m_Submeshes.empty() ? 1 : static_cast<u32>(m_Submeshes.size());
+    bool hit = false;
+    float nearest = maxT;
+    for (u32 s = 0; s < submeshCount; ++s) {
+        const AABB& bounds = m_Submeshes.empty() ? m_Bounds : m_Submeshes[s].Bounds;
+        if (bounds.IsValid() &&
+            DynamicAABBTree::RayBoxEntry(origin, invDirection, bounds, nearest) < 0.0f)
+            continue;
+        walker.ForEachTriangle(s, [&](const glm::vec3& a, const glm::vec3& b,
+                                      const glm::vec3& c) {
+            const float candidate = RayTriangle(origin, direction, a, b, c);
+            if (candidate >= 0.0f && candidate <= nearest) {
+                nearest = candidate;
+                hit = true;
+            }
+            return true;
+        });
+    }
+    if (hit)
+        t = nearest;
+    return hit;
+}
+
+bool Mesh::Intersects(const Frustum& frustum) const
+{
+    const TriangleWalker walker(*this);
+    if (!walker.IsValid())
+        return false;
+
+    const u32 submeshCount = m_Submeshes.empty() ? 1 : static_cast<u32>(m_Submeshes.size());
+    for (u32 s = 0; s < submeshCount; ++s) {
+        const AABB& bounds = m_Submeshes.empty() ? m_Bounds : m_Submeshes[s].Bounds;
+        const FrustumTest test = bounds.IsValid() ? frustum.Test(bounds) : FrustumTest::Intersects;
+        if (test == FrustumTest::Outside)
+            continue;
+        // Stops (returns false) at the first triangle inside.
+        const bool none = walker.ForEachTriangle(s, [&](const glm::vec3& a, const glm::vec3& b,
+                                                         const glm::vec3& c) {
+            return test != FrustumTest::Inside && !TriangleInFrustum(frustum, a, b, c);
+        });
+        if (!none)
+            return true;
+    }
+    return false;
+}
+
+Mesh::IndexRange Mesh::LevelRange(u32 lod) const
+{
+    if (lod == 0 || m_Lods.empty()) {
+        // LOD 0 is everything before the first coarser level.
+        return {0, m_Lods.empty() ? IndexCount() : m_Lods.front().Range.BaseIndex};
+    }
+    return m_Lods[std::min<size_t>(lod, m_Lods.size()) - 1].Range;
+}
+
+bool Mesh::SubmeshRange(u32 submesh, u32 lod, u32& firstIndex, u32& indexCount) const
+{
+    const u32 submeshCount = m_Submeshes.empty() ? 1 : static_cast<u32>(m_Submeshes.size());
+    if (submesh >= submeshCount)
+        return false;
+    lod = std::min(lod, static_cast<u32>(m_Lods.size()));
+    if (lod > 0) {
+        const std::vector<IndexRange>& ranges = m_Lods[lod - 1].Submeshes;
+        if (submesh >= ranges.size())
+            return false;
+        firstIndex = ranges[submesh].BaseIndex;
+        indexCount = ranges[submesh].IndexCount;
+        return true;
+    }
+    if (m_Submeshes.empty()) {
+        const IndexRange level = LevelRange(0);
+        firstIndex = level.BaseIndex;
+        indexCount = level.IndexCount;
+        return true;
+    }
+    firstIndex = m_Submeshes[submesh].BaseIndex;
+    indexCount = m_Submeshes[submesh].IndexCount;
+    return true;
+}
+
 bool Mesh::CreateBuffers()
 {
     if (bgfx::isValid(m_VertexBuffer))
@@ -127,7 +426,47 @@ bool Mesh::CreateBuffers()
     m_IndexBuffer = bgfx::createIndexBuffer(
         bgfx::copy(m_Indices.data(), static_cast<u32>(m_Indices.size())), flags);
 
+    CreatePositionBuffer();
+
     return bgfx::isValid(m_VertexBuffer) && bgfx::isValid(m_IndexBuffer);
 }
 
+void Mesh::CreatePositionBuffer()
+{
+    DestroyPositionBuffer();
+    if (!m_PositionStreamEnabled || m_Layout == nullptr ||
+        !m_Layout->has(bgfx::Attrib::Position))
+        return;
+
+    // Same encoding as the interleaved position, so the shader decode
+    // (u_meshDecode) applies unchanged.
+    u8 num = 0;
+    bgfx::AttribType::Enum type = bgfx::AttribType::Float;
+    bool normalized = false, asInt = false;
+    m_Layout->decode(bgfx::Attrib::Position, num, type, normalized, asInt);
+    m_PositionLayout.begin().add(bgfx::Attrib::Position, num, type, normalized, asInt).end();
+
+    const u32 stride = m_Layout->getStride();
+    const u32 positionStride = m_PositionLayout.getStride();
+    const u32 offset = m_Layout->getOffset(bgfx::Attrib::Position);
+    const u32 vertexCount = VertexCount();
+    // A position-only layout already is the stream.
+    if (positionStride >= stride || vertexCount == 0 || offset + positionStride > stride)
+        return;
+
+    const bgfx::Memory* memory = bgfx::alloc(vertexCount * positionStride);
+    for (u32 v = 0; v < vertexCount; ++v)
+        std::memcpy(memory->data + static_cast<size_t>(v) * positionStride,
+                    m_Vertices.data() + static_cast<size_t>(v) * stride + offset, positionStride);
+    m_PositionBuffer = bgfx::createVertexBuffer(memory, m_PositionLayout);
+}
+
+void Mesh::DestroyPositionBuffer()
+{
+    if (bgfx::isValid(m_PositionBuffer)) {
+        bgfx::destroy(m_PositionBuffer);
+        m_PositionBuffer = BGFX_INVALID_HANDLE;
+    }
+}
+
 } // namespace Seraph
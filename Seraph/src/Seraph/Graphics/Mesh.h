@@ -6,7 +6,12 @@
 // each bound to a material slot), and a material-slot count. It owns no material
 // and does not know how to draw itself — binding, material resolution and
 // submission live in the renderer. CPU-side vertex/index bytes are retained so
-// the mesh can be serialized to a .smesh file.
+// the mesh can be serialized to a .smesh file. Object-space bounds (whole mesh +
+// per submesh) are computed once at import/load and drive visibility culling.
+// Optional coarser levels of detail (generated at import, MeshSimplifier) reuse
+// the vertex buffer; their indices follow LOD 0's in the same index buffer.
+// Depth-only passes draw from a second, position-only vertex buffer built at
+// upload.
 //
 
 #pragma once
@@ -15,6 +20,7 @@
 #include "Seraph/Core/Base.h"
 #include "Seraph/Core/Log.h"
 #include "Seraph/Core/Ref.h"
+#include "Seraph/Math/Bounds.h"
 
 #include <bgfx/bgfx.h>
 #include <concepts>
@@ -37,16 +43,40 @@ public:
     ASSET_CLASS_TYPE(Mesh)
 
     // One drawable range within the shared vertex/index buffers, bound to a
-    // material slot. Indices are absolute (they already include BaseVertex),
-    // matching how the importer concatenates sources.
+    // material slot. Its indices (at every LOD) are relative to BaseVertex, which
+    // the renderer passes as the start vertex, so a 16-bit mesh can span more
+    // than 65535 vertices across submeshes (the importer chunks large sources
+    // this way). Bounds is the object-space box of the vertices this range
+    // references (filled by ComputeBounds or the .smesh loader).
     struct Submesh
     {
         u32 BaseVertex = 0;
         u32 BaseIndex = 0;
         u32 IndexCount = 0;
         u32 MaterialSlot = 0;
+        AABB Bounds{};
     };
 
+    // An index range within the shared index buffer.
+    struct IndexRange
+    {
+        u32 BaseIndex = 0;
+        u32 IndexCount = 0;
+    };
+
+    // One coarser level of detail (LOD 1 and up; LOD 0 is the submesh table
+    // itself). Its indices reference the shared vertex buffer; Range spans the
+    // whole level and Submeshes holds one range per submesh (a single entry for
+    // a mesh without a submesh table). Error is the simplifier's geometric
+    // error in object-space units — how far the level strays from LOD 0.
+    struct Lod
+    {
+        float Error = 0.0f;
+        IndexRange Range;
+        std::vector<IndexRange> Submeshes;
+    };
+    static constexpr u32 c_MaxLods = 4; // LOD 0 included
+
     Mesh() = default;
     ~Mesh() override;
 
@@ -79,6 +109,17 @@ public:
     bool Upload();
 
     void SetSubmeshes(std::vector<Submesh> submeshes) { m_Submeshes = std::move(submeshes); }
+
+    // Depth-only passes (the shadow cascades) read positions alone. With
+    // the position stream on (the default), creating the GPU buffers also
+    // builds a position-only vertex buffer for them, so they fetch the position
+    // (8 or 12 bytes) rather than the whole interleaved vertex. It is derived
+    // from the vertex data and never serialized. Set before upload.
+    void SetPositionStream(bool enabled) { m_PositionStreamEnabled = enabled; }
+
+    // Levels 1.. (at most c_MaxLods - 1, ascending error). Their index ranges
+    // must already be in the index data, after LOD 0's.
+    void SetLods(std::vector<Lod> lods) { m_Lods = std::move(lods); }
     void SetMaterialSlotCount(u32 count) { m_MaterialSlotCount = count; }
 
     // Per-slot default material handles baked into the mesh (index == slot).
@@ -94,9 +135,54 @@ public:
                                                     : AssetHandle(c_NullAssetHandle);
     }
 
+    // Recompute the mesh + per-submesh object-space bounds from the retained CPU
+    // geometry (positions decoded through the layout, so any position format
+    // works). Call after the vertex/index data and submeshes are set; Upload()
+    // does it as a fallback if nothing has set bounds yet.
+    void ComputeBounds();
+
+    // Set precomputed bounds (e.g. read from a .smesh v3 file). Per-submesh
+    // boxes live on the Submesh entries; this sets the whole-mesh box.
+    void SetBounds(const AABB& bounds);
+
+    // Quantized layouts (MeshVertexFormat::Quantized) store positions in
+    // [-1, 1]; object space is position * scale + offset. The renderer passes
+    // this to the vertex shader (u_meshDecode) and VertexPosition applies it.
+    // Identity for float positions.
+    void SetPositionDecode(const glm::vec3& scale, const glm::vec3& offset)
+    {
+        m_PositionScale = scale;
+        m_PositionOffset = offset;
+    }
+    [[nodiscard]] const glm::vec3& PositionScale() const { return m_PositionScale; }
+    [[nodiscard]] const glm::vec3& PositionOffset() const { return m_PositionOffset; }
+
+    // True when the layout carries octahedral-encoded normals/tangents (a
+    // two-component normal attribute), which the vertex shader must decode.
+    [[nodiscard]] bool HasOctahedralNormals() const;
+
+    // Object-space position of `vertex` from the retained CPU geometry, through
+    // the layout (any attribute type) and the position decode.
+    [[nodiscard]] glm::vec3 VertexPosition(u32 vertex) const;
+
+    // Exact object-space queries against the retained CPU geometry at LOD 0,
+    // both faces of every triangle (editor picking). RayCast writes the nearest
+    // hit's t along origin + t * direction, t in [0, maxT]; false on a miss.
+    // Submeshes whose bounds the ray or frustum misses are skipped.
+    bool RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxT,
+                 float& t) const;
+    // True when some triangle reaches inside `frustum` (object-space planes).
+    [[nodiscard]] bool Intersects(const Frustum& frustum) const;
+
     // --- Accessors --------------------------------------------------------
     [[nodiscard]] const bgfx::VertexLayout* Layout() const { return m_Layout; }
     [[nodiscard]] bgfx::VertexBufferHandle VertexBuffer() const { return m_VertexBuffer; }
+    // Buffer for depth-only draws: the position stream, or the interleaved
+    // buffer when there is none (stream off, or a position-only layout).
+    [[nodiscard]] bgfx::VertexBufferHandle DepthVertexBuffer() const
+    {
+        return bgfx::isValid(m_PositionBuffer) ? m_PositionBuffer : m_VertexBuffer;
+    }
     [[nodiscard]] bgfx::IndexBufferHandle IndexBuffer() const { return m_IndexBuffer; }
     [[nodiscard]] const std::vector<Submesh>& Submeshes() const { return m_Submeshes; }
     [[nodiscard]] u32 MaterialSlotCount() const { return m_MaterialSlotCount; }
@@ -106,6 +192,39 @@ public:
     }
     [[nodiscard]] u32 IndexSize() const { return m_IndexSize; }
 
+    // Level-of-detail queries. LodCount() is always >= 1; LOD 0 has error 0.
+    [[nodiscard]] const std::vector<Lod>& Lods() const { return m_Lods; }
+    [[nodiscard]] u32 LodCount() const { return 1 + static_cast<u32>(m_Lods.size()); }
+    [[nodiscard]] float LodError(u32 lod) const
+    {
+        return lod == 0 || lod > m_Lods.size() ? 0.0f : m_Lods[lod - 1].Error;
+    }
+    // Whole-level index range (every submesh), e.g. for depth-only draws of a
+    // mesh without submesh base vertices.
+    [[nodiscard]] IndexRange LevelRange(u32 lod) const;
+    // Index range of `submesh` at `lod` (clamped to the coarsest level). A mesh
+    // with no submesh table is one implicit submesh 0. False if out of range.
+    bool SubmeshRange(u32 submesh, u32 lod, u32& firstIndex, u32& indexCount) const;
+    // Start vertex of `submesh`'s indices (0 without a submesh table).
+    [[nodiscard]] u32 SubmeshBaseVertex(u32 submesh) const
+    {
+        return submesh < m_Submeshes.size() ? m_Submeshes[submesh].BaseVertex : 0;
+    }
+    // True when some submesh has its own BaseVertex: a whole level then can't be
+    // drawn as the single LevelRange and needs one draw per submesh.
+    [[nodiscard]] bool HasSubmeshBaseVertices() const
+    {
+        for (const Submesh& submesh : m_Submeshes)
+            if (submesh.BaseVertex != 0)
+                return true;
+        return false;
+    }
+
+    // Object-space bounds of the whole mesh (union of its submeshes) and the
+    // sphere enclosing it. Invalid (empty) until computed or loaded.
+    [[nodiscard]] const AABB& Bounds() const { return m_Bounds; }
+    [[nodiscard]] const BoundingSphere& Sphere() const { return m_Sphere; }
+
     // CPU-side geometry, retained for serialization.
     [[nodiscard]] const std::vector<u8>& VertexData() const { return m_Vertices; }
     [[nodiscard]] const std::vector<u8>& IndexData() const { return m_Indices; }
@@ -120,10 +239,14 @@ public:
     }
 
     // Retained CPU geometry (kept after upload for serialization); the GPU
-    // buffers mirror it, so this is a reasonable footprint estimate.
+    // buffers mirror it, plus the position stream, so this is a reasonable
+    // footprint estimate.
     [[nodiscard]] u64 GetMemoryFootprint() const override
     {
-        return static_cast<u64>(m_Vertices.size()) + m_Indices.size();
+        const u64 positionStream = bgfx::isValid(m_PositionBuffer)
+            ? static_cast<u64>(VertexCount()) * m_PositionLayout.getStride()
+            : 0;
+        return static_cast<u64>(m_Vertices.size()) + m_Indices.size() + positionStream;
     }
 
     // The mesh's baked per-slot default materials.
@@ -138,12 +261,17 @@ public:
 
 private:
     bool CreateBuffers();
+    void CreatePositionBuffer();
+    void DestroyPositionBuffer();
 
     const bgfx::VertexLayout* m_Layout = nullptr;
     bgfx::VertexLayout m_OwnedLayout{}; // used when a runtime layout is set
 
     bgfx::VertexBufferHandle m_VertexBuffer{bgfx::kInvalidHandle};
     bgfx::IndexBufferHandle m_IndexBuffer{bgfx::kInvalidHandle};
+    bgfx::VertexBufferHandle m_PositionBuffer{bgfx::kInvalidHandle};
+    bgfx::VertexLayout m_PositionLayout{};
+    bool m_PositionStreamEnabled = true;
 
     // Retained CPU geometry — kept after upload so the mesh can be serialized.
     std::vector<u8> m_Vertices;
@@ -151,9 +279,15 @@ private:
     u32 m_IndexSize = sizeof(u16); // bytes per index (2 or 4)
 
     std::vector<Submesh> m_Submeshes;
+    std::vector<Lod> m_Lods; // levels 1..; empty = LOD 0 only
     u32 m_MaterialSlotCount = 1;
     std::vector<AssetHandle> m_MaterialSlotDefaults; // index == slot; may be empty
 
+    AABB m_Bounds{};
+    BoundingSphere m_Sphere{};
+    glm::vec3 m_PositionScale{1.0f};
+    glm::vec3 m_PositionOffset{0.0f};
+
     std::string m_Name = "NoName";
 };
 
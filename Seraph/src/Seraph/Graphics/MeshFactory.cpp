@@ -140,6 +140,7 @@ Ref<Mesh> MeshFactory::CreateCube(const CubeParams& params)
     constexpr u32 indexCount = sizeof(s_CubeIndices) / sizeof(s_CubeIndices[0]);
     mesh->SetSubmeshes({Mesh::Submesh{0, 0, indexCount, 0}});
     mesh->SetMaterialSlotCount(1);
+    mesh->ComputeBounds();
     return mesh;
 }
 
@@ -184,6 +185,7 @@ Ref<Mesh> MeshFactory::CreatePlane(const PlaneParams& params)
     constexpr u32 indexCount = sizeof(s_PlaneIndices) / sizeof(s_PlaneIndices[0]);
     mesh->SetSubmeshes({Mesh::Submesh{0, 0, indexCount, 0}});
     mesh->SetMaterialSlotCount(1);
+    mesh->ComputeBounds();
     return mesh;
 }
 
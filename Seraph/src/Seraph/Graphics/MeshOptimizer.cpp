@@ -0,0 +1,482 @@
+//
+// Created by ruben on 2026/10/17.
+//
+
+#include "MeshOptimizer.h"
+
+#include "Mesh.h"
+#include "Seraph/Core/Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Seraph
+{
+
+namespace
+{
+
+constexpr u32 c_Unmapped = ~0u;
+
+// Smallest vertex range [First, First + Count) covering a list, so per-vertex
+// scratch is sized to one submesh rather than the whole mesh.
+struct IndexSpan
+{
+    u32 First = 0;
+    u32 Count = 0;
+};
+
+IndexSpan SpanOf(const std::vector<u32>& indices)
+{
+    if (indices.empty())
+        return {};
+    const auto [lo, hi] = std::minmax_element(indices.begin(), indices.end());
+    return {*lo, *hi - *lo + 1};
+}
+
+// FIFO post-transform cache, simulated with per-vertex load times: a vertex is
+// resident while fewer than Size misses happened since it was loaded.
+struct FifoCache
+{
+    std::vector<u32> LoadTime;
+    u32 Time;
+    u32 Size;
+
+    FifoCache(const u32 vertexCount, const u32 size)
+        : LoadTime(vertexCount, 0), Time(size + 1), Size(size)
+    {
+    }
+
+    // True on a miss (the vertex is transformed and loaded).
+    bool Touch(const u32 vertex)
+    {
+        if (Time - LoadTime[vertex] <= Size)
+            return false;
+        LoadTime[vertex] = Time++;
+        return true;
+    }
+
+    void Flush() { Time += Size + 1; }
+};
+
+// ---- Forsyth vertex cache scoring -------------------------------------------
+// Tom Forsyth, "Linear-Speed Vertex Cache Optimisation". A vertex scores for
+// sitting in the (LRU) cache, the last triangle's three a flat amount and the
+// rest decaying with position, plus a boost for having few triangles left, so
+// the last triangles around a vertex are finished rather than stranded.
+constexpr u32 c_ScoreCacheSize = 32;
+constexpr float c_CacheDecayPower = 1.5f;
+constexpr float c_LastTriangleScore = 0.75f;
+constexpr float c_ValenceBoostScale = 2.0f;
+constexpr float c_ValenceBoostPower = 0.5f;
+
+float VertexScore(const s32 cachePosition, const u32 remainingTriangles)
+{
+    if (remainingTriangles == 0)
+        return -1.0f; // nothing left to pull in
+    float score = 0.0f;
+    if (cachePosition >= 0 && cachePosition < 3) {
+        score = c_LastTriangleScore;
+    } else if (cachePosition >= 3) {
+        const float scale = 1.0f / static_cast<float>(c_ScoreCacheSize - 3);
+        score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, c_CacheDecayPower);
+    }
+    return score + c_ValenceBoostScale *
+                       std::pow(static_cast<float>(remainingTriangles), -c_ValenceBoostPower);
+}
+
+std::vector<u32> ReadIndices(const Mesh& mesh)
+{
+    const u32 count = mesh.IndexCount();
+    const u8* data = mesh.IndexData().data();
+    std::vector<u32> indices(count);
+    for (u32 i = 0; i < count; ++i) {
+        if (mesh.IndexSize() == sizeof(u32)) {
+            std::memcpy(&indices[i], data + static_cast<size_t>(i) * sizeof(u32), sizeof(u32));
+        } else {
+            u16 v;
+            std::memcpy(&v, data + static_cast<size_t>(i) * sizeof(u16), sizeof(u16));
+            indices[i] = v;
+        }
+    }
+    return indices;
+}
+
+} // namespace
+
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<u32>& indices,
+                                                   const u32 cacheSize)
+{
+    VertexCacheStats stats;
+    stats.Triangles = static_cast<u32>(indices.size() / 3);
+    const IndexSpan span = SpanOf(indices);
+    FifoCache cache(span.Count, std::max(cacheSize, 3u));
+    std::vector<u8> seen(span.Count, 0);
+    for (u32 i = 0; i < stats.Triangles * 3; ++i) {
+        const u32 v = indices[i] - span.First;
+        stats.Transforms += cache.Touch(v) ? 1 : 0;
+        if (seen[v] == 0) {
+            seen[v] = 1;
+            ++stats.Vertices;
+        }
+    }
+    return stats;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<u32>& indices)
+{
+    const auto triangleCount = static_cast<u32>(indices.size() / 3);
+    if (triangleCount < 2)
+        return;
+    const IndexSpan span = SpanOf(indices);
+    const auto vertexOf = [&](const u32 triangle, const u32 corner) {
+        return indices[triangle * 3 + corner] - span.First;
+    };
+
+    // Vertex -> triangle adjacency. remaining[v] counts v's triangles not yet
+    // emitted; they are kept at the front of its list.
+    std::vector<u32> remaining(span.Count, 0);
+    for (u32 t = 0; t < triangleCount; ++t)
+        for (u32 k = 0; k < 3; ++k)
+            ++remaining[vertexOf(t, k)];
+    std::vector<u32> offsets(span.Count + 1, 0);
+    for (u32 v = 0; v < span.Count; ++v)
+        offsets[v + 1] = offsets[v] + remaining[v];
+    std::vector<u32> adjacency(offsets.back());
+    {
+        std::vector<u32> fill(offsets.begin(), offsets.end() - 1);
+        for (u32 t = 0; t < triangleCount; ++t)
+            for (u32 k = 0; k < 3; ++k)
+                adjacency[fill[vertexOf(t, k)]++] = t;
+    }
+
+    std::vector<s32> cachePosition(span.Count, -1);
+    std::vector<float> vertexScore(span.Count);
+    for (u32 v = 0; v < span.Count; ++v)
+        vertexScore[v] = VertexScore(-1, remaining[v]);
+    const auto scoreTriangle = [&](const u32 t) {
+        return vertexScore[vertexOf(t, 0)] + vertexScore[vertexOf(t, 1)] +
+               vertexScore[vertexOf(t, 2)];
+    };
+
+    std::vector<u8> emitted(triangleCount, 0);
+    u32 best = 0;
+    float bestScore = scoreTriangle(0);
+    for (u32 t = 1; t < triangleCount; ++t) {
+        if (const float score = scoreTriangle(t); score > bestScore) {
+            best = t;
+            bestScore = score;
+        }
+    }
+
+    std::vector<u32> output;
+    output.reserve(static_cast<size_t>(triangleCount) * 3);
+    std::vector<u32> cache, nextCache;
+    cache.reserve(c_ScoreCacheSize + 3);
+    nextCache.reserve(c_ScoreCacheSize + 3);
+    u32 cursor = 0; // dead ends restart from the next unemitted input triangle
+    for (u32 n = 0; n < triangleCount; ++n) {
+        if (best == c_Unmapped) {
+            while (emitted[cursor] != 0)
+                ++cursor;
+            best = cursor;
+        }
+        emitted[best] = 1;
+        const u32 tri[3] = {vertexOf(best, 0), vertexOf(best, 1), vertexOf(best, 2)};
+        for (u32 k = 0; k < 3; ++k) {
+            output.push_back(indices[best * 3 + k]);
+            // Retire the triangle from the vertex's list (swap to the back).
+            u32* list = adjacency.data() + offsets[tri[k]];
+            for (u32 j = 0; j < remaining[tri[k]]; ++j) {
+                if (list[j] == best) {
+                    std::swap(list[j], list[remaining[tri[k]] - 1]);
+                    --remaining[tri[k]];
+                    break;
+                }
+            }
+        }
+
+        // LRU: the triangle's vertices move to the front, the rest shift back;
+        // whatever falls past the end is evicted.
+        nextCache.clear();
+        for (const u32 v : tri)
+            if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end())
+                nextCache.push_back(v);
+        for (const u32 v : cache)
+            if (v != tri[0] && v != tri[1] && v != tri[2])
+                nextCache.push_back(v);
+        for (u32 i = 0; i < nextCache.size(); ++i) {
+            const u32 v = nextCache[i];
+            cachePosition[v] = i < c_ScoreCacheSize ? static_cast<s32>(i) : -1;
+            vertexScore[v] = VertexScore(cachePosition[v], remaining[v]);
+        }
+
+        // Only triangles around the touched vertices changed score; the best
+        // of them goes next.
+        best = c_Unmapped;
+        bestScore = -std::numeric_limits<float>::max();
+        for (const u32 v : nextCache) {
+            for (u32 j = 0; j < remaining[v]; ++j) {
+                const u32 t = adjacency[offsets[v] + j];
+                if (const float score = scoreTriangle(t); score > bestScore) {
+                    best = t;
+                    bestScore = score;
+                }
+            }
+        }
+        nextCache.resize(std::min<size_t>(nextCache.size(), c_ScoreCacheSize));
+        std::swap(cache, nextCache);
+    }
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void MeshOptimizer::OptimizeOverdraw(std::vector<u32>& indices,
+                                     const std::vector<glm::vec3>& positions,
+                                     const float threshold)
+{
+    const auto triangleCount = static_cast<u32>(indices.size() / 3);
+    if (triangleCount < 2)
+        return;
+    const IndexSpan span = SpanOf(indices);
+    if (static_cast<size_t>(span.First) + span.Count > positions.size())
+        return;
+
+    FifoCache cache(span.Count, c_CacheSize);
+    const auto misses = [&](const u32 t) {
+        u32 count = 0;
+        for (u32 k = 0; k < 3; ++k)
+            count += cache.Touch(indices[t * 3 + k] - span.First) ? 1 : 0;
+        return count;
+    };
+
+    // Hard boundaries: a triangle whose three vertices all miss starts a patch
+    // that shares nothing recent with the one before it.
+    std::vector<u32> patches;
+    for (u32 t = 0; t < triangleCount; ++t)
+        if (misses(t) == 3 || t == 0)
+            patches.push_back(t);
+    patches.push_back(triangleCount);
+
+    // Soft boundaries: cut each patch again wherever the run so far is within
+    // `threshold` of the patch's own ACMR, so reordering the pieces costs at
+    // most that much cache efficiency.
+    std::vector<u32> clusters;
+    for (size_t p = 0; p + 1 < patches.size(); ++p) {
+        const u32 start = patches[p];
+        const u32 end = patches[p + 1];
+        cache.Flush();
+        u32 patchMisses = 0;
+        for (u32 t = start; t < end; ++t)
+            patchMisses += misses(t);
+        const float target =
+            threshold * static_cast<float>(patchMisses) / static_cast<float>(end - start);
+
+        cache.Flush();
+        clusters.push_back(start);
+        u32 runMisses = 0, runTriangles = 0;
+        for (u32 t = start; t < end; ++t) {
+            runMisses += misses(t);
+            ++runTriangles;
+            if (static_cast<float>(runMisses) <= target * static_cast<float>(runTriangles)) {
+                clusters.push_back(t + 1);
+                cache.Flush();
+                runMisses = runTriangles = 0;
+            }
+        }
+        if (clusters.back() == end)
+            clusters.pop_back(); // the next patch opens with the same triangle
+    }
+    clusters.push_back(triangleCount);
+    if (clusters.size() <= 2)
+        return;
+
+    // Area-weighted centroid and normal per cluster. Sorting by how far a
+    // cluster faces out from the mesh centre draws outer surfaces (the likely
+    // occluders) first, from any view.
+    struct Cluster
+    {
+        u32 Start = 0;
+        u32 End = 0;
+        glm::dvec3 Centroid{0.0};
+        glm::dvec3 Normal{0.0};
+        double Area = 0.0;
+        double Key = 0.0;
+    };
+    std::vector<Cluster> sorted(clusters.size() - 1);
+    glm::dvec3 meshCentroid(0.0);
+    double meshArea = 0.0;
+    for (size_t c = 0; c < sorted.size(); ++c) {
+        Cluster& cluster = sorted[c];
+        cluster.Start = clusters[c];
+        cluster.End = clusters[c + 1];
+        for (u32 t = cluster.Start; t < cluster.End; ++t) {
+            const glm::dvec3 p0 = positions[indices[t * 3 + 0]];
+            const glm::dvec3 p1 = positions[indices[t * 3 + 1]];
+            const glm::dvec3 p2 = positions[indices[t * 3 + 2]];
+            const glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+            const double area = glm::length(normal);
+            cluster.Centroid += (p0 + p1 + p2) * (area / 3.0);
+            cluster.Normal += normal;
+            cluster.Area += area;
+        }
+        meshCentroid += cluster.Centroid;
+        meshArea += cluster.Area;
+    }
+    if (meshArea <= 0.0)
+        return;
+    meshCentroid /= meshArea;
+    for (Cluster& cluster : sorted) {
+        const double length = glm::length(cluster.Normal);
+        if (cluster.Area > 0.0 && length > 0.0)
+            cluster.Key = glm::dot(cluster.Centroid / cluster.Area - meshCentroid,
+                                   cluster.Normal / length);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.Key > b.Key; });
+
+    std::vector<u32> output;
+    output.reserve(static_cast<size_t>(triangleCount) * 3);
+    for (const Cluster& cluster : sorted)
+        output.insert(output.end(), indices.begin() + cluster.Start * 3,
+                      indices.begin() + cluster.End * 3);
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+std::vector<u32> MeshOptimizer::OptimizeVertexFetch(std::vector<u32>& indices,
+                                                    const u32 vertexCount)
+{
+    std::vector<u32> remap(vertexCount, c_Unmapped);
+    u32 next = 0;
+    for (u32& index : indices) {
+        if (remap[index] == c_Unmapped)
+            remap[index] = next++;
+        index = remap[index];
+    }
+    return remap;
+}
+
+MeshOptimizeResult MeshOptimizer::Optimize(Mesh& mesh)
+{
+    MeshOptimizeResult result;
+    const bgfx::VertexLayout* layout = mesh.Layout();
+    if (layout == nullptr || !layout->has(bgfx::Attrib::Position) ||
+        mesh.VertexData().empty() || mesh.IndexData().empty())
+        return result;
+
+    // Each submesh's ranges at every level (one implicit submesh without a
+    // table). Indices are relative to the submesh's BaseVertex; the passes work
+    // in absolute vertex numbers.
+    struct Group
+    {
+        u32 BaseVertex = 0;
+        std::vector<Mesh::IndexRange> Ranges; // [0] is LOD 0
+    };
+    const u32 submeshCount =
+        mesh.Submeshes().empty() ? 1 : static_cast<u32>(mesh.Submeshes().size());
+    std::vector<Group> groups(submeshCount);
+    for (u32 s = 0; s < submeshCount; ++s) {
+        groups[s].BaseVertex = mesh.SubmeshBaseVertex(s);
+        for (u32 lod = 0; lod < mesh.LodCount(); ++lod) {
+            Mesh::IndexRange range;
+            if (mesh.SubmeshRange(s, lod, range.BaseIndex, range.IndexCount))
+                groups[s].Ranges.push_back(range);
+        }
+    }
+
+    const u32 vertexCount = mesh.VertexCount();
+    std::vector<u32> indices = ReadIndices(mesh);
+    for (const Group& group : groups) {
+        for (const Mesh::IndexRange& range : group.Ranges) {
+            if (static_cast<u64>(range.BaseIndex) + range.IndexCount > indices.size())
+                return result; // malformed; leave it for the loader's checks
+            for (u32 i = range.BaseIndex; i < range.BaseIndex + range.IndexCount; ++i) {
+                indices[i] += group.BaseVertex;
+                if (indices[i] >= vertexCount)
+                    return result;
+            }
+        }
+    }
+
+    std::vector<glm::vec3> positions(vertexCount);
+    for (u32 v = 0; v < vertexCount; ++v)
+        positions[v] = mesh.VertexPosition(v);
+
+    // Cache + overdraw, per submesh of LOD 0 (each is its own draw).
+    for (const Group& group : groups) {
+        if (group.Ranges.empty())
+            continue;
+        const Mesh::IndexRange& range = group.Ranges.front();
+        std::vector<u32> list(indices.begin() + range.BaseIndex,
+                              indices.begin() + range.BaseIndex + range.IndexCount);
+        result.Before += AnalyzeVertexCache(list);
+        OptimizeVertexCache(list);
+        OptimizeOverdraw(list, positions);
+        result.After += AnalyzeVertexCache(list);
+        std::copy(list.begin(), list.end(), indices.begin() + range.BaseIndex);
+    }
+
+    // Fetch order over everything, coarser levels included, so the vertex
+    // buffer is read front to back by LOD 0.
+    const std::vector<u32> remap = OptimizeVertexFetch(indices, vertexCount);
+
+    // Imported submeshes don't share vertices, so each still owns a contiguous
+    // run after the remap; BaseVertex moves to its start and the indices are
+    // made relative again.
+    const u32 maxRelative =
+        mesh.IndexSize() == sizeof(u32) ? std::numeric_limits<u32>::max()
+                                        : std::numeric_limits<u16>::max();
+    std::vector<u32> baseVertices(submeshCount, 0);
+    for (u32 s = 0; s < submeshCount; ++s) {
+        const Group& group = groups[s];
+        if (mesh.Submeshes().empty() || group.Ranges.empty())
+            continue;
+        const Mesh::IndexRange& lod0 = group.Ranges.front();
+        if (lod0.IndexCount > 0)
+            baseVertices[s] = *std::min_element(indices.begin() + lod0.BaseIndex,
+                                                indices.begin() + lod0.BaseIndex + lod0.IndexCount);
+        for (const Mesh::IndexRange& range : group.Ranges) {
+            for (u32 i = range.BaseIndex; i < range.BaseIndex + range.IndexCount; ++i) {
+                if (indices[i] < baseVertices[s] || indices[i] - baseVertices[s] > maxRelative) {
+                    SP_CORE_WARN_TAG("Mesh", "Optimize: '{}' has submeshes sharing vertices; "
+                                     "left unoptimized", mesh.Name());
+                    return {};
+                }
+                indices[i] -= baseVertices[s];
+            }
+        }
+    }
+
+    const u32 stride = layout->getStride();
+    std::vector<u8> vertices(mesh.VertexData().size());
+    u32 remapped = 0;
+    for (u32 v = 0; v < vertexCount; ++v) {
+        if (remap[v] == c_Unmapped)
+            continue;
+        std::memcpy(vertices.data() + static_cast<size_t>(remap[v]) * stride,
+                    mesh.VertexData().data() + static_cast<size_t>(v) * stride, stride);
+        ++remapped;
+    }
+    vertices.resize(static_cast<size_t>(remapped) * stride);
+
+    if (!mesh.Submeshes().empty()) {
+        std::vector<Mesh::Submesh> submeshes = mesh.Submeshes();
+        for (u32 s = 0; s < submeshCount; ++s)
+            submeshes[s].BaseVertex = baseVertices[s];
+        mesh.SetSubmeshes(std::move(submeshes));
+    }
+
+    mesh.StageVertexData(vertices.data(), static_cast<u32>(vertices.size()));
+    if (mesh.IndexSize() == sizeof(u32)) {
+        mesh.StageIndexData(indices.data(), static_cast<u32>(indices.size() * sizeof(u32)),
+                            sizeof(u32));
+    } else {
+        std::vector<u16> narrow(indices.begin(), indices.end());
+        mesh.StageIndexData(narrow.data(), static_cast<u32>(narrow.size() * sizeof(u16)),
+                            sizeof(u16));
+    }
+    return result;
+}
+
+} // namespace Seraph
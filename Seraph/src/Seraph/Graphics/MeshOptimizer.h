@@ -0,0 +1,100 @@
+//
+// Import-time index/vertex reordering for GPU efficiency. Optimize runs three
+// passes over a mesh's retained CPU geometry, each per submesh:
+//   1. vertex cache: triangles are reordered (Forsyth's greedy scoring) so
+//      consecutive triangles reuse recently transformed vertices;
+//   2. overdraw: the cache-ordered list is cut into clusters that each keep
+//      close to its ACMR, and the clusters are sorted outward-facing first
+//      (Sander et al., "Fast Triangle Reordering for Vertex Locality and
+//      Reduced Overdraw"), so front surfaces tend to be drawn before the ones
+//      they hide, from any view;
+//   3. vertex fetch: vertices are renumbered in first-use order, so the vertex
+//      buffer is read front to back (unreferenced vertices are dropped).
+// Only the order changes; the triangles drawn and their winding stay the same.
+//
+
+#pragma once
+
+#include "Seraph/Core/Base.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Seraph
+{
+
+class Mesh;
+
+// Post-transform vertex cache behaviour of an index list, simulated as a FIFO
+// of MeshOptimizer::c_CacheSize entries. ACMR (average cache miss ratio) is
+// vertex shader invocations per triangle: 0.5 is the ideal for a large
+// regular grid, 3 the worst. ATVR (average transform to vertex ratio) is
+// invocations per distinct vertex: 1 is ideal.
+struct VertexCacheStats
+{
+    u32 Triangles = 0;
+    u32 Vertices = 0;   // distinct vertices referenced
+    u32 Transforms = 0; // cache misses
+
+    [[nodiscard]] float Acmr() const
+    {
+        return Triangles != 0 ? static_cast<float>(Transforms) / static_cast<float>(Triangles)
+                              : 0.0f;
+    }
+    [[nodiscard]] float Atvr() const
+    {
+        return Vertices != 0 ? static_cast<float>(Transforms) / static_cast<float>(Vertices)
+                             : 0.0f;
+    }
+
+    VertexCacheStats& operator+=(const VertexCacheStats& other)
+    {
+        Triangles += other.Triangles;
+        Vertices += other.Vertices;
+        Transforms += other.Transforms;
+        return *this;
+    }
+};
+
+// LOD 0's cache behaviour before and after MeshOptimizer::Optimize, summed over
+// its submeshes (each one a separate draw with a cold cache).
+struct MeshOptimizeResult
+{
+    VertexCacheStats Before;
+    VertexCacheStats After;
+};
+
+class MeshOptimizer
+{
+public:
+    static constexpr u32 c_CacheSize = 16;
+
+    // Simulate the vertex cache over the triangle list `indices`.
+    static VertexCacheStats AnalyzeVertexCache(const std::vector<u32>& indices,
+                                               u32 cacheSize = c_CacheSize);
+
+    // Reorder the triangles of `indices` for vertex cache reuse.
+    static void OptimizeVertexCache(std::vector<u32>& indices);
+
+    // Reorder the clusters of a cache-optimized list to reduce overdraw.
+    // `threshold` is how much worse than the input's ACMR a cluster may get
+    // (1.05 = 5%); larger values give smaller clusters that sort better.
+    static void OptimizeOverdraw(std::vector<u32>& indices,
+                                 const std::vector<glm::vec3>& positions,
+                                 float threshold = 1.05f);
+
+    // Renumber the vertices referenced by `indices` in first-use order,
+    // rewriting `indices`. Returns the old -> new remap (~0u for vertices no
+    // index references); the new vertex count is the number of mapped entries.
+    static std::vector<u32> OptimizeVertexFetch(std::vector<u32>& indices, u32 vertexCount);
+
+    // Run the three passes over `mesh`: cache and overdraw on each submesh of
+    // LOD 0, then fetch order over the whole index data (any LOD levels are
+    // remapped along). Re-stages the vertex and index data, so call it before
+    // Upload, and before MeshSimplifier::GenerateLods so the levels inherit
+    // the vertex order.
+    static MeshOptimizeResult Optimize(Mesh& mesh);
+};
+
+} // namespace Seraph
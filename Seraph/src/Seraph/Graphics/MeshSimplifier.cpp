@@ -0,0 +1,420 @@
+//
+// Created by ruben on 2026/10/17.
+//
+
+#include "MeshSimplifier.h"
+
+#include "MeshOptimizer.h"
+#include "Seraph/Core/Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Seraph
+{
+
+namespace
+{
+
+// Symmetric 4x4 error quadric (Garland & Heckbert) as its upper triangle
+// a2 ab ac ad b2 bc bd c2 cd d2, plus the summed plane weight (triangle area).
+struct Quadric
+{
+    double M[10] = {};
+    double Weight = 0.0;
+
+    void AddPlane(const glm::dvec3& n, const double d, const double w)
+    {
+        M[0] += w * n.x * n.x;
+        M[1] += w * n.x * n.y;
+        M[2] += w * n.x * n.z;
+        M[3] += w * n.x * d;
+        M[4] += w * n.y * n.y;
+        M[5] += w * n.y * n.z;
+        M[6] += w * n.y * d;
+        M[7] += w * n.z * n.z;
+        M[8] += w * n.z * d;
+        M[9] += w * d * d;
+        Weight += w;
+    }
+
+    Quadric& operator+=(const Quadric& other)
+    {
+        for (int i = 0; i < 10; ++i)
+            M[i] += other.M[i];
+        Weight += other.Weight;
+        return *this;
+    }
+
+    // Area-weighted sum of squared distances from `p` to the planes.
+    [[nodiscard]] double Evaluate(const glm::dvec3& p) const
+    {
+        const double x = p.x, y = p.y, z = p.z;
+        return M[0] * x * x + 2.0 * M[1] * x * y + 2.0 * M[2] * x * z + 2.0 * M[3] * x +
+               M[4] * y * y + 2.0 * M[5] * y * z + 2.0 * M[6] * y +
+               M[7] * z * z + 2.0 * M[8] * z + M[9];
+    }
+};
+
+// Candidate collapse: vertex From merges into To.
+struct Collapse
+{
+    u32 From;
+    u32 To;
+    double Cost; // mean squared distance to the merged planes
+};
+
+void RemoveDegenerates(std::vector<u32>& indices)
+{
+    size_t write = 0;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const u32 a = indices[i], b = indices[i + 1], c = indices[i + 2];
+        if (a == b || b == c || a == c)
+            continue;
+        indices[write++] = a;
+        indices[write++] = b;
+        indices[write++] = c;
+    }
+    indices.resize(write);
+}
+
+// Vertices that must not move: any vertex sharing its position with another
+// (attribute seam), and both ends of every edge used by one triangle (open
+// border) or more than two (non-manifold). Edges are compared by position, so
+// the two sides of a seam count as one edge. `indices` are below `vertexCount`.
+std::vector<u8> FindLockedVertices(const glm::vec3* positions, const u32 vertexCount,
+                                   const std::vector<u32>& indices)
+{
+    std::vector<u8> locked(vertexCount, 0);
+
+    std::vector<u32> used(indices);
+    std::sort(used.begin(), used.end());
+    used.erase(std::unique(used.begin(), used.end()), used.end());
+
+    const auto lessPosition = [&](u32 a, u32 b) {
+        const glm::vec3& pa = positions[a];
+        const glm::vec3& pb = positions[b];
+        if (pa.x != pb.x)
+            return pa.x < pb.x;
+        if (pa.y != pb.y)
+            return pa.y < pb.y;
+        return pa.z < pb.z;
+    };
+    std::sort(used.begin(), used.end(), lessPosition);
+
+    std::vector<u32> weld(vertexCount);
+    for (size_t begin = 0; begin < used.size();) {
+        size_t end = begin + 1;
+        while (end < used.size() && positions[used[end]] == positions[used[begin]])
+            ++end;
+        for (size_t i = begin; i < end; ++i) {
+            weld[used[i]] = used[begin];
+            if (end - begin > 1)
+                locked[used[i]] = 1;
+        }
+        begin = end;
+    }
+
+    std::vector<u64> edges;
+    edges.reserve(indices.size());
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        for (int e = 0; e < 3; ++e) {
+            const u32 a = weld[indices[i + e]];
+            const u32 b = weld[indices[i + (e + 1) % 3]];
+            edges.push_back((static_cast<u64>(std::min(a, b)) << 32) | std::max(a, b));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<u8> lockedWeld(vertexCount, 0);
+    for (size_t begin = 0; begin < edges.size();) {
+        size_t end = begin + 1;
+        while (end < edges.size() && edges[end] == edges[begin])
+            ++end;
+        if (end - begin != 2) {
+            lockedWeld[static_cast<u32>(edges[begin] >> 32)] = 1;
+            lockedWeld[static_cast<u32>(edges[begin] & 0xffffffffu)] = 1;
+        }
+        begin = end;
+    }
+    for (const u32 v : used)
+        if (lockedWeld[weld[v]])
+            locked[v] = 1;
+    return locked;
+}
+
+} // namespace
+
+std::vector<u32> MeshSimplifier::Simplify(
+    const std::vector<glm::vec3>& positions, const std::vector<u32>& indices,
+    const u32 targetIndexCount, const float maxError, float* outError)
+{
+    std::vector<u32> result(indices.begin(), indices.begin() + indices.size() / 3 * 3);
+    for (const u32 v : result) {
+        if (v >= positions.size()) {
+            SP_CORE_WARN_TAG("Mesh", "Simplify: index {} out of range, mesh left as is", v);
+            if (outError != nullptr)
+                *outError = 0.0f;
+            return result;
+        }
+    }
+    RemoveDegenerates(result);
+
+    // Work in the list's own vertex range (a submesh's), rebased to 0, so the
+    // per-vertex scratch below is sized to it rather than to the whole mesh.
+    u32 first = 0;
+    u32 vertexCount = 0;
+    if (!result.empty()) {
+        const auto [lo, hi] = std::minmax_element(result.begin(), result.end());
+        first = *lo;
+        vertexCount = *hi - *lo + 1;
+    }
+    for (u32& v : result)
+        v -= first;
+    const glm::vec3* local = positions.data() + first;
+    const std::vector<u8> locked = FindLockedVertices(local, vertexCount, result);
+    const double maxCost = static_cast<double>(maxError) * maxError;
+
+    // Each vertex starts with the planes of the triangles around it.
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0; i < result.size(); i += 3) {
+        const glm::dvec3 p0(local[result[i]]);
+        const glm::dvec3 p1(local[result[i + 1]]);
+        const glm::dvec3 p2(local[result[i + 2]]);
+        glm::dvec3 n = glm::cross(p1 - p0, p2 - p0);
+        const double doubleArea = glm::length(n);
+        if (doubleArea <= 0.0)
+            continue;
+        n /= doubleArea;
+        const double d = -glm::dot(n, p0);
+        for (int k = 0; k < 3; ++k)
+            quadrics[result[i + k]].AddPlane(n, d, doubleArea * 0.5);
+    }
+    const auto collapseCost = [&](u32 from, u32 to) {
+        Quadric q = quadrics[from];
+        q += quadrics[to];
+        return q.Weight > 0.0 ? std::max(q.Evaluate(glm::dvec3(local[to])), 0.0) / q.Weight
+                              : 0.0;
+    };
+
+    std::vector<u32> triangleOffsets(vertexCount + 1);
+    std::vector<u32> vertexTriangles;
+    std::vector<Collapse> candidates;
+    std::vector<u8> touched(vertexCount);
+    std::vector<u32> remap(vertexCount);
+    double worstCost = 0.0;
+
+    // Each pass collapses the cheapest independent edges (no two sharing a
+    // neighbourhood, so the adjacency built at the start of the pass stays valid),
+    // then compacts. Passes repeat until the target or the error limit is hit.
+    while (result.size() > targetIndexCount) {
+        const auto triangleCount = static_cast<u32>(result.size() / 3);
+
+        std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+        for (const u32 v : result)
+            ++triangleOffsets[v + 1];
+        for (u32 v = 0; v < vertexCount; ++v)
+            triangleOffsets[v + 1] += triangleOffsets[v];
+        vertexTriangles.resize(result.size());
+        {
+            std::vector<u32> cursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+            for (u32 t = 0; t < triangleCount; ++t)
+                for (int k = 0; k < 3; ++k)
+                    vertexTriangles[cursor[result[t * 3 + k]]++] = t;
+        }
+
+        // Every interior edge appears in two triangles with opposite winding;
+        // take it once (a < b) and keep the cheaper direction.
+        candidates.clear();
+        for (u32 t = 0; t < triangleCount; ++t) {
+            for (int e = 0; e < 3; ++e) {
+                const u32 a = result[t * 3 + e];
+                const u32 b = result[t * 3 + (e + 1) % 3];
+                if (a > b)
+                    continue;
+                const double costAB = locked[a] ? HUGE_VAL : collapseCost(a, b);
+                const double costBA = locked[b] ? HUGE_VAL : collapseCost(b, a);
+                const Collapse collapse =
+                    costAB <= costBA ? Collapse{a, b, costAB} : Collapse{b, a, costBA};
+                if (collapse.Cost <= maxCost)
+                    candidates.push_back(collapse);
+            }
+        }
+        if (candidates.empty())
+            break;
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Collapse& a, const Collapse& b) { return a.Cost < b.Cost; });
+
+        // Would moving `from` onto `to` turn any surviving triangle around?
+        const auto flips = [&](u32 from, u32 to) {
+            const glm::vec3& target = local[to];
+            for (u32 i = triangleOffsets[from]; i < triangleOffsets[from + 1]; ++i) {
+                const u32* tri = &result[vertexTriangles[i] * 3];
+                if (tri[0] == to || tri[1] == to || tri[2] == to)
+                    continue; // collapses away
+                glm::vec3 p[3];
+                for (int k = 0; k < 3; ++k)
+                    p[k] = local[tri[k]];
+                const glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                for (int k = 0; k < 3; ++k)
+                    if (tri[k] == from)
+                        p[k] = target;
+                const glm::vec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+                if (glm::dot(before, after) <= 0.0f)
+                    return true;
+            }
+            return false;
+        };
+
+        std::fill(touched.begin(), touched.end(), 0);
+        for (u32 v = 0; v < vertexCount; ++v)
+            remap[v] = v;
+        const u32 wanted = (static_cast<u32>(result.size()) - targetIndexCount) / 3;
+        u32 removed = 0;
+        for (const Collapse& c : candidates) {
+            if (removed >= wanted)
+                break;
+            if (touched[c.From] || touched[c.To] || flips(c.From, c.To))
+                continue;
+            remap[c.From] = c.To;
+            quadrics[c.To] += quadrics[c.From];
+            worstCost = std::max(worstCost, c.Cost);
+            for (u32 i = triangleOffsets[c.From]; i < triangleOffsets[c.From + 1]; ++i) {
+                const u32* tri = &result[vertexTriangles[i] * 3];
+                if (tri[0] == c.To || tri[1] == c.To || tri[2] == c.To)
+                    ++removed;
+                for (int k = 0; k < 3; ++k)
+                    touched[tri[k]] = 1;
+            }
+        }
+        if (removed == 0)
+            break;
+
+        for (u32& v : result)
+            v = remap[v];
+        RemoveDegenerates(result);
+    }
+
+    for (u32& v : result)
+        v += first;
+    if (outError != nullptr)
+        *outError = static_cast<float>(std::sqrt(worstCost));
+    return result;
+}
+
+u32 MeshSimplifier::GenerateLods(Mesh& mesh, const LodChainSettings& settings)
+{
+    const bgfx::VertexLayout* layout = mesh.Layout();
+    if (layout == nullptr || !layout->has(bgfx::Attrib::Position) ||
+        mesh.VertexData().empty() || mesh.IndexData().empty())
+        return mesh.LodCount();
+
+    const u32 vertexCount = mesh.VertexCount();
+    std::vector<glm::vec3> positions(vertexCount);
+    for (u32 v = 0; v < vertexCount; ++v)
+        positions[v] = mesh.VertexPosition(v);
+
+    // LOD 0 only: regenerating replaces any existing chain.
+    const u32 indexSize = mesh.IndexSize();
+    const u32 baseCount = mesh.LevelRange(0).IndexCount;
+    std::vector<u32> indices(baseCount);
+    for (u32 i = 0; i < baseCount; ++i) {
+        if (indexSize == sizeof(u32)) {
+            std::memcpy(&indices[i], mesh.IndexData().data() + static_cast<size_t>(i) * 4, 4);
+        } else {
+            u16 v;
+            std::memcpy(&v, mesh.IndexData().data() + static_cast<size_t>(i) * 2, 2);
+            indices[i] = v;
+        }
+    }
+
+    // One list per submesh (one implicit submesh without a table), simplified
+    // in absolute vertex numbers and stored back relative to its BaseVertex.
+    std::vector<std::vector<u32>> current;
+    std::vector<u32> baseVertices;
+    if (mesh.Submeshes().empty()) {
+        current.push_back(indices);
+        baseVertices.push_back(0);
+    } else {
+        for (const Mesh::Submesh& submesh : mesh.Submeshes()) {
+            const u32 first = std::min(submesh.BaseIndex, baseCount);
+            const u32 last = std::min(first + submesh.IndexCount, baseCount);
+            std::vector<u32>& list =
+                current.emplace_back(indices.begin() + first, indices.begin() + last);
+            for (u32& v : list)
+                v += submesh.BaseVertex;
+            baseVertices.push_back(submesh.BaseVertex);
+        }
+    }
+
+    AABB box;
+    for (const std::vector<u32>& list : current)
+        for (const u32 v : list)
+            if (v < vertexCount)
+                box.Expand(positions[v]);
+    if (!box.IsValid())
+        return mesh.LodCount();
+    const float maxError = settings.MaxError * 0.5f * glm::length(box.Max - box.Min);
+
+    std::vector<Mesh::Lod> lods;
+    std::vector<u32> appended; // level indices, after LOD 0's
+    size_t previousTotal = indices.size();
+    float previousError = 0.0f;
+    const u32 levels = std::min(settings.MaxLods, Mesh::c_MaxLods);
+    for (u32 level = 1; level < levels; ++level) {
+        std::vector<std::vector<u32>> next(current.size());
+        size_t total = 0;
+        float levelError = previousError;
+        for (size_t s = 0; s < current.size(); ++s) {
+            const auto target = static_cast<u32>(
+                static_cast<float>(current[s].size()) * settings.Reduction) / 3 * 3;
+            float error = 0.0f;
+            next[s] = Simplify(positions, current[s], std::max(target, 3u), maxError, &error);
+            // Collapses leave LOD 0's triangle order behind; reorder the level.
+            MeshOptimizer::OptimizeVertexCache(next[s]);
+            MeshOptimizer::OptimizeOverdraw(next[s], positions);
+            // Errors add up along the chain: each level simplifies the previous.
+            levelError = std::max(levelError, previousError + error);
+            total += next[s].size();
+        }
+        if (total == 0 ||
+            static_cast<float>(total) > static_cast<float>(previousTotal) * settings.MinReduction)
+            break;
+
+        Mesh::Lod lod;
+        lod.Error = levelError;
+        lod.Range = {baseCount + static_cast<u32>(appended.size()), static_cast<u32>(total)};
+        for (size_t s = 0; s < next.size(); ++s) {
+            lod.Submeshes.push_back(
+                {baseCount + static_cast<u32>(appended.size()), static_cast<u32>(next[s].size())});
+            for (const u32 v : next[s])
+                appended.push_back(v - baseVertices[s]);
+        }
+        lods.push_back(std::move(lod));
+        current = std::move(next);
+        previousTotal = total;
+        previousError = levelError;
+    }
+    if (lods.empty()) {
+        mesh.SetLods({});
+        return 1;
+    }
+
+    // Re-stage LOD 0 + the levels in the mesh's index size (a level only uses
+    // its submesh's LOD 0 vertices, relative to the same BaseVertex, so 16-bit
+    // meshes stay 16-bit).
+    indices.insert(indices.end(), appended.begin(), appended.end());
+    if (indexSize == sizeof(u32)) {
+        mesh.StageIndexData(indices.data(), static_cast<u32>(indices.size() * sizeof(u32)),
+                            sizeof(u32));
+    } else {
+        std::vector<u16> narrow(indices.begin(), indices.end());
+        mesh.StageIndexData(narrow.data(), static_cast<u32>(narrow.size() * sizeof(u16)),
+                            sizeof(u16));
+    }
+    mesh.SetLods(std::move(lods));
+    return mesh.LodCount();
+}
+
+} // namespace Seraph
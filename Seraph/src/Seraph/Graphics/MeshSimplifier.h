@@ -0,0 +1,54 @@
+//
+// Import-time mesh simplification for level-of-detail chains. Simplify reduces a
+// triangle list by quadric-error (Garland-Heckbert) half-edge collapses: a vertex
+// is merged into one of its neighbours rather than moved to a new position, so
+// the result still indexes the original vertex buffer and every LOD of a mesh
+// shares it. Vertices on open borders or attribute seams (several vertices at
+// one position, e.g. a UV or hard-normal split) never move, which keeps
+// silhouettes and seams crack-free at the cost of stopping early on heavily
+// seamed meshes.
+//
+
+#pragma once
+
+#include "Mesh.h"
+#include "Seraph/Core/Base.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Seraph
+{
+
+struct LodChainSettings
+{
+    u32 MaxLods = Mesh::c_MaxLods; // including LOD 0
+    // Each level targets this fraction of the previous level's indices...
+    float Reduction = 0.5f;
+    // ...and the chain stops once a level can no longer get below this fraction
+    // (locked borders/seams, or the error limit).
+    float MinReduction = 0.85f;
+    // Largest error a level may reach, relative to the mesh's bounding radius.
+    float MaxError = 0.05f;
+};
+
+class MeshSimplifier
+{
+public:
+    // Simplify the triangle list `indices` (indexing `positions`) toward
+    // `targetIndexCount` indices without any single collapse exceeding
+    // `maxError` (object-space distance). Returns the new triangle list;
+    // `outError` receives the largest error introduced.
+    static std::vector<u32> Simplify(
+        const std::vector<glm::vec3>& positions, const std::vector<u32>& indices,
+        u32 targetIndexCount, float maxError, float* outError = nullptr);
+
+    // Generate LOD 1.. for `mesh` from its retained CPU geometry: each level
+    // simplifies every submesh of the previous level, is appended to the index
+    // data after LOD 0 and recorded with Mesh::SetLods. Re-stages the index data,
+    // so call it before Upload. Returns the resulting LOD count (1 = none).
+    static u32 GenerateLods(Mesh& mesh, const LodChainSettings& settings = {});
+};
+
+} // namespace Seraph
@@ -0,0 +1,451 @@
+//
+// Created by ruben on 2026/10/17.
+//
+
+#include "OcclusionCuller.h"
+
+#include "Mesh.h"
+#include "RenderList.h"
+#include "Seraph/Core/Threading/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SP_OCCLUSION_SSE2 1
+#else
+#define SP_OCCLUSION_SSE2 0
+#endif
+
+namespace Seraph
+{
+
+static_assert(OcclusionCuller::c_Width % 4 == 0, "rows are processed 4 pixels at a time");
+static_assert(OcclusionCuller::c_Height % OcclusionCuller::c_Bands == 0,
+              "bands must split the rows evenly");
+
+namespace
+{
+constexpr s32 c_BufferWidth = static_cast<s32>(OcclusionCuller::c_Width);
+constexpr s32 c_BandRows =
+    static_cast<s32>(OcclusionCuller::c_Height / OcclusionCuller::c_Bands);
+
+// Cached occluder geometry unused for this many frames is dropped.
+constexpr u64 c_GeometryKeepFrames = 120;
+
+// Clip space -> buffer pixels (y down) and depth. Needs clip.z >= 0, which for
+// [0,1] clip depth also means w > 0.
+glm::vec3 ToScreen(const glm::vec4& clip)
+{
+    const float invW = 1.0f / clip.w;
+    return {(clip.x * invW * 0.5f + 0.5f) * static_cast<float>(OcclusionCuller::c_Width),
+            (0.5f - clip.y * invW * 0.5f) * static_cast<float>(OcclusionCuller::c_Height),
+            clip.z * invW};
+}
+
+u32 ReadIndex(const Mesh& mesh, u32 i)
+{
+    const u8* data = mesh.IndexData().data();
+    if (mesh.IndexSize() == sizeof(u32)) {
+        u32 v;
+        std::memcpy(&v, data + static_cast<size_t>(i) * sizeof(u32), sizeof(u32));
+        return v;
+    }
+    u16 v;
+    std::memcpy(&v, data + static_cast<size_t>(i) * sizeof(u16), sizeof(u16));
+    return v;
+}
+
+// [begin, end) of `count` items for `part` of `parts` even shares.
+void Share(size_t count, u32 part, u32 parts, size_t& begin, size_t& end)
+{
+    begin = count * part / parts;
+    end = count * (part + 1) / parts;
+}
+} // namespace
+
+OcclusionCuller::OcclusionCuller()
+    : m_Depth(static_cast<size_t>(c_Width) * c_Height, 1.0f),
+      m_Pool(std::make_unique<ThreadPool>(c_Bands, "OcclusionWorker"))
+{}
+
+OcclusionCuller::~OcclusionCuller()
+{
+    if (m_Pending)
+        m_Pool->Drain();
+}
+
+void OcclusionCuller::Begin(const RenderList& list, const glm::mat4& viewProj)
+{
+    // A Begin without its Finish: let those jobs end before reusing the state.
+    if (m_Pending)
+        m_Pool->Drain();
+    m_Pending = false;
+    ++m_Frame;
+
+    m_ViewProj = viewProj;
+    m_Occluders.clear();
+    m_Boxes.clear();
+    m_Boxes.reserve(list.Objects.size());
+    u32 vertexCount = 0;
+    u32 indexCount = 0;
+    for (const RenderObject& object : list.Objects) {
+        // Outside the frustum: never drawn, so neither tested nor rasterised.
+        if (object.Visibility == FrustumTest::Outside) {
+            m_Boxes.emplace_back();
+            continue;
+        }
+        m_Boxes.push_back(object.WorldBounds);
+        if (!object.Occluder || object.SourceMesh == nullptr)
+            continue;
+        const OccluderGeometry* geometry = ResolveGeometry(*object.SourceMesh);
+        if (geometry == nullptr || geometry->Indices.empty())
+            continue;
+        m_Occluders.push_back({geometry, viewProj * object.Transform, vertexCount, indexCount});
+        vertexCount += static_cast<u32>(geometry->Positions.size());
+        indexCount += static_cast<u32>(geometry->Indices.size());
+    }
+    for (auto it = m_Geometry.begin(); it != m_Geometry.end();) {
+        if (it->second.LastFrame + c_GeometryKeepFrames < m_Frame)
+            it = m_Geometry.erase(it);
+        else
+            ++it;
+    }
+    // Without occluders nothing can be occluded.
+    if (m_Occluders.empty())
+        return;
+
+    m_ClipVertices.resize(vertexCount);
+    m_ScreenVertices.resize(vertexCount);
+    m_Indices.resize(indexCount);
+    m_Rects.assign(m_Boxes.size(), ScreenRect{});
+    for (std::vector<u8>& visible : m_BandVisible)
+        visible.assign(m_Boxes.size(), 0);
+
+    m_Pending = true;
+    m_SetupPending = c_Bands;
+    for (u32 band = 0; band < c_Bands; ++band)
+        m_Pool->Enqueue([this, band] { Setup(band); });
+}
+
+OcclusionStats OcclusionCuller::Finish(RenderList& list)
+{
+    OcclusionStats stats;
+    if (!m_Pending)
+        return stats;
+    m_Pool->Drain();
+    m_Pending = false;
+
+    stats.Occluders = static_cast<u32>(m_Occluders.size());
+    stats.OccluderTriangles = static_cast<u32>(m_Indices.size() / 3);
+    const size_t count = std::min(list.Objects.size(), m_Rects.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (!m_Rects[i].Tested)
+            continue;
+        ++stats.Tested;
+        bool visible = false;
+        for (const std::vector<u8>& band : m_BandVisible)
+            visible = visible || band[i] != 0;
+        list.Objects[i].Occluded = !visible;
+        if (!visible)
+            ++stats.Occluded;
+    }
+    return stats;
+}
+
+const OcclusionCuller::OccluderGeometry* OcclusionCuller::ResolveGeometry(const Mesh& mesh)
+{
+    const u32 vertexCount = mesh.VertexCount();
+    const u32 indexCount = mesh.IndexCount();
+    if (mesh.Layout() == nullptr || vertexCount == 0 || indexCount == 0)
+        return nullptr;
+
+    OccluderGeometry& geometry = m_Geometry[&mesh];
+    geometry.LastFrame = m_Frame;
+    if (geometry.VertexBuffer == mesh.VertexBuffer().idx &&
+        geometry.SourceVertices == vertexCount && geometry.SourceIndices == indexCount)
+        return &geometry;
+
+    // LOD 0 of every submesh, with the vertices it references unpacked (and
+    // decoded) once. Coarser levels move the silhouette, which could hide
+    // objects the drawn mesh does not.
+    geometry.Positions.clear();
+    geometry.Indices.clear();
+    geometry.VertexBuffer = mesh.VertexBuffer().idx;
+    geometry.SourceVertices = vertexCount;
+    geometry.SourceIndices = indexCount;
+    std::unordered_map<u32, u32> remap;
+    constexpr u32 lod = 0;
+    const u32 submeshCount =
+        mesh.Submeshes().empty() ? 1 : static_cast<u32>(mesh.Submeshes().size());
+    for (u32 submesh = 0; submesh < submeshCount; ++submesh) {
+        u32 first = 0, count = 0;
+        if (!mesh.SubmeshRange(submesh, lod, first, count))
+            continue;
+        const u32 baseVertex = mesh.SubmeshBaseVertex(submesh);
+        const u32 end = std::min(first + count, indexCount);
+        for (u32 i = first; i + 2 < end; i += 3) {
+            u32 corners[3];
+            bool valid = true;
+            for (u32 k = 0; k < 3; ++k) {
+                corners[k] = baseVertex + ReadIndex(mesh, i + k);
+                valid = valid && corners[k] < vertexCount;
+            }
+            if (!valid)
+                continue;
+            for (const u32 vertex : corners) {
+                const auto [it, inserted] =
+                    remap.try_emplace(vertex, static_cast<u32>(geometry.Positions.size()));
+                if (inserted)
+                    geometry.Positions.push_back(mesh.VertexPosition(vertex));
+                geometry.Indices.push_back(it->second);
+            }
+        }
+    }
+    return &geometry;
+}
+
+void OcclusionCuller::Setup(u32 band)
+{
+    size_t begin, end;
+
+    // This band's share of the occluders: vertices to clip space (and, when in
+    // front of the near plane, to the buffer), indices rebased onto them.
+    Share(m_Occluders.size(), band, c_Bands, begin, end);
+    for (size_t o = begin; o < end; ++o) {
+        const OccluderInstance& occluder = m_Occluders[o];
+        const std::vector<glm::vec3>& positions = occluder.Geometry->Positions;
+        for (size_t v = 0; v < positions.size(); ++v) {
+            const glm::vec4 clip = occluder.ModelViewProj * glm::vec4(positions[v], 1.0f);
+            m_ClipVertices[occluder.FirstVertex + v] = clip;
+            m_ScreenVertices[occluder.FirstVertex + v] =
+                clip.z >= 0.0f ? ToScreen(clip) : glm::vec3(0.0f);
+        }
+        const std::vector<u32>& indices = occluder.Geometry->Indices;
+        for (size_t i = 0; i < indices.size(); ++i)
+            m_Indices[occluder.FirstIndex + i] = occluder.FirstVertex + indices[i];
+    }
+
+    // ... and of the object boxes: the pixels each may cover and its nearest
+    // depth. A box reaching behind the near plane stays untested (visible).
+    Share(m_Boxes.size(), band, c_Bands, begin, end);
+    for (size_t b = begin; b < end; ++b) {
+        const AABB& box = m_Boxes[b];
+        if (!box.IsValid())
+            continue;
+        glm::vec3 lo(std::numeric_limits<float>::max());
+        glm::vec3 hi(std::numeric_limits<float>::lowest());
+        bool crossesNear = false;
+        for (u32 corner = 0; corner < 8 && !crossesNear; ++corner) {
+            const glm::vec3 p((corner & 1) ? box.Max.x : box.Min.x,
+                              (corner & 2) ? box.Max.y : box.Min.y,
+                              (corner & 4) ? box.Max.z : box.Min.z);
+            const glm::vec4 clip = m_ViewProj * glm::vec4(p, 1.0f);
+            if (clip.z < 0.0f) {
+                crossesNear = true;
+                break;
+            }
+            const glm::vec3 screen = ToScreen(clip);
+            lo = glm::min(lo, screen);
+            hi = glm::max(hi, screen);
+        }
+        if (crossesNear)
+            continue;
+        ScreenRect& rect = m_Rects[b];
+        rect.MinX = std::max(static_cast<s32>(std::floor(lo.x)), 0);
+        rect.MinY = std::max(static_cast<s32>(std::floor(lo.y)), 0);
+        rect.MaxX = std::min(static_cast<s32>(std::floor(hi.x)), c_BufferWidth - 1);
+        rect.MaxY = std::min(static_cast<s32>(std::floor(hi.y)),
+                             static_cast<s32>(c_Height) - 1);
+        rect.Depth = std::max(lo.z, 0.0f);
+        rect.Tested = rect.MinX <= rect.MaxX && rect.MinY <= rect.MaxY;
+    }
+
+    // The last setup job to finish starts the raster pass.
+    if (m_SetupPending.fetch_sub(1) == 1) {
+        for (u32 b = 0; b < c_Bands; ++b)
+            m_Pool->Enqueue([this, b] { Raster(b); });
+    }
+}
+
+void OcclusionCuller::Raster(u32 band)
+{
+    const s32 rowBegin = static_cast<s32>(band) * c_BandRows;
+    const s32 rowEnd = rowBegin + c_BandRows;
+    std::fill(m_Depth.begin() + static_cast<ptrdiff_t>(rowBegin) * c_BufferWidth,
+              m_Depth.begin() + static_cast<ptrdiff_t>(rowEnd) * c_BufferWidth, 1.0f);
+
+    for (size_t t = 0; t + 2 < m_Indices.size(); t += 3) {
+        const u32 i0 = m_Indices[t], i1 = m_Indices[t + 1], i2 = m_Indices[t + 2];
+        const glm::vec4* clip[3] = {&m_ClipVertices[i0], &m_ClipVertices[i1], &m_ClipVertices[i2]};
+        const bool front0 = clip[0]->z >= 0.0f;
+        const bool front1 = clip[1]->z >= 0.0f;
+        const bool front2 = clip[2]->z >= 0.0f;
+        if (!front0 && !front1 && !front2)
+            continue;
+        if (front0 && front1 && front2) {
+            const glm::vec3& a = m_ScreenVertices[i0];
+            const glm::vec3& b = m_ScreenVertices[i1];
+            const glm::vec3& c = m_ScreenVertices[i2];
+            if (std::max({a.y, b.y, c.y}) < static_cast<float>(rowBegin) ||
+                std::min({a.y, b.y, c.y}) > static_cast<float>(rowEnd))
+                continue;
+            RasterTriangle(a, b, c, rowBegin, rowEnd);
+            continue;
+        }
+
+        // Clip against the near plane (clip z = 0): one plane turns the
+        // triangle into at most a quad, drawn as a fan.
+        glm::vec3 polygon[4];
+        u32 n = 0;
+        for (u32 e = 0; e < 3; ++e) {
+            const glm::vec4& p = *clip[e];
+            const glm::vec4& q = *clip[(e + 1) % 3];
+            if (p.z >= 0.0f)
+                polygon[n++] = ToScreen(p);
+            if ((p.z >= 0.0f) != (q.z >= 0.0f))
+                polygon[n++] = ToScreen(glm::mix(p, q, p.z / (p.z - q.z)));
+        }
+        for (u32 k = 2; k < n; ++k)
+            RasterTriangle(polygon[0], polygon[k - 1], polygon[k], rowBegin, rowEnd);
+    }
+
+    std::vector<u8>& visible = m_BandVisible[band];
+    for (size_t i = 0; i < m_Rects.size(); ++i) {
+        const ScreenRect& rect = m_Rects[i];
+        if (rect.Tested && rect.MaxY >= rowBegin && rect.MinY < rowEnd)
+            visible[i] = RectVisible(rect, rowBegin, rowEnd) ? 1 : 0;
+    }
+}
+
+void OcclusionCuller::RasterTriangle(
+    const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, s32 rowBegin, s32 rowEnd)
+{
+    // Both faces are drawn (occluders may be open shells): flip clockwise
+    // triangles so the edge functions below are >= 0 inside.
+    float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (!(std::abs(area) > 1e-6f))
+        return;
+    const glm::vec3& v0 = a;
+    const glm::vec3& v1 = area > 0.0f ? b : c;
+    const glm::vec3& v2 = area > 0.0f ? c : b;
+    area = std::abs(area);
+
+    // Pixels whose centres the triangle's bounds contain, within the band.
+    const s32 minX = std::max(
+        static_cast<s32>(std::ceil(std::min({v0.x, v1.x, v2.x}) - 0.5f)), 0);
+    const s32 maxX = std::min(
+        static_cast<s32>(std::floor(std::max({v0.x, v1.x, v2.x}) - 0.5f)), c_BufferWidth - 1);
+    const s32 minY = std::max(
+        static_cast<s32>(std::ceil(std::min({v0.y, v1.y, v2.y}) - 0.5f)), rowBegin);
+    const s32 maxY = std::min(
+        static_cast<s32>(std::floor(std::max({v0.y, v1.y, v2.y}) - 0.5f)), rowEnd - 1);
+    if (minX > maxX || minY > maxY)
+        return;
+
+    // Edge functions E(x, y) = A x + B y + C, the cross product of the edge
+    // with (p - its start).
+    const auto edge = [](const glm::vec3& from, const glm::vec3& to, float& A, float& B,
+                         float& C) {
+        A = from.y - to.y;
+        B = to.x - from.x;
+        C = -(A * from.x + B * from.y);
+    };
+    float A0, B0, C0, A1, B1, C1, A2, B2, C2;
+    edge(v0, v1, A0, B0, C0);
+    edge(v1, v2, A1, B1, C1);
+    edge(v2, v0, A2, B2, C2);
+
+    // Depth plane. Each pixel stores the farthest depth the plane reaches
+    // within it (capped at the farthest vertex), so occluders never come out
+    // nearer than they are.
+    const glm::vec3 e1 = v1 - v0;
+    const glm::vec3 e2 = v2 - v0;
+    const float dzdx = (e1.z * e2.y - e2.z * e1.y) / area;
+    const float dzdy = (e2.z * e1.x - e1.z * e2.x) / area;
+    const float zBias = 0.5f * (std::abs(dzdx) + std::abs(dzdy));
+    const float z0 = v0.z - dzdx * v0.x - dzdy * v0.y + zBias;
+    const float zMax = std::max({v0.z, v1.z, v2.z});
+
+#if SP_OCCLUSION_SSE2
+    const __m128 laneX = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 a0 = _mm_set1_ps(A0), a1 = _mm_set1_ps(A1), a2 = _mm_set1_ps(A2);
+    const __m128 zdx = _mm_set1_ps(dzdx);
+    const __m128 zCap = _mm_set1_ps(zMax);
+    const __m128 zero = _mm_setzero_ps();
+    const s32 startX = minX & ~3;
+    for (s32 y = minY; y <= maxY; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        const __m128 r0 = _mm_set1_ps(B0 * py + C0);
+        const __m128 r1 = _mm_set1_ps(B1 * py + C1);
+        const __m128 r2 = _mm_set1_ps(B2 * py + C2);
+        const __m128 rz = _mm_set1_ps(dzdy * py + z0);
+        float* row = m_Depth.data() + static_cast<ptrdiff_t>(y) * c_BufferWidth;
+        for (s32 x = startX; x <= maxX; x += 4) {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneX);
+            const __m128 inside = _mm_and_ps(
+                _mm_and_ps(_mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, px), r0), zero),
+                           _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, px), r1), zero)),
+                _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, px), r2), zero));
+            if (_mm_movemask_ps(inside) == 0)
+                continue;
+            const __m128 z = _mm_min_ps(_mm_add_ps(_mm_mul_ps(zdx, px), rz), zCap);
+            const __m128 old = _mm_loadu_ps(row + x);
+            const __m128 nearest = _mm_min_ps(old, z);
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest),
+                                             _mm_andnot_ps(inside, old)));
+        }
+    }
+#else
+    for (s32 y = minY; y <= maxY; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        float* row = m_Depth.data() + static_cast<ptrdiff_t>(y) * c_BufferWidth;
+        for (s32 x = minX; x <= maxX; ++x) {
+            const float px = static_cast<float>(x) + 0.5f;
+            if (A0 * px + B0 * py + C0 < 0.0f || A1 * px + B1 * py + C1 < 0.0f ||
+                A2 * px + B2 * py + C2 < 0.0f)
+                continue;
+            const float z = std::min(dzdx * px + dzdy * py + z0, zMax);
+            row[x] = std::min(row[x], z);
+        }
+    }
+#endif
+}
+
+bool OcclusionCuller::RectVisible(const ScreenRect& rect, s32 rowBegin, s32 rowEnd) const
+{
+    // Visible as soon as one pixel's occluder depth is not nearer than the box.
+    const s32 minY = std::max(rect.MinY, rowBegin);
+    const s32 maxY = std::min(rect.MaxY, rowEnd - 1);
+#if SP_OCCLUSION_SSE2
+    const __m128 lane = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 lo = _mm_set1_ps(static_cast<float>(rect.MinX));
+    const __m128 hi = _mm_set1_ps(static_cast<float>(rect.MaxX));
+    const __m128 depth = _mm_set1_ps(rect.Depth);
+    const s32 startX = rect.MinX & ~3;
+    for (s32 y = minY; y <= maxY; ++y) {
+        const float* row = m_Depth.data() + static_cast<ptrdiff_t>(y) * c_BufferWidth;
+        for (s32 x = startX; x <= rect.MaxX; x += 4) {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lane);
+            const __m128 inRect = _mm_and_ps(_mm_cmpge_ps(px, lo), _mm_cmple_ps(px, hi));
+            const __m128 open = _mm_cmpge_ps(_mm_loadu_ps(row + x), depth);
+            if (_mm_movemask_ps(_mm_and_ps(inRect, open)) != 0)
+                return true;
+        }
+    }
+#else
+    for (s32 y = minY; y <= maxY; ++y) {
+        const float* row = m_Depth.data() + static_cast<ptrdiff_t>(y) * c_BufferWidth;
+        for (s32 x = rect.MinX; x <= rect.MaxX; ++x) {
+            if (row[x] >= rect.Depth)
+                return true;
+        }
+    }
+#endif
+    return false;
+}
+
+} // namespace Seraph
@@ -0,0 +1,138 @@
+//
+// CPU software occlusion culling. Designated occluders (RenderObject::Occluder,
+// from MeshComponent::Occluder) are rasterised at LOD 0 into a small depth
+// buffer, and every render object's world box inside the camera frustum is
+// then tested against it: an object whose screen rectangle is everywhere behind occluder
+// depth is occluded. The work runs on the culler's own worker threads between
+// Begin and Finish, so the main thread keeps recording meanwhile; nothing is
+// read back from the GPU.
+//
+// The buffer is c_Width x c_Height (un-reversed [0,1] depth, cleared to 1), cut
+// into c_Bands horizontal bands:
+//   1. setup, one job per band: transform a share of the occluder vertices to
+//      clip space and project a share of the object boxes to screen rects;
+//   2. raster, queued by the last setup job, one job per band: draw every
+//      occluder triangle that reaches the band into the band's rows, then test
+//      every object rect that reaches it.
+// An object is occluded when no band found any of its pixels unoccluded.
+// Occluder coverage is sampled at pixel centres and its depth is pushed to the
+// farthest value within each pixel, so occluders should sit inside what they
+// hide (a simplified shell, not a bulging proxy).
+//
+
+#pragma once
+
+#include "Seraph/Core/Base.h"
+#include "Seraph/Math/Bounds.h"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Seraph
+{
+class Mesh;
+class ThreadPool;
+struct RenderList;
+
+struct OcclusionStats
+{
+    u32 Occluders = 0;         // occluder objects rasterised
+    u32 OccluderTriangles = 0; // their triangles (LOD 0)
+    u32 Tested = 0;            // objects with an on-screen box in front of the near plane
+    u32 Occluded = 0;
+};
+
+class OcclusionCuller
+{
+public:
+    static constexpr u32 c_Width = 256; // multiple of 4 (SIMD lanes)
+    static constexpr u32 c_Height = 128;
+    static constexpr u32 c_Bands = 4;   // raster jobs; divides c_Height
+
+    OcclusionCuller();
+    ~OcclusionCuller();
+
+    OcclusionCuller(const OcclusionCuller&) = delete;
+    OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+    // Queue the culling of `list`'s objects against its occluders, as seen
+    // through `viewProj` (world -> clip, UN-reversed [0,1] depth, like
+    // Frustum::FromMatrix). Objects whose RenderObject::Visibility is Outside
+    // are skipped. Occluder geometry is resolved here (main thread); `list` and
+    // its meshes must stay unchanged until Finish.
+    void Begin(const RenderList& list, const glm::mat4& viewProj);
+
+    // Wait for the queued jobs and write each object's RenderObject::Occluded.
+    // Returns zeroed stats when nothing was queued.
+    OcclusionStats Finish(RenderList& list);
+
+    [[nodiscard]] bool IsPending() const { return m_Pending; }
+
+private:
+    // An occluder mesh's LOD 0, compacted to the vertices it uses.
+    // Cached per mesh; the vertex buffer handle and counts catch a mesh freed
+    // and another allocated at the same address.
+    struct OccluderGeometry
+    {
+        std::vector<glm::vec3> Positions;
+        std::vector<u32> Indices;
+        u16 VertexBuffer = UINT16_MAX;
+        u32 SourceVertices = 0;
+        u32 SourceIndices = 0;
+        u64 LastFrame = 0;
+    };
+    struct OccluderInstance
+    {
+        const OccluderGeometry* Geometry = nullptr;
+        glm::mat4 ModelViewProj{1.0f};
+        u32 FirstVertex = 0; // into m_ClipVertices
+        u32 FirstIndex = 0;  // into m_Indices
+    };
+    // An object box projected to the buffer: the pixels it may cover and its
+    // nearest depth. Untested objects (no box, crossing the near plane, or off
+    // screen) are never occluded.
+    struct ScreenRect
+    {
+        s32 MinX = 0, MinY = 0, MaxX = -1, MaxY = -1; // inclusive
+        float Depth = 0.0f;
+        bool Tested = false;
+    };
+
+    const OccluderGeometry* ResolveGeometry(const Mesh& mesh);
+    void Setup(u32 band);
+    void Raster(u32 band);
+    void RasterTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+                        s32 rowBegin, s32 rowEnd);
+    [[nodiscard]] bool RectVisible(const ScreenRect& rect, s32 rowBegin, s32 rowEnd) const;
+
+    std::unordered_map<const Mesh*, OccluderGeometry> m_Geometry;
+    u64 m_Frame = 0;
+
+    // Per-Begin inputs, read-only to the jobs.
+    glm::mat4 m_ViewProj{1.0f};
+    std::vector<OccluderInstance> m_Occluders;
+    std::vector<AABB> m_Boxes; // parallel to the list's objects
+
+    // Written by the setup jobs (disjoint ranges), read by the raster jobs.
+    std::vector<glm::vec4> m_ClipVertices;
+    std::vector<glm::vec3> m_ScreenVertices; // x, y pixels, z depth (z >= 0 only)
+    std::vector<u32> m_Indices;              // into m_ClipVertices
+    std::vector<ScreenRect> m_Rects;
+
+    // Written by the raster jobs, each its own rows / vector.
+    std::vector<float> m_Depth;
+    std::array<std::vector<u8>, c_Bands> m_BandVisible;
+
+    std::atomic<u32> m_SetupPending{0};
+    bool m_Pending = false;
+    // Declared last so it is destroyed (draining its jobs) before the state
+    // the jobs use.
+    std::unique_ptr<ThreadPool> m_Pool;
+};
+
+} // namespace Seraph
@@ -0,0 +1,439 @@
+//
+// Created by ruben on 2026/10/17.
+//
+
+#include "RenderGraph.h"
+
+#include "Seraph/Console/ConsoleCommand.h"
+#include "Seraph/Core/Assert.h"
+#include "Seraph/Core/Log.h"
+#include "ViewId.h"
+
+#include <algorithm>
+
+namespace Seraph
+{
+
+namespace
+{
+// The graph that executed last, for r.graph (cleared when it is destroyed).
+const RenderGraph* s_LastExecuted = nullptr;
+
+u64 TextureBytes(u32 width, u32 height, bgfx::TextureFormat::Enum format)
+{
+    bgfx::TextureInfo info{};
+    bgfx::calcTextureSize(info, static_cast<u16>(width), static_cast<u16>(height), 1, false,
+                          false, 1, format);
+    return info.storageSize;
+}
+
+// A RenderTarget's footprint: its color attachment plus the D24S8 depth, both
+// per sample, plus the single-sampled color resolve when multisampled.
+u64 TargetBytes(const RenderGraphTargetDesc& desc)
+{
+    const u64 color = TextureBytes(desc.Width, desc.Height, desc.Format);
+    const u64 depth = TextureBytes(desc.Width, desc.Height, bgfx::TextureFormat::D24S8);
+    const u32 samples = MsaaSamples(desc.Msaa);
+    return (color + depth) * samples + (samples > 1 ? color : 0);
+}
+
+RenderGraphTargetDesc DescOf(const RenderTarget& target)
+{
+    return {target.width, target.height, target.colorFormat, target.msaa};
+}
+
+double ToMiB(u64 bytes)
+{
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+} // namespace
+
+SP_CONSOLE_COMMAND("r.graph", "Print the last render graph: passes, views, targets and VRAM",
+    [](const ConsoleCommandArgs&)
+    {
+        if (s_LastExecuted == nullptr) {
+            SP_CONSOLE_LOG_INFO("No render graph has executed");
+            return;
+        }
+        s_LastExecuted->LogReport();
+    });
+
+bgfx::TextureHandle RenderGraphPassContext::Texture(RenderGraphResource resource) const
+{
+    return Graph->GetTexture(resource);
+}
+
+// ---------------------------------------------------------------------------
+// Declaration
+// ---------------------------------------------------------------------------
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Read(RenderGraphResource resource)
+{
+    SP_CORE_ASSERT(resource.Index < m_Graph.m_Resources.size(), "RenderGraph: bad resource");
+    m_Graph.m_Passes[m_Pass].Reads.push_back(resource.Index);
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Write(RenderGraphResource resource)
+{
+    SP_CORE_ASSERT(resource.Index < m_Graph.m_Resources.size(), "RenderGraph: bad resource");
+    Pass& pass = m_Graph.m_Passes[m_Pass];
+    SP_CORE_ASSERT(pass.Write == RenderGraphResource::c_Invalid,
+                   "RenderGraph: a pass writes one target");
+    pass.Write = resource.Index;
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Clear(u16 flags, u32 rgba, float depth)
+{
+    Pass& pass = m_Graph.m_Passes[m_Pass];
+    pass.ClearFlags = flags;
+    pass.ClearColor = rgba;
+    pass.ClearDepth = depth;
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::SideEffect()
+{
+    m_Graph.m_Passes[m_Pass].SideEffect = true;
+    return *this;
+}
+
+RenderGraph::RenderGraph() = default;
+
+RenderGraph::~RenderGraph()
+{
+    Destroy();
+    if (s_LastExecuted == this)
+        s_LastExecuted = nullptr;
+}
+
+void RenderGraph::BeginDeclare()
+{
+    if (!m_Executed)
+        return;
+    m_Executed = false;
+    m_Resources.clear();
+    m_Passes.clear();
+}
+
+RenderGraphResource RenderGraph::CreateTarget(std::string name, const RenderGraphTargetDesc& desc)
+{
+    BeginDeclare();
+    SP_CORE_ASSERT(desc.Width > 0 && desc.Height > 0, "RenderGraph: empty target");
+    Resource& resource = m_Resources.emplace_back();
+    resource.Name = std::move(name);
+    resource.Desc = desc;
+    return {static_cast<u32>(m_Resources.size() - 1)};
+}
+
+RenderGraphResource RenderGraph::ImportTarget(std::string name, const RenderTarget& target)
+{
+    BeginDeclare();
+    Resource& resource = m_Resources.emplace_back();
+    resource.Name = std::move(name);
+    resource.Kind = ResourceKind::Imported;
+    resource.Desc = DescOf(target);
+    resource.Framebuffer = target.fb;
+    resource.Color = target.color;
+    return {static_cast<u32>(m_Resources.size() - 1)};
+}
+
+RenderGraphResource RenderGraph::ImportBackbuffer(u16 width, u16 height)
+{
+    BeginDeclare();
+    Resource& resource = m_Resources.emplace_back();
+    resource.Name = "Backbuffer";
+    resource.Kind = ResourceKind::Backbuffer;
+    resource.Desc = {width, height, bgfx::TextureFormat::Count};
+    return {static_cast<u32>(m_Resources.size() - 1)};
+}
+
+RenderGraph::PassBuilder RenderGraph::AddPass(std::string name, ExecuteFn execute)
+{
+    BeginDeclare();
+    Pass& pass = m_Passes.emplace_back();
+    pass.Name = std::move(name);
+    pass.Execute = std::move(execute);
+    return {*this, static_cast<u32>(m_Passes.size() - 1)};
+}
+
+// ---------------------------------------------------------------------------
+// Compile
+// ---------------------------------------------------------------------------
+
+// Passes only depend on earlier ones (declaration order is execution order),
+// so one backward sweep settles liveness: a pass is live if it has a side
+// effect, writes an imported target, or produces something a later live pass
+// reads or loads (writes without clearing).
+void RenderGraph::Cull()
+{
+    std::vector<bool> needed(m_Resources.size(), false);
+    for (size_t p = m_Passes.size(); p-- > 0;) {
+        Pass& pass = m_Passes[p];
+        const bool writesExternal = pass.Write != RenderGraphResource::c_Invalid &&
+                                    m_Resources[pass.Write].Kind != ResourceKind::Transient;
+        pass.Live = pass.SideEffect || writesExternal ||
+                    (pass.Write != RenderGraphResource::c_Invalid && needed[pass.Write]);
+        if (!pass.Live)
+            continue;
+        if (pass.Write != RenderGraphResource::c_Invalid) {
+            // A full clear makes earlier writes dead; otherwise they are loaded.
+            constexpr u16 c_FullClear = BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH;
+            needed[pass.Write] = (pass.ClearFlags & c_FullClear) != c_FullClear;
+        }
+        for (const u32 read : pass.Reads)
+            needed[read] = true;
+    }
+}
+
+void RenderGraph::AssignViews()
+{
+    constexpr u32 c_ViewCount = ViewId::GraphLast - ViewId::GraphFirst + 1;
+    u32 next = 0;
+    for (Pass& pass : m_Passes) {
+        if (!pass.Live)
+            continue;
+        if (next == c_ViewCount) {
+            SP_CORE_WARN_TAG("RenderGraph", "Out of graph views; pass '{}' skipped", pass.Name);
+            pass.Live = false;
+            continue;
+        }
+        pass.ViewId = static_cast<u16>(ViewId::GraphFirst + next++);
+    }
+}
+
+// Walk the live passes in order: a transient takes a pooled target at its
+// first use and hands it back after its last, so a later transient with the
+// same description can take the same memory.
+void RenderGraph::Alias()
+{
+    for (PooledTarget& pooled : m_Pool)
+        pooled.InUse = false;
+
+    for (Resource& resource : m_Resources) {
+        resource.Physical = -1;
+        resource.FirstPass = c_Unused;
+        resource.LastPass = 0;
+    }
+    for (u32 p = 0; p < m_Passes.size(); ++p) {
+        const Pass& pass = m_Passes[p];
+        if (!pass.Live)
+            continue;
+        const auto touch = [&](u32 index) {
+            Resource& resource = m_Resources[index];
+            if (resource.FirstPass == c_Unused)
+                resource.FirstPass = p;
+            resource.LastPass = p;
+        };
+        for (const u32 read : pass.Reads) {
+            SP_CORE_ASSERT(m_Resources[read].Kind != ResourceKind::Transient ||
+                               m_Resources[read].FirstPass != c_Unused,
+                           "RenderGraph: transient read before it is written");
+            touch(read);
+        }
+        if (pass.Write != RenderGraphResource::c_Invalid)
+            touch(pass.Write);
+    }
+
+    for (u32 p = 0; p < m_Passes.size(); ++p) {
+        if (!m_Passes[p].Live)
+            continue;
+        for (Resource& resource : m_Resources)
+            if (resource.Kind == ResourceKind::Transient && resource.FirstPass == p)
+                resource.Physical = AcquirePooled(resource.Desc);
+        for (Resource& resource : m_Resources)
+            if (resource.Kind == ResourceKind::Transient && resource.LastPass == p &&
+                resource.Physical >= 0)
+                m_Pool[resource.Physical].InUse = false;
+    }
+}
+
+s32 RenderGraph::AcquirePooled(const RenderGraphTargetDesc& desc)
+{
+    for (size_t i = 0; i < m_Pool.size(); ++i) {
+        PooledTarget& pooled = m_Pool[i];
+        if (!pooled.InUse && DescOf(pooled.Target) == desc) {
+            pooled.InUse = true;
+            pooled.LastUsedFrame = m_Frame;
+            return static_cast<s32>(i);
+        }
+    }
+    PooledTarget& pooled = m_Pool.emplace_back();
+    pooled.Target.Create(desc.Width, desc.Height, desc.Format, desc.Msaa);
+    pooled.InUse = true;
+    pooled.LastUsedFrame = m_Frame;
+    return static_cast<s32>(m_Pool.size() - 1);
+}
+
+// Runs before Alias, so no Resource::Physical indexes the pool while it shrinks.
+// A target no declared transient can take is destroyed at once (a resize leaves
+// no stale sizes behind); the rest once idle for c_PoolRetainFrames.
+void RenderGraph::EvictIdleTargets()
+{
+    std::erase_if(m_Pool, [&](PooledTarget& pooled) {
+        const RenderGraphTargetDesc desc = DescOf(pooled.Target);
+        const bool declared = std::any_of(m_Resources.begin(), m_Resources.end(),
+            [&](const Resource& resource) {
+                return resource.Kind == ResourceKind::Transient && resource.Desc == desc;
+            });
+        if (declared && m_Frame - pooled.LastUsedFrame <= c_PoolRetainFrames)
+            return false;
+        pooled.Target.Destroy();
+        return true;
+    });
+}
+
+// ---------------------------------------------------------------------------
+// Execute
+// ---------------------------------------------------------------------------
+
+void RenderGraph::Execute()
+{
+    ++m_Frame;
+    Cull();
+    AssignViews();
+    EvictIdleTargets();
+    Alias();
+
+    m_Stats = {};
+    m_Stats.Passes = static_cast<u32>(m_Passes.size());
+    for (const Pass& pass : m_Passes)
+        m_Stats.PassesCulled += pass.Live ? 0 : 1;
+    std::vector<bool> counted(m_Pool.size(), false);
+    for (const Resource& resource : m_Resources) {
+        if (resource.Kind != ResourceKind::Transient || resource.Physical < 0)
+            continue;
+        ++m_Stats.Transients;
+        m_Stats.TransientBytes += TargetBytes(resource.Desc);
+        if (!counted[resource.Physical]) {
+            counted[resource.Physical] = true;
+            ++m_Stats.PhysicalTargets;
+            m_Stats.AllocatedBytes += TargetBytes(resource.Desc);
+        }
+    }
+
+    for (const Pass& pass : m_Passes) {
+        if (!pass.Live)
+            continue;
+        BindPass(pass);
+        RenderGraphPassContext context;
+        context.ViewId = pass.ViewId;
+        context.Graph = this;
+        if (pass.Write != RenderGraphResource::c_Invalid) {
+            context.Width = static_cast<u16>(m_Resources[pass.Write].Desc.Width);
+            context.Height = static_cast<u16>(m_Resources[pass.Write].Desc.Height);
+        }
+        if (pass.Execute)
+            pass.Execute(context);
+    }
+
+    for (const PooledTarget& pooled : m_Pool)
+        m_Stats.PoolBytes += TargetBytes(DescOf(pooled.Target));
+
+    m_Executed = true;
+    s_LastExecuted = this;
+}
+
+// A graph view may have served another pass (or another graph) last frame, so
+// all of its state is set, not just what differs from the defaults.
+void RenderGraph::BindPass(const Pass& pass) const
+{
+    const u16 view = pass.ViewId;
+    bgfx::setViewName(view, pass.Name.c_str());
+    bgfx::setViewMode(view, bgfx::ViewMode::Default);
+    bgfx::setViewTransform(view, nullptr, nullptr);
+    bgfx::setViewClear(view, pass.ClearFlags, pass.ClearColor, pass.ClearDepth, 0);
+
+    if (pass.Write == RenderGraphResource::c_Invalid) {
+        bgfx::setViewFrameBuffer(view, BGFX_INVALID_HANDLE);
+        bgfx::setViewRect(view, 0, 0, bgfx::BackbufferRatio::Equal);
+    } else {
+        const RenderGraphTargetDesc& desc = m_Resources[pass.Write].Desc;
+        bgfx::setViewFrameBuffer(view, Framebuffer(pass.Write));
+        bgfx::setViewRect(view, 0, 0, static_cast<u16>(desc.Width),
+                          static_cast<u16>(desc.Height));
+    }
+    if (pass.ClearFlags != BGFX_CLEAR_NONE)
+        bgfx::touch(view);
+}
+
+const RenderGraph::Resource& RenderGraph::Resolve(RenderGraphResource resource) const
+{
+    SP_CORE_ASSERT(resource.Index < m_Resources.size(), "RenderGraph: bad resource");
+    return m_Resources[resource.Index];
+}
+
+bgfx::FrameBufferHandle RenderGraph::Framebuffer(u32 resource) const
+{
+    const Resource& r = m_Resources[resource];
+    if (r.Kind == ResourceKind::Imported)
+        return r.Framebuffer;
+    if (r.Kind == ResourceKind::Transient && r.Physical >= 0)
+        return m_Pool[r.Physical].Target.fb;
+    return BGFX_INVALID_HANDLE; // the backbuffer
+}
+
+bgfx::TextureHandle RenderGraph::GetTexture(RenderGraphResource resource) const
+{
+    const Resource& r = Resolve(resource);
+    if (r.Kind == ResourceKind::Imported)
+        return r.Color;
+    if (r.Kind == ResourceKind::Transient && r.Physical >= 0)
+        return m_Pool[r.Physical].Target.color;
+    return BGFX_INVALID_HANDLE;
+}
+
+const RenderGraphTargetDesc& RenderGraph::GetDesc(RenderGraphResource resource) const
+{
+    return Resolve(resource).Desc;
+}
+
+void RenderGraph::Destroy()
+{
+    for (PooledTarget& pooled : m_Pool)
+        pooled.Target.Destroy();
+    m_Pool.clear();
+}
+
+void RenderGraph::LogReport() const
+{
+    SP_CONSOLE_LOG_INFO("Passes: {} declared, {} culled", m_Stats.Passes, m_Stats.PassesCulled);
+    for (const Pass& pass : m_Passes) {
+        const char* target = pass.Write != RenderGraphResource::c_Invalid
+                                 ? m_Resources[pass.Write].Name.c_str()
+                                 : "-";
+        if (pass.Live)
+            SP_CONSOLE_LOG_INFO("  view {:3}  {} -> {}", pass.ViewId, pass.Name, target);
+        else
+            SP_CONSOLE_LOG_INFO("  culled    {} -> {}", pass.Name, target);
+    }
+    SP_CONSOLE_LOG_INFO("Targets:");
+    for (const Resource& resource : m_Resources) {
+        switch (resource.Kind) {
+            case ResourceKind::Transient:
+                if (resource.Physical < 0)
+                    SP_CONSOLE_LOG_INFO("  {} (unused)", resource.Name);
+                else
+                    SP_CONSOLE_LOG_INFO("  {} {}x{} x{}  {:.2f} MiB  pool slot {}", resource.Name,
+                                        resource.Desc.Width, resource.Desc.Height,
+                                        MsaaSamples(resource.Desc.Msaa),
+                                        ToMiB(TargetBytes(resource.Desc)), resource.Physical);
+                break;
+            case ResourceKind::Imported:
+                SP_CONSOLE_LOG_INFO("  {} {}x{}  imported", resource.Name, resource.Desc.Width,
+                                    resource.Desc.Height);
+                break;
+            case ResourceKind::Backbuffer:
+                SP_CONSOLE_LOG_INFO("  {} {}x{}", resource.Name, resource.Desc.Width,
+                                    resource.Desc.Height);
+                break;
+        }
+    }
+    SP_CONSOLE_LOG_INFO("Transients: {} on {} pooled targets, {:.2f} MiB unaliased, "
+                        "{:.2f} MiB allocated; pool holds {} targets, {:.2f} MiB",
+                        m_Stats.Transients, m_Stats.PhysicalTargets, ToMiB(m_Stats.TransientBytes),
+                        ToMiB(m_Stats.AllocatedBytes), m_Pool.size(), ToMiB(m_Stats.PoolBytes));
+}
+
+} // namespace Seraph
@@ -0,0 +1,202 @@
+//
+// Frame render graph over RenderPass / RenderTarget. A layer declares, each
+// frame, the targets it renders to and the passes that draw them, in execution
+// order; Execute() then compiles and runs the frame:
+//   1. cull: passes whose output nothing reads are dropped (an imported target,
+//      e.g. the backbuffer or the editor viewport texture, or a pass marked
+//      SideEffect, keeps its producers alive);
+//   2. view ids: the surviving passes get consecutive bgfx views from
+//      ViewId::GraphFirst in declaration order, which is also bgfx's execution
+//      order, so no pass needs a hand-picked id;
+//   3. aliasing: each transient target lives from its first to its last use,
+//      and targets with disjoint lifetimes and the same size/format/MSAA share one
+//      pooled RenderTarget. The pool persists across frames. Before aliasing,
+//      an entry no declared transient matches (e.g. the old size after a
+//      resize) is destroyed, as is one idle for c_PoolRetainFrames executions.
+//   4. each pass's view is bound (framebuffer, rect, clear, name) and its
+//      callback runs with the assigned view id.
+//
+// A transient's contents are undefined when its first pass starts (the memory
+// may have just held another target): that pass must clear or overwrite it.
+// A pass writes at most one target (one bgfx view = one framebuffer) and may
+// read any number; reading a transient before any pass wrote it asserts.
+//
+// The last executed graph (passes, views, targets, VRAM) is printed by r.graph.
+//
+
+#pragma once
+
+#include "RenderTarget.h"
+#include "Seraph/Core/Base.h"
+
+#include <bgfx/bgfx.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Seraph
+{
+class RenderGraph;
+
+struct RenderGraphResource
+{
+    static constexpr u32 c_Invalid = ~0u;
+    u32 Index = c_Invalid;
+
+    [[nodiscard]] bool IsValid() const { return Index != c_Invalid; }
+};
+
+struct RenderGraphTargetDesc
+{
+    u32 Width = 0;
+    u32 Height = 0;
+    bgfx::TextureFormat::Enum Format = bgfx::TextureFormat::RGBA8; // + D24S8 depth
+    u64 Msaa = 0; // BGFX_TEXTURE_RT_MSAA_X*; the pass reading it samples the resolve
+
+    bool operator==(const RenderGraphTargetDesc& other) const
+    {
+        return Width == other.Width && Height == other.Height && Format == other.Format &&
+               Msaa == other.Msaa;
+    }
+};
+
+// What a pass callback gets: its view (already bound) and the graph's targets.
+struct RenderGraphPassContext
+{
+    u16 ViewId = 0;
+    u16 Width = 0; // the written target's size (0 for a pass that writes none)
+    u16 Height = 0;
+    const RenderGraph* Graph = nullptr;
+
+    // Color texture of a target, for sampling.
+    [[nodiscard]] bgfx::TextureHandle Texture(RenderGraphResource resource) const;
+};
+
+struct RenderGraphStats
+{
+    u32 Passes = 0;          // declared
+    u32 PassesCulled = 0;
+    u32 Transients = 0;      // transient targets declared (and not culled)
+    u32 PhysicalTargets = 0; // pooled targets they were aliased onto this frame
+    u64 TransientBytes = 0;  // what the transients would cost unaliased
+    u64 AllocatedBytes = 0;  // what the physical targets used this frame cost
+    u64 PoolBytes = 0;       // everything the pool holds, idle entries included
+};
+
+class RenderGraph
+{
+public:
+    using ExecuteFn = std::function<void(const RenderGraphPassContext&)>;
+
+    // Frames a pooled target that still matches a declared transient may sit
+    // unused before it is destroyed.
+    static constexpr u64 c_PoolRetainFrames = 120;
+
+    // Chains a pass's declarations; valid until the next AddPass.
+    class PassBuilder
+    {
+    public:
+        PassBuilder& Read(RenderGraphResource resource);
+        PassBuilder& Write(RenderGraphResource resource);
+        // Clear the written target when the pass starts (reversed-Z: depth 0).
+        PassBuilder& Clear(u16 flags, u32 rgba = 0x000000ff, float depth = 0.0f);
+        // Never culled (the pass has effects the graph cannot see).
+        PassBuilder& SideEffect();
+
+    private:
+        PassBuilder(RenderGraph& graph, u32 pass) : m_Graph(graph), m_Pass(pass) {}
+
+        RenderGraph& m_Graph;
+        u32 m_Pass;
+
+        friend class RenderGraph;
+    };
+
+    RenderGraph();
+    ~RenderGraph();
+
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    // Declaring into a graph that has executed starts a new frame.
+    [[nodiscard]] RenderGraphResource CreateTarget(std::string name,
+                                                   const RenderGraphTargetDesc& desc);
+    // An externally owned target (read after the graph, e.g. by ImGui). Passes
+    // writing it are never culled, and it is never aliased.
+    [[nodiscard]] RenderGraphResource ImportTarget(std::string name, const RenderTarget& target);
+    [[nodiscard]] RenderGraphResource ImportBackbuffer(u16 width, u16 height);
+
+    PassBuilder AddPass(std::string name, ExecuteFn execute);
+
+    // Compile and run the declared frame (see the header comment).
+    void Execute();
+
+    // Destroy every pooled target (layer detach).
+    void Destroy();
+
+    [[nodiscard]] bgfx::TextureHandle GetTexture(RenderGraphResource resource) const;
+    [[nodiscard]] const RenderGraphTargetDesc& GetDesc(RenderGraphResource resource) const;
+    [[nodiscard]] const RenderGraphStats& GetStats() const { return m_Stats; }
+
+    // Log the last executed frame: passes with their views, targets with their
+    // pooled slot and size, and the VRAM totals.
+    void LogReport() const;
+
+private:
+    enum class ResourceKind { Transient, Imported, Backbuffer };
+
+    struct Resource
+    {
+        std::string Name;
+        ResourceKind Kind = ResourceKind::Transient;
+        RenderGraphTargetDesc Desc;
+        bgfx::FrameBufferHandle Framebuffer = BGFX_INVALID_HANDLE; // imported
+        bgfx::TextureHandle Color = BGFX_INVALID_HANDLE;           // imported
+        s32 Physical = -1; // pool slot (transients, once compiled)
+        u32 FirstPass = c_Unused;
+        u32 LastPass = 0;
+    };
+
+    struct Pass
+    {
+        std::string Name;
+        ExecuteFn Execute;
+        std::vector<u32> Reads;
+        u32 Write = RenderGraphResource::c_Invalid;
+        u16 ClearFlags = BGFX_CLEAR_NONE;
+        u32 ClearColor = 0x000000ff;
+        float ClearDepth = 0.0f;
+        bool SideEffect = false;
+        bool Live = false;
+        u16 ViewId = 0;
+    };
+
+    struct PooledTarget
+    {
+        RenderTarget Target;
+        u64 LastUsedFrame = 0;
+        bool InUse = false; // taken by a transient during the current compile
+    };
+
+    static constexpr u32 c_Unused = ~0u;
+
+    void BeginDeclare();
+    void Cull();
+    void AssignViews();
+    void Alias();
+    void EvictIdleTargets();
+    s32 AcquirePooled(const RenderGraphTargetDesc& desc);
+    void BindPass(const Pass& pass) const;
+    [[nodiscard]] const Resource& Resolve(RenderGraphResource resource) const;
+    [[nodiscard]] bgfx::FrameBufferHandle Framebuffer(u32 resource) const;
+
+    std::vector<Resource> m_Resources;
+    std::vector<Pass> m_Passes;
+    std::vector<PooledTarget> m_Pool;
+    RenderGraphStats m_Stats;
+    u64 m_Frame = 0;
+    bool m_Executed = false;
+};
+
+} // namespace Seraph
@@ -0,0 +1,96 @@
+//
+// Flat, per-frame render list: the output of the scene extraction stage. The
+// scene's mesh components are walked once per frame (Scene::OnRender* ->
+// SceneRenderer::SubmitMesh), resolving each mesh asset, world matrix, world
+// bounds and per-submesh material up front. Every pass then reads this list
+// instead of walking the registry again: the scene pass (camera culling, sort,
+// instancing), the shadow cascades (caster culling + instancing), and the
+// editor pick pass.
+//
+// Objects and items are plain contiguous arrays. An object is one mesh
+// instance; its items (one per submesh) are the contiguous range
+// [FirstItem, FirstItem + ItemCount) of Items. The list stays valid from the end
+// of extraction until the next SceneRenderer::BeginScene.
+//
+
+#pragma once
+
+#include "Material/MaterialAsset.h"
+#include "Seraph/Core/Base.h"
+#include "Seraph/Core/Ref.h"
+#include "Seraph/Core/UUID.h"
+#include "Seraph/Math/Bounds.h"
+
+#include <bgfx/bgfx.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Seraph
+{
+class Mesh;
+
+// Coarsest sort-key field: layers are submitted in enum order within a view.
+enum class RenderLayer : u8
+{
+    World = 0,
+    Overlay, // reserved for draws that must land after the world
+};
+
+struct RenderObject
+{
+    const Mesh* SourceMesh = nullptr;
+    glm::mat4 Transform{1.0f};
+    // World-space bounds; invalid when the mesh has none (never culled).
+    AABB WorldBounds;
+    BoundingSphere WorldSphere;
+    UUID Entity = 0; // 0 for draws not tied to an entity
+    // Level of detail drawn in the scene pass (from projected size, see
+    // SceneRenderer::SubmitMesh) and in the shadow cascades (coarser by
+    // r.lod.shadowBias). Both are clamped to the mesh's LodCount().
+    u32 Lod = 0;
+    u32 ShadowLod = 0;
+    // Cached into the static shadow tiles rather than redrawn every frame (set by
+    // SceneRenderer::RenderSunShadow when r.shadow.cache is on).
+    bool StaticCaster = false;
+    // Camera frustum test (SceneRenderer::CullFrustum). Outside objects are
+    // neither drawn nor occlusion tested; Inside ones skip the per-submesh test.
+    FrustumTest Visibility = FrustumTest::Inside;
+    // Rasterised into the occlusion buffer (MeshComponent::Occluder), and the
+    // result of testing against it (OcclusionCuller::Finish): an occluded
+    // object is skipped by the scene pass but still casts shadows.
+    bool Occluder = false;
+    bool Occluded = false;
+    u32 FirstItem = 0;
+    u32 ItemCount = 0;
+};
+
+struct RenderItem
+{
+    u32 Object = 0;       // index into RenderList::Objects
+    u32 SubmeshIndex = 0; // index into the mesh's Submeshes() (0 when it has none)
+    u32 BaseIndex = 0;    // absolute index range drawn (at the object's Lod)
+    u32 IndexCount = 0;
+    Ref<MaterialAsset> Material;
+    bgfx::ProgramHandle Program = BGFX_INVALID_HANDLE; // the material's program
+    // Submission order, ascending. Packs layer | translucent | then, for opaque
+    // draws, program | material | mesh | submesh | lod | front-to-back depth, and
+    // for translucent ones back-to-front depth | program | material. Identical
+    // opaque (mesh, submesh, lod, material) draws sort adjacent, forming
+    // instancing runs.
+    u64 SortKey = 0;
+};
+
+struct RenderList
+{
+    std::vector<RenderObject> Objects;
+    std::vector<RenderItem> Items;
+
+    void Clear()
+    {
+        Objects.clear();
+        Items.clear();
+    }
+};
+
+} // namespace Seraph
@@ -6,8 +6,9 @@
 // across the editor and runtime layers, and centralizes the reversed-Z clear
 // convention (depth clears to 0.0).
 //
-// This is intentionally a thin, explicit descriptor, not an auto-scheduling
-// render graph: layers still decide pass order (by view id) and submit geometry.
+// This is intentionally a thin, explicit descriptor. The per-frame passes are
+// scheduled by RenderGraph, which assigns their view ids; RenderPass remains
+// for fixed-id views outside the graph (e.g. the one-time EnvBake pass).
 //
 
 #pragma once
@@ -5,11 +5,31 @@
 
 #include "RenderSystem.h"
 
+#include "Renderer.h"
+#include "RenderTarget.h"
+#include "Seraph/Core/Log.h"
 #include "Seraph/Settings/Settings.h"
 
+#include <utility>
+
 namespace Seraph
 {
 
+namespace
+{
+SceneUpscaleFn s_Upscaler;
+
+u64 MsaaLevel(AntiAliasingMode mode)
+{
+    switch (mode) {
+        case AntiAliasingMode::MSAA2x: return BGFX_TEXTURE_RT_MSAA_X2;
+        case AntiAliasingMode::MSAA4x: return BGFX_TEXTURE_RT_MSAA_X4;
+        case AntiAliasingMode::MSAA8x: return BGFX_TEXTURE_RT_MSAA_X8;
+        default: return 0;
+    }
+}
+} // namespace
+
 ProjectGraphicsSettings& RenderSystem::GetSettings()
 {
     static ProjectGraphicsSettings s;
@@ -31,6 +51,37 @@ void RenderSystem::RegisterSettings()
         .Tooltip("Linear exposure multiplier applied before tone mapping")
         .Min(0.0f).Max(16.0f);
 
+    Settings::Register("engine.graphics.antiAliasing")
+        .Bind(&s.AntiAliasing).Scope(SettingScope::Project)
+        .Section("Graphics").Display("Anti-Aliasing")
+        .Tooltip("None, FXAA on the tone-mapped image, or MSAA on the HDR scene target "
+                 "(memory and bandwidth grow with the sample count)");
+
+    Settings::Register("engine.graphics.dynamicResolution")
+        .Bind(&s.DynamicResolutionEnabled).Scope(SettingScope::Project)
+        .Section("Graphics").Display("Dynamic Resolution")
+        .Tooltip("Lower the scene resolution when the GPU misses the target frame time, "
+                 "and raise it again when there is headroom");
+
+    Settings::Register("engine.graphics.targetFrameTime")
+        .Bind(&s.TargetFrameTime).Scope(SettingScope::Project)
+        .Section("Graphics").Display("Target Frame Time (ms)")
+        .Tooltip("GPU time per frame dynamic resolution aims for (16.6 ms = 60 fps)")
+        .Min(1.0f).Max(100.0f);
+
+    Settings::Register("engine.graphics.minResolutionScale")
+        .Bind(&s.MinResolutionScale).Scope(SettingScope::Project)
+        .Section("Graphics").Display("Min Resolution Scale")
+        .Tooltip("Lowest scene resolution dynamic resolution may pick, per axis")
+        .Min(0.25f).Max(1.0f);
+
+    Settings::Register("engine.graphics.maxResolutionScale")
+        .Bind(&s.MaxResolutionScale).Scope(SettingScope::Project)
+        .Section("Graphics").Display("Max Resolution Scale")
+        .Tooltip("Highest scene resolution, per axis; the fixed scale when dynamic "
+                 "resolution is off")
+        .Min(0.25f).Max(1.0f);
+
     Settings::Register("engine.graphics.shadowBias")
         .Bind(&s.ShadowBias).Scope(SettingScope::Project)
         .Section("Graphics").Display("Shadow Bias")
@@ -42,6 +93,83 @@ void RenderSystem::RegisterSettings()
         .Section("Graphics").Display("Shadow Normal Offset")
         .Tooltip("Extra offset along the surface normal (world units) to reduce shadow acne")
         .Min(0.0f).Max(1.0f);
+
+    Settings::Register("engine.graphics.meshImportFormat")
+        .Bind(&s.MeshImportFormat).Scope(SettingScope::Project)
+        .Section("Graphics").Display("Mesh Import Format")
+        .Tooltip("Vertex format for imported meshes: full float (lossless), compressed "
+                 "normals/tangents/UVs, or also positions quantized to the mesh bounds");
+
+    Settings::Register("engine.graphics.meshImport32BitIndices")
+        .Bind(&s.MeshImport32BitIndices).Scope(SettingScope::Project)
+        .Section("Graphics").Display("32-bit Mesh Indices")
+        .Tooltip("Import meshes with 32-bit indices instead of splitting sources past "
+                 "65535 vertices into 16-bit submeshes");
+}
+
+RenderGraphTargetDesc RenderSystem::SceneColorDesc(u32 width, u32 height)
+{
+    // Called every frame; the caps are fixed once bgfx is up, so resolve the
+    // format (and log its fallback warning) only on the first call.
+    static const bgfx::TextureFormat::Enum format = HDRColorFormat();
+    u64 msaa = MsaaLevel(GetSettings().AntiAliasing);
+    if (!MsaaSupported(format, msaa)) {
+        static u64 s_Warned = 0;
+        if (s_Warned != msaa) {
+            SP_CORE_WARN_TAG("Renderer", "{}x MSAA is not supported for the scene target; "
+                             "rendering without anti-aliasing", MsaaSamples(msaa));
+            s_Warned = msaa;
+        }
+        msaa = 0;
+    }
+    return {width, height, format, msaa};
+}
+
+void RenderSystem::AddResolvePasses(RenderGraph& graph, RenderGraphResource hdr,
+                                    RenderGraphResource output, f32 scale)
+{
+    if (scale < 1.0f && s_Upscaler) {
+        RenderGraphTargetDesc desc = graph.GetDesc(hdr);
+        desc.Msaa = 0;
+        const RenderGraphResource upscaled = graph.CreateTarget("SceneUpscaled", desc);
+        graph.AddPass("Upscale", [hdr, scale, upscaler = s_Upscaler](
+                                     const RenderGraphPassContext& pass) {
+                upscaler(pass, pass.Texture(hdr), scale);
+            })
+            .Read(hdr)
+            .Write(upscaled);
+        hdr = upscaled;
+        scale = 1.0f;
+    }
+
+    const bool fxaa = GetSettings().AntiAliasing == AntiAliasingMode::FXAA;
+    RenderGraphResource tonemapped = output;
+    if (fxaa) {
+        const RenderGraphTargetDesc desc = graph.GetDesc(output);
+        tonemapped = graph.CreateTarget("SceneLDR", {desc.Width, desc.Height});
+    }
+
+    graph.AddPass("Tonemap", [hdr, scale](const RenderGraphPassContext& pass) {
+            const ProjectGraphicsSettings& gs = GetSettings();
+            Renderer::TonemapResolve(pass.ViewId, pass.Texture(hdr),
+                gs.Exposure, static_cast<int>(gs.Tonemap), scale, pass.Width, pass.Height);
+        })
+        .Read(hdr)
+        .Write(tonemapped);
+
+    if (fxaa) {
+        graph.AddPass("FXAA", [tonemapped](const RenderGraphPassContext& pass) {
+                Renderer::FxaaResolve(pass.ViewId, pass.Texture(tonemapped),
+                    pass.Width, pass.Height);
+            })
+            .Read(tonemapped)
+            .Write(output);
+    }
+}
+
+void RenderSystem::SetUpscaler(SceneUpscaleFn upscaler)
+{
+    s_Upscaler = std::move(upscaler);
 }
 
 } // namespace Seraph
@@ -5,17 +5,21 @@
 // settings ownership.
 //
 // This is the first slice of RenderingBoard "Render 37 — ProjectGraphicsSettings":
-// it currently carries the HDR tonemap resolve knobs. Render 37 expands the same
-// struct + RegisterSettings() with renderer path, HDR/MSAA/AA, shadows, VSync,
-// upscaling, and quality tiers. Per-scene look overrides (exposure/tonemap as an
+// it currently carries the HDR tonemap resolve, anti-aliasing and dynamic
+// resolution knobs, and builds the resolve passes they drive. Render 37 expands the same struct +
+// RegisterSettings() with renderer path, shadows, VSync, upscaling, and quality
+// tiers. Per-scene look overrides (exposure/tonemap as an
 // artist-authored mood) later move to SceneEnvironmentSettings ("Render 34").
 //
 
 #pragma once
 
+#include "RenderGraph.h"
 #include "Seraph/Core/Base.h"
 #include "Seraph/Reflection/Annotations.h"
 
+#include <functional>
+
 namespace Seraph
 {
 
@@ -28,11 +32,45 @@ enum class SENUM() TonemapOperator : u8
     ACES     = 2,
 };
 
+// Scene anti-aliasing. The backbuffer is always single-sampled: MSAA multisamples
+// only the HDR scene target (bgfx resolves it before the tonemap pass reads it),
+// FXAA is a post pass over the tone-mapped LDR image, and None pays for neither.
+enum class SENUM() AntiAliasingMode : u8
+{
+    None   = 0,
+    FXAA   = 1,
+    MSAA2x = 2,
+    MSAA4x = 3,
+    MSAA8x = 4,
+};
+
+// Vertex format the mesh importer (Assimp path) writes. The compressed formats
+// octahedral-encode normals (2 x snorm16) and tangents (unorm8, handedness in
+// z) and store UVs as half floats; Quantized also stores positions as snorm16
+// relative to the mesh bounds. Vertex shaders decode them through
+// shader/vertex.sh, driven by the per-draw u_meshDecode uniform.
+enum class SENUM() MeshVertexFormat : u8
+{
+    Float      = 0, // 52 bytes: every attribute 32-bit float (colour unorm8)
+    Compressed = 1, // 28 bytes: float positions
+    Quantized  = 2, // 24 bytes: positions quantized to the mesh bounds
+};
+
 struct ProjectGraphicsSettings
 {
     TonemapOperator Tonemap  = TonemapOperator::ACES;
     f32             Exposure = 1.0f; // linear multiplier applied before tone mapping
 
+    AntiAliasingMode AntiAliasing = AntiAliasingMode::FXAA;
+
+    // Dynamic resolution (see DynamicResolution.h): the scene renders at a
+    // fraction of the output picked each frame to hold TargetFrameTime. Off, it
+    // renders at MaxResolutionScale.
+    bool DynamicResolutionEnabled = false;
+    f32  TargetFrameTime          = 16.6f; // milliseconds of GPU time per frame
+    f32  MinResolutionScale       = 0.5f;  // per axis, of the output size
+    f32  MaxResolutionScale       = 1.0f;
+
     // Directional-shadow anti-acne, in WORLD units (the renderer converts the bias
     // into the shadow projection's normalized depth by dividing by its depth range,
     // so the contact gap stays a fixed small distance regardless of the ortho).
@@ -41,8 +79,23 @@ struct ProjectGraphicsSettings
     // offset defaults to 0 — the depth bias alone handles acne here.
     f32 ShadowBias         = 0.03f; // world units of depth bias
     f32 ShadowNormalOffset = 0.0f;  // world units along the surface normal
+
+    // Layout newly imported meshes are converted to. Already-imported .smesh
+    // files keep the format they were saved with. Compressed and Quantized are
+    // lossy, so projects opt into them.
+    MeshVertexFormat MeshImportFormat = MeshVertexFormat::Float;
+    // Import with 32-bit indices. Off, sources past 65535 vertices are split
+    // into several 16-bit submeshes (half the index bandwidth); on, every mesh
+    // is imported with 32-bit indices instead.
+    bool MeshImport32BitIndices = false;
 };
 
+// Upscales a dynamic-resolution scene: samples the top-left `scale` fraction of
+// `source` (DynamicResolution::ScaledSize pixels per axis) and fills the whole
+// of the pass's (full-size HDR) target.
+using SceneUpscaleFn =
+    std::function<void(const RenderGraphPassContext& pass, bgfx::TextureHandle source, f32 scale)>;
+
 class RenderSystem
 {
 public:
@@ -54,6 +107,23 @@ public:
     // "Graphics" section). Call once at engine init, alongside the other
     // RegisterSettings hooks.
     static void RegisterSettings();
+
+    // The HDR scene target for a width x height output: HDRColorFormat(),
+    // multisampled when AntiAliasing picks an MSAA level the GPU supports.
+    [[nodiscard]] static RenderGraphTargetDesc SceneColorDesc(u32 width, u32 height);
+
+    // Declare the passes resolving the scene target `hdr`, of which the scene
+    // covered the top-left `scale` fraction, into `output`: the upscale (when an
+    // upscaler is installed and scale < 1), the tonemap resolve (which upscales
+    // bilinearly otherwise), then FXAA through a transient LDR target when
+    // enabled. They overwrite every pixel of `output`, so it needs no clear.
+    static void AddResolvePasses(RenderGraph& graph, RenderGraphResource hdr,
+                                 RenderGraphResource output, f32 scale = 1.0f);
+
+    // Install the upscaler for dynamic-resolution frames, run as an "Upscale"
+    // pass ahead of the tonemap. Empty (the default) keeps the tonemap's
+    // bilinear upscale.
+    static void SetUpscaler(SceneUpscaleFn upscaler);
 };
 
 } // namespace Seraph
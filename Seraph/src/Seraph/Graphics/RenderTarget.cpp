@@ -31,19 +31,41 @@ bgfx::TextureFormat::Enum HDRColorFormat()
     return bgfx::TextureFormat::RGBA8;
 }
 
-void RenderTarget::Create(u32 w, u32 h, bgfx::TextureFormat::Enum colorFmt)
+bool MsaaSupported(bgfx::TextureFormat::Enum colorFormat, u64 msaa)
+{
+    if (MsaaSamples(msaa) == 1)
+        return true;
+    const bgfx::Caps* caps = bgfx::getCaps();
+    const u32 required = BGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER_MSAA;
+    return (caps->formats[colorFormat] & required) != 0 &&
+           (caps->formats[bgfx::TextureFormat::D24S8] & required) != 0;
+}
+
+u32 MsaaSamples(u64 msaa)
+{
+    // RT_MSAA_X2 is level 2, X4 level 3, ... (level 1 is plain BGFX_TEXTURE_RT).
+    const u64 level = (msaa & BGFX_TEXTURE_RT_MSAA_MASK) >> BGFX_TEXTURE_RT_MSAA_SHIFT;
+    return level > 1 ? 1u << (level - 1) : 1u;
+}
+
+void RenderTarget::Create(u32 w, u32 h, bgfx::TextureFormat::Enum colorFmt, u64 msaaLevel)
 {
     width       = w;
     height      = h;
     colorFormat = colorFmt;
+    msaa        = MsaaSamples(msaaLevel) > 1 ? msaaLevel & BGFX_TEXTURE_RT_MSAA_MASK : 0;
+
+    // The RT_MSAA_X* levels share BGFX_TEXTURE_RT's bit field and imply it.
+    const u64 rt = msaa != 0 ? msaa : BGFX_TEXTURE_RT;
 
     bgfx::TextureHandle attachments[2];
 
-    // Color — point-sampled, clamp to edge.
+    // Color — point-sampled, clamp to edge. With MSAA, bgfx keeps the samples in
+    // a renderbuffer and this texture receives the resolve.
     attachments[0] = bgfx::createTexture2D(
         (u16)w, (u16)h, false, 1,
         colorFormat,
-        BGFX_TEXTURE_RT |
+        rt |
         BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP |
         BGFX_SAMPLER_MIN_POINT | BGFX_SAMPLER_MAG_POINT);
 
@@ -51,7 +73,7 @@ void RenderTarget::Create(u32 w, u32 h, bgfx::TextureFormat::Enum colorFmt)
     attachments[1] = bgfx::createTexture2D(
         (u16)w, (u16)h, false, 1,
         bgfx::TextureFormat::D24S8,
-        BGFX_TEXTURE_RT | BGFX_TEXTURE_RT_WRITE_ONLY);
+        rt | BGFX_TEXTURE_RT_WRITE_ONLY);
 
     // destroyTextures=true: bgfx owns the attachment handles.
     fb    = bgfx::createFrameBuffer(2, attachments, true);
@@ -66,13 +88,15 @@ void RenderTarget::Destroy()
         color = BGFX_INVALID_HANDLE;
     }
     width = height = 0;
+    msaa = 0;
 }
 
 void RenderTarget::Resize(u32 w, u32 h)
 {
     const bgfx::TextureFormat::Enum fmt = colorFormat;
+    const u64 level = msaa;
     Destroy();
-    Create(w, h, fmt);
+    Create(w, h, fmt, level);
 }
 
 } // namespace Seraph
@@ -1,8 +1,12 @@
 //
 // Offscreen render target: a bgfx framebuffer with one color attachment and one
 // D24S8 depth attachment. The color format is selectable (default RGBA8 LDR; use
-// HDRColorFormat() for an RGBA16F/RG11B10F HDR scene target). Destroy() and
-// Resize() are safe to call on an invalid (default-constructed) instance.
+// HDRColorFormat() for an RGBA16F/RG11B10F HDR scene target). `msaa` takes a
+// BGFX_TEXTURE_RT_MSAA_X* level (0 = single-sampled): both attachments are then
+// multisampled and bgfx resolves the color into a sampleable texture when the
+// view that rendered it ends, so `color` always samples the resolved image.
+// Destroy() and Resize() are safe to call on an invalid (default-constructed)
+// instance.
 //
 
 #pragma once
@@ -16,9 +20,17 @@ namespace Seraph
 
 // Best-supported HDR color format for an offscreen render target: prefers
 // RGBA16F, falls back to RG11B10F, then RGBA8 if neither is framebuffer-capable.
-// Must be called after bgfx::init (queries caps).
+// Must be called after bgfx::init (queries caps). Warns on every RGBA8 fallback,
+// so per-frame callers should cache the result.
 bgfx::TextureFormat::Enum HDRColorFormat();
 
+// Whether a `colorFormat` target (plus its D24S8 depth) can be rendered with the
+// BGFX_TEXTURE_RT_MSAA_X* level `msaa`. Must be called after bgfx::init.
+bool MsaaSupported(bgfx::TextureFormat::Enum colorFormat, u64 msaa);
+
+// Samples per pixel of a BGFX_TEXTURE_RT_MSAA_X* level (1 when 0).
+u32 MsaaSamples(u64 msaa);
+
 struct RenderTarget
 {
     bgfx::FrameBufferHandle   fb          = BGFX_INVALID_HANDLE;
@@ -26,10 +38,12 @@ struct RenderTarget
     u32                       width       = 0;
     u32                       height      = 0;
     bgfx::TextureFormat::Enum colorFormat = bgfx::TextureFormat::RGBA8;
+    u64                       msaa        = 0; // BGFX_TEXTURE_RT_MSAA_X*, 0 = off
 
-    void Create(u32 w, u32 h, bgfx::TextureFormat::Enum colorFormat = bgfx::TextureFormat::RGBA8);
+    void Create(u32 w, u32 h, bgfx::TextureFormat::Enum colorFormat = bgfx::TextureFormat::RGBA8,
+                u64 msaa = 0);
     void Destroy();
-    void Resize(u32 w, u32 h); // recreates with the stored colorFormat
+    void Resize(u32 w, u32 h); // recreates with the stored colorFormat and msaa
 
     bool IsValid() const { return bgfx::isValid(fb); }
 };
@@ -6,11 +6,13 @@
 
 #include "Platform/Window.h"
 #include "Seraph/Asset/AssetManager.h"
+#include "Seraph/Console/AutoCVar.h"
 #include "Seraph/Core/Application.h"
 #include "Seraph/Core/Assert.h"
 #include "Seraph/Core/Base.h"
 #include "Seraph/Core/Core.h"
 #include "Seraph/Graphics/Camera.h"
+#include "Seraph/Graphics/DynamicResolution.h"
 #include "Seraph/Graphics/Material/Material.h"
 #include "Seraph/Graphics/Material/UniformCache.h"
 #include "Seraph/Graphics/Mesh.h"
@@ -27,6 +29,7 @@
 #include <bx/string.h>
 
 #include <cstdarg>
+#include <cstring>
 #include <string_view>
 
 namespace Seraph
@@ -153,13 +156,19 @@ BgfxCallback s_BgfxCallback;
 
 } // namespace
 
+SP_CVAR(CVarRenderThread, bool, "r.renderThread", false, CVarFlag_Archive,
+        "Run bgfx on its own render thread (applies on the next launch)");
+
 struct RenderData
 {
     u16 currentViewId;
     u32 windowWidth;
     u32 windowHeight;
-    u32 resetFlags = BGFX_RESET_VSYNC | BGFX_RESET_MSAA_X4;
+    // No MSAA: the backbuffer only receives fullscreen resolves and UI. Scene
+    // anti-aliasing lives on the HDR target or in the FXAA pass (AntiAliasingMode).
+    u32 resetFlags = BGFX_RESET_VSYNC;
     u32 frameNumber = 0; // last bgfx::frame() return; see Renderer::FrameNumber
+    bool renderThread = false; // bgfx owns a render thread (Renderer::Init)
 
     void EndFrame()
     {
@@ -173,6 +182,11 @@ static RenderData s_RenderData;
 // here so Cleanup can destroy them before bgfx::shutdown.
 static bgfx::UniformHandle s_TonemapSampler = BGFX_INVALID_HANDLE; // s_hdr
 static bgfx::UniformHandle s_TonemapParams  = BGFX_INVALID_HANDLE; // u_tonemapParams
+static bgfx::UniformHandle s_TonemapRegion  = BGFX_INVALID_HANDLE; // u_tonemapRegion
+
+// Lazily-created FXAA uniforms (destroyed in Cleanup before bgfx::shutdown).
+static bgfx::UniformHandle s_FxaaSampler    = BGFX_INVALID_HANDLE; // s_ldr
+static bgfx::UniformHandle s_FxaaParams     = BGFX_INVALID_HANDLE; // u_fxaaParams
 
 // Lazily-created skybox uniforms (destroyed in Cleanup before bgfx::shutdown).
 static bgfx::UniformHandle s_SkyCube        = BGFX_INVALID_HANDLE; // s_skyCube
@@ -186,12 +200,15 @@ static bgfx::UniformHandle s_SkyParams      = BGFX_INVALID_HANDLE; // u_skyParam
 static bgfx::TextureHandle     s_BrdfLut   = BGFX_INVALID_HANDLE;
 static bgfx::FrameBufferHandle s_BrdfLutFb = BGFX_INVALID_HANDLE;
 
-// IBL environment bound for the current frame's mesh submits, plus the samplers
-// + params uniform the PBR shader reads. s_EnvActive gates the shader's IBL term
-// vs the flat ambient fallback. A 1x1 white cube stands in for the environment
-// cubes when no IBL is active, so the cube samplers always have a valid binding.
-static Renderer::EnvironmentBinding s_Env{};
-static bool                s_EnvActive     = false;
+// Engine bindings (IBL environment, shadow cascades, light grid) as last set on
+// the main thread. MakeContext snapshots them; submits only read their context's
+// copy, never these.
+static Renderer::EngineBindings s_Bindings{};
+
+// IBL samplers + params uniform the PBR shader reads. environmentActive gates the
+// shader's IBL term vs the flat ambient fallback. A 1x1 white cube stands in for
+// the environment cubes when no IBL is active, so the cube samplers always have a
+// valid binding.
 static bgfx::TextureHandle s_WhiteCube     = BGFX_INVALID_HANDLE;
 static bgfx::UniformHandle s_IblIrrSampler = BGFX_INVALID_HANDLE; // s_texCubeIrr
 static bgfx::UniformHandle s_IblRadSampler = BGFX_INVALID_HANDLE; // s_texCube
@@ -200,21 +217,15 @@ static bgfx::UniformHandle s_IblParams     = BGFX_INVALID_HANDLE; // u_iblParams
 
 // Cascaded shadow maps (Render 21): the four cascades share one depth texture as
 // a 2x2 atlas (cascade i -> quadrant), rendered from the sun's per-cascade ortho
-// and sampled with hardware compare in the scene pass. s_ShadowActive gates the
-// shader term; s_ShadowMtx[i] maps world -> that cascade's [0,1] UV + depth.
+// and sampled with hardware compare in the scene pass. The cascade state itself
+// lives in s_Bindings.shadow (Renderer::ShadowBinding).
 constexpr uint16_t kShadowAtlasSize = 4096;               // full atlas
 constexpr uint16_t kShadowTileSize  = kShadowAtlasSize / 2; // per-cascade quadrant
 constexpr int      kMaxCascades     = 4;
+static_assert(kMaxCascades == sizeof(Renderer::ShadowBinding::shadowMtx) / sizeof(glm::mat4));
 
 static bgfx::TextureHandle     s_ShadowMap    = BGFX_INVALID_HANDLE;
 static bgfx::FrameBufferHandle s_ShadowFb     = BGFX_INVALID_HANDLE;
-static bool                s_ShadowActive     = false;
-static glm::mat4           s_ShadowMtx[kMaxCascades] = { glm::mat4(1.0f) };
-static glm::vec4           s_CsmBias(0.0f);       // per-cascade normalized depth bias
-static glm::vec4           s_CsmSplits(0.0f);     // cascade far view-depths + max dist (w)
-static glm::vec4           s_CsmForward(0.0f);    // camera forward (view-depth axis)
-static int                 s_ShadowCascadeCount = 0;
-static float               s_ShadowNormalOffset = 0.0f;
 static bgfx::UniformHandle s_ShadowSampler    = BGFX_INVALID_HANDLE; // s_shadowMap
 static bgfx::UniformHandle s_ShadowMtxUniform = BGFX_INVALID_HANDLE; // u_shadowMtx[4]
 static bgfx::UniformHandle s_CsmBiasUniform   = BGFX_INVALID_HANDLE; // u_csmBias
@@ -222,6 +233,29 @@ static bgfx::UniformHandle s_CsmSplitsUniform = BGFX_INVALID_HANDLE; // u_csmSpl
 static bgfx::UniformHandle s_CsmForwardUniform = BGFX_INVALID_HANDLE; // u_csmForward
 static bgfx::UniformHandle s_ShadowParams     = BGFX_INVALID_HANDLE; // u_shadowParams
 
+// Cached cascades: the static-caster atlas, same layout as s_ShadowMap but
+// point-sampled (ComposeStaticShadow reads raw depth). s_ShadowAtlasOwner is
+// whoever last claimed both atlases' persistent contents (ClaimShadowAtlas).
+static bgfx::TextureHandle     s_StaticShadowMap = BGFX_INVALID_HANDLE;
+static bgfx::FrameBufferHandle s_StaticShadowFb  = BGFX_INVALID_HANDLE;
+static const void*             s_ShadowAtlasOwner = nullptr;
+static bgfx::UniformHandle s_ShadowStaticSampler = BGFX_INVALID_HANDLE; // s_shadowStatic
+static bgfx::UniformHandle s_ShadowCopyParams    = BGFX_INVALID_HANDLE; // u_shadowCopyParams
+
+// Clustered light list samplers (SetLightGrid). Like the environment, white
+// fallbacks keep stages 9-11 valid while it is cleared; u_clusterParams.w = 0
+// then tells the PBR shader to skip direct lighting.
+static bgfx::UniformHandle s_LightDataSampler   = BGFX_INVALID_HANDLE; // s_lightData
+static bgfx::UniformHandle s_LightGridSampler   = BGFX_INVALID_HANDLE; // s_lightGrid
+static bgfx::UniformHandle s_LightIndexSampler  = BGFX_INVALID_HANDLE; // s_lightIndices
+static bgfx::UniformHandle s_ClusterParams      = BGFX_INVALID_HANDLE; // u_clusterParams
+
+// Per-draw mesh vertex decode (shader/vertex.sh): [0] position scale + w
+// octahedral normals flag, [1] position offset. Created in Init (shadow casters
+// bind it from worker encoders).
+static bgfx::UniformHandle s_MeshDecode = BGFX_INVALID_HANDLE; // u_meshDecode[2]
+
+
 // Atlas pixel origin of cascade i's quadrant (2x2 layout, matches the shader's
 // CascadeTileOffset UV mapping).
 static void CascadeTilePixel(int cascade, uint16_t& x, uint16_t& y)
@@ -241,9 +275,30 @@ static bgfx::TextureHandle EnsureShadowMap()
         BGFX_TEXTURE_RT | BGFX_SAMPLER_COMPARE_LEQUAL |
         BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP);
     s_ShadowFb = bgfx::createFrameBuffer(1, &s_ShadowMap, false);
+    s_ShadowAtlasOwner = nullptr;
     return s_ShadowMap;
 }
 
+// The static-caster atlas, created on the first cached cascade (Cleanup frees it).
+static bgfx::TextureHandle EnsureStaticShadowMap()
+{
+    if (bgfx::isValid(s_StaticShadowMap))
+        return s_StaticShadowMap;
+    s_StaticShadowMap = bgfx::createTexture2D(
+        kShadowAtlasSize, kShadowAtlasSize, false, 1, bgfx::TextureFormat::D16,
+        BGFX_TEXTURE_RT | BGFX_SAMPLER_POINT | BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP);
+    s_StaticShadowFb = bgfx::createFrameBuffer(1, &s_StaticShadowMap, false);
+    s_ShadowAtlasOwner = nullptr;
+    return s_StaticShadowMap;
+}
+
+static u16 ShadowView(int cascade, Renderer::ShadowAtlas atlas)
+{
+    return static_cast<u16>(
+        (atlas == Renderer::ShadowAtlas::Static ? ViewId::ShadowStatic : ViewId::Shadow) +
+        cascade);
+}
+
 static void EnsureShadowUniforms()
 {
     if (!bgfx::isValid(s_ShadowSampler))
@@ -258,26 +313,27 @@ static void EnsureShadowUniforms()
         s_CsmForwardUniform = bgfx::createUniform("u_csmForward", bgfx::UniformType::Vec4);
     if (!bgfx::isValid(s_ShadowParams))
         s_ShadowParams = bgfx::createUniform("u_shadowParams", bgfx::UniformType::Vec4);
+    if (!bgfx::isValid(s_ShadowStaticSampler))
+        s_ShadowStaticSampler = bgfx::createUniform("s_shadowStatic", bgfx::UniformType::Sampler);
+    if (!bgfx::isValid(s_ShadowCopyParams))
+        s_ShadowCopyParams = bgfx::createUniform("u_shadowCopyParams", bgfx::UniformType::Vec4);
 }
 
-// Bind the shadow atlas + per-cascade matrices + params for the current submesh
-// (per submesh because DISCARD_ALL clears bindings). The atlas is always bound
-// (created lazily) so stage 8 is valid even when inactive; u_shadowParams.z = 0
-// disables the term.
-static void BindShadow()
+// Set the per-cascade matrices + params (once per view, or per submesh outside
+// view bindings). The atlas is always bound on stage 8 (see ResolveEngineTextures)
+// so it is valid even when inactive; u_shadowParams.z = 0 disables the term.
+static void BindShadow(bgfx::Encoder* encoder, const Renderer::ShadowBinding& shadow)
 {
-    EnsureShadowUniforms();
-    bgfx::setTexture(8, s_ShadowSampler, EnsureShadowMap());
-    bgfx::setUniform(s_ShadowMtxUniform, glm::value_ptr(s_ShadowMtx[0]), kMaxCascades);
-    bgfx::setUniform(s_CsmBiasUniform, glm::value_ptr(s_CsmBias));
-    bgfx::setUniform(s_CsmSplitsUniform, glm::value_ptr(s_CsmSplits));
-    bgfx::setUniform(s_CsmForwardUniform, glm::value_ptr(s_CsmForward));
+    encoder->setUniform(s_ShadowMtxUniform, glm::value_ptr(shadow.shadowMtx[0]), kMaxCascades);
+    encoder->setUniform(s_CsmBiasUniform, glm::value_ptr(shadow.bias));
+    encoder->setUniform(s_CsmSplitsUniform, glm::value_ptr(shadow.splits));
+    encoder->setUniform(s_CsmForwardUniform, glm::value_ptr(shadow.forward));
     const float params[4] = {
         1.0f / static_cast<float>(kShadowAtlasSize),
-        static_cast<float>(s_ShadowCascadeCount),
-        s_ShadowActive ? 1.0f : 0.0f, s_ShadowNormalOffset
+        static_cast<float>(shadow.cascadeCount),
+        shadow.active ? 1.0f : 0.0f, shadow.normalOffset
     };
-    bgfx::setUniform(s_ShadowParams, params);
+    encoder->setUniform(s_ShadowParams, params);
 }
 
 // Shared 1x1 white cube fallback (all six faces white), created on first use.
@@ -308,37 +364,42 @@ static void EnsureIblUniforms()
         s_IblParams = bgfx::createUniform("u_iblParams", bgfx::UniformType::Vec4);
 }
 
-// Bind the IBL samplers + params for the current submesh. Called before every
-// material bind because BGFX_DISCARD_ALL clears bindings per submesh. When no
-// environment is active, neutral fallbacks are bound and u_iblParams.w = 0 tells
-// the PBR shader to use the flat ambient term instead.
-static void BindEnvironment()
+// Set the IBL params (once per view, or per submesh outside view bindings).
+// When no environment is active, neutral fallbacks are bound on its stages and
+// u_iblParams.w = 0 tells the PBR shader to use the flat ambient term instead.
+static void BindEnvironment(bgfx::Encoder* encoder, const Renderer::EngineBindings& bindings)
 {
-    EnsureIblUniforms();
-
-    const bool active = s_EnvActive;
-    const bgfx::TextureHandle irr = active ? s_Env.irradiance : WhiteCube();
-    const bgfx::TextureHandle rad = active ? s_Env.radiance : WhiteCube();
-    const bgfx::TextureHandle lut =
-        active ? s_Env.brdfLut : Texture2D::GetDefaultWhite()->Handle();
-
-    bgfx::setTexture(5, s_IblIrrSampler, irr);
-    bgfx::setTexture(6, s_IblRadSampler, rad);
-    bgfx::setTexture(7, s_IblLutSampler, lut);
-
+    const Renderer::EnvironmentBinding& env = bindings.environment;
     const float params[4] = {
-        s_Env.intensity, s_Env.rotationYaw, s_Env.radianceMips,
-        active ? 1.0f : 0.0f
+        env.intensity, env.rotationYaw, env.radianceMips,
+        bindings.environmentActive ? 1.0f : 0.0f
     };
-    bgfx::setUniform(s_IblParams, params);
+    encoder->setUniform(s_IblParams, params);
 }
 
-void Renderer::Init()
+void Renderer::Init(bool renderThread)
 {
     s_RenderData = {};
 
-    // Signal to bgfx that we want multithreaded rendering
-    bgfx::renderFrame();
+    renderThread = renderThread || CVarRenderThread.Get();
+#if BX_PLATFORM_OSX
+    // AppKit/Metal layer setup must happen on the main thread, and bgfx's own
+    // render thread would be a secondary one. Running the game loop off the main
+    // thread instead is not supported here, so macOS stays single-threaded.
+    if (renderThread) {
+        SP_CORE_WARN_TAG("Renderer", "Render thread is not supported on macOS; rendering single-threaded");
+        renderThread = false;
+    }
+#endif
+
+    // Calling renderFrame() before init tells bgfx this thread IS the render
+    // thread: bgfx then renders inline in bgfx::frame(). Skipping it lets
+    // bgfx::init spawn its own render thread (BGFX_CONFIG_MULTITHREADED). Window
+    // and event ownership stay on this thread either way — bgfx's thread only
+    // touches the native handle through the graphics context.
+    if (!renderThread)
+        bgfx::renderFrame();
+    s_RenderData.renderThread = renderThread;
     auto& window = Application::Instance().Window();
 
     bgfx::PlatformData pd{};
@@ -387,7 +448,10 @@ void Renderer::Init()
     bgfx::setViewClear(0, BGFX_CLEAR_COLOR, 0x1A1C23FF, 0.0f, 0);
     bgfx::setViewRect(0, 0, 0, (u16)s_RenderData.windowWidth, (u16)s_RenderData.windowHeight);
 
-    SP_CORE_INFO_TAG("Renderer", "Backend: {}", bgfx::getRendererName(bgfx::getRendererType()));
+    s_MeshDecode = bgfx::createUniform("u_meshDecode", bgfx::UniformType::Vec4, 2);
+
+    SP_CORE_INFO_TAG("Renderer", "Backend: {} ({})", bgfx::getRendererName(bgfx::getRendererType()),
+        renderThread ? "render thread" : "single-threaded");
 }
 
 void Renderer::Cleanup()
@@ -402,6 +466,19 @@ void Renderer::Cleanup()
         bgfx::destroy(s_TonemapParams);
         s_TonemapParams = BGFX_INVALID_HANDLE;
     }
+    if (bgfx::isValid(s_TonemapRegion))
+    {
+        bgfx::destroy(s_TonemapRegion);
+        s_TonemapRegion = BGFX_INVALID_HANDLE;
+    }
+    for (bgfx::UniformHandle* h : { &s_FxaaSampler, &s_FxaaParams })
+    {
+        if (bgfx::isValid(*h))
+        {
+            bgfx::destroy(*h);
+            *h = BGFX_INVALID_HANDLE;
+        }
+    }
     for (bgfx::UniformHandle* h :
          { &s_SkyCube, &s_SkyInvViewProj, &s_SkyCameraPos, &s_SkyParams })
     {
@@ -430,6 +507,20 @@ void Renderer::Cleanup()
             *h = BGFX_INVALID_HANDLE;
         }
     }
+    for (bgfx::UniformHandle* h :
+         { &s_LightDataSampler, &s_LightGridSampler, &s_LightIndexSampler, &s_ClusterParams })
+    {
+        if (bgfx::isValid(*h))
+        {
+            bgfx::destroy(*h);
+            *h = BGFX_INVALID_HANDLE;
+        }
+    }
+    if (bgfx::isValid(s_MeshDecode))
+    {
+        bgfx::destroy(s_MeshDecode);
+        s_MeshDecode = BGFX_INVALID_HANDLE;
+    }
     if (bgfx::isValid(s_WhiteCube))
     {
         bgfx::destroy(s_WhiteCube);
@@ -437,7 +528,8 @@ void Renderer::Cleanup()
     }
     for (bgfx::UniformHandle* h :
          { &s_ShadowSampler, &s_ShadowMtxUniform, &s_CsmBiasUniform,
-           &s_CsmSplitsUniform, &s_CsmForwardUniform, &s_ShadowParams })
+           &s_CsmSplitsUniform, &s_CsmForwardUniform, &s_ShadowParams,
+           &s_ShadowStaticSampler, &s_ShadowCopyParams })
     {
         if (bgfx::isValid(*h))
         {
@@ -455,62 +547,252 @@ void Renderer::Cleanup()
         bgfx::destroy(s_ShadowMap);
         s_ShadowMap = BGFX_INVALID_HANDLE;
     }
+    if (bgfx::isValid(s_StaticShadowFb))
+    {
+        bgfx::destroy(s_StaticShadowFb);
+        s_StaticShadowFb = BGFX_INVALID_HANDLE;
+    }
+    if (bgfx::isValid(s_StaticShadowMap))
+    {
+        bgfx::destroy(s_StaticShadowMap);
+        s_StaticShadowMap = BGFX_INVALID_HANDLE;
+    }
+    s_ShadowAtlasOwner = nullptr;
 
     ShaderManager::Shutdown();
     UniformCache::Shutdown();
     bgfx::shutdown();
 }
 
-void Renderer::SubmitMesh(
-    const Mesh& mesh, const glm::mat4& transform,
-    const std::vector<AssetHandle>& materialOverrides)
+Ref<MaterialAsset> Renderer::ResolveMaterial(
+    const Mesh& mesh, u32 slot, const std::vector<AssetHandle>& materialOverrides)
 {
-    const bgfx::VertexBufferHandle vb = mesh.VertexBuffer();
-    const bgfx::IndexBufferHandle ib = mesh.IndexBuffer();
-    if (!bgfx::isValid(vb) || !bgfx::isValid(ib))
-        return;
+    if (slot < materialOverrides.size()) {
+        if (Ref<MaterialAsset> m = MaterialAsset::Get(materialOverrides[slot]))
+            return m;
+    }
+    if (Ref<MaterialAsset> m = MaterialAsset::Get(mesh.MaterialSlotDefault(slot)))
+        return m;
+    return Material::GetDefault();
+}
 
-    Ref<MaterialAsset> engineDefault = Material::GetDefault();
-    const u16 viewId = s_RenderData.currentViewId;
+// Null means the calling (main) thread's implicit encoder: bgfx::begin() on the
+// API thread returns it, so both paths record through the same Encoder API.
+static bgfx::Encoder* EncoderOrMain(bgfx::Encoder* encoder)
+{
+    return encoder ? encoder : bgfx::begin();
+}
 
-    // Resolve a material slot: per-entity override -> mesh baked default ->
-    // shared engine default.
-    const auto resolveSlot = [&](u32 slot) -> Ref<MaterialAsset> {
-        if (slot < materialOverrides.size()) {
-            if (Ref<MaterialAsset> m = MaterialAsset::Get(materialOverrides[slot]))
-                return m;
-        }
-        if (Ref<MaterialAsset> m = MaterialAsset::Get(mesh.MaterialSlotDefault(slot)))
-            return m;
-        return engineDefault;
+static void EnsureLightGridUniforms()
+{
+    if (!bgfx::isValid(s_LightDataSampler))
+        s_LightDataSampler = bgfx::createUniform("s_lightData", bgfx::UniformType::Sampler);
+    if (!bgfx::isValid(s_LightGridSampler))
+        s_LightGridSampler = bgfx::createUniform("s_lightGrid", bgfx::UniformType::Sampler);
+    if (!bgfx::isValid(s_LightIndexSampler))
+        s_LightIndexSampler = bgfx::createUniform("s_lightIndices", bgfx::UniformType::Sampler);
+    if (!bgfx::isValid(s_ClusterParams))
+        s_ClusterParams = bgfx::createUniform("u_clusterParams", bgfx::UniformType::Vec4);
+}
+
+// Set the light grid slice params (once per view, or per submesh outside view
+// bindings). u_clusterParams.z is the target height where gl_FragCoord.y runs up
+// from the bottom (GL), 0 where it runs down like u_viewRect, so screen tiles
+// line up with the CPU's NDC binning under any view rect.
+static void BindLightGrid(bgfx::Encoder* encoder, const Renderer::EngineBindings& bindings)
+{
+    const Renderer::LightGridBinding& grid = bindings.lightGrid;
+    const float params[4] = {
+        grid.sliceScale, grid.sliceBias,
+        bgfx::getCaps()->originBottomLeft ? grid.targetHeight : 0.0f,
+        bindings.lightGridActive ? 1.0f : 0.0f
     };
+    encoder->setUniform(s_ClusterParams, params);
+}
 
-    // Draw one index range per submesh. The material binds state + uniforms; the
-    // renderer issues the submit. DISCARD_ALL clears bindings between submeshes.
-    const auto drawRange = [&](u32 firstIndex, u32 indexCount, Ref<MaterialAsset> material) {
-        if (!material)
-            return;
-        bgfx::setTransform(glm::value_ptr(transform));
-        bgfx::setVertexBuffer(0, vb);
-        bgfx::setIndexBuffer(ib, firstIndex, indexCount);
-        // Bind IBL + shadow before the material: per-submesh because DISCARD_ALL
-        // clears bindings, and before Bind() so a material never overwrites the
-        // engine sampler stages (IBL 5-7, shadow 8).
-        BindEnvironment();
-        BindShadow();
-        material->Bind();
-        bgfx::submit(viewId, material->Program(), 0, BGFX_DISCARD_ALL);
+// The texture each engine sampler stage (IBL 5-7, shadow 8, light grid 9-11)
+// samples under `bindings`, with white fallbacks for inactive state. Creates the
+// engine sampler uniforms on first use (main thread).
+static void ResolveEngineTextures(
+    const Renderer::EngineBindings& bindings, bgfx::TextureHandle* textures)
+{
+    EnsureIblUniforms();
+    EnsureShadowUniforms();
+    EnsureLightGridUniforms();
+
+    const bgfx::TextureHandle white = Texture2D::GetDefaultWhite()->Handle();
+    const Renderer::EnvironmentBinding& env = bindings.environment;
+    const bool envActive = bindings.environmentActive;
+    textures[0] = envActive ? env.irradiance : WhiteCube();
+    textures[1] = envActive ? env.radiance : WhiteCube();
+    textures[2] = envActive ? env.brdfLut : white;
+    textures[3] = EnsureShadowMap();
+    const Renderer::LightGridBinding& grid = bindings.lightGrid;
+    const bool gridActive = bindings.lightGridActive;
+    textures[4] = gridActive ? grid.lightData : white;
+    textures[5] = gridActive ? grid.grid : white;
+    textures[6] = gridActive ? grid.indices : white;
+}
+
+// Bind resolved engine textures (ResolveEngineTextures) on their stages.
+static void BindEngineTextures(bgfx::Encoder* encoder, const bgfx::TextureHandle* textures)
+{
+    const bgfx::UniformHandle samplers[Renderer::c_EngineStageCount] = {
+        s_IblIrrSampler, s_IblRadSampler, s_IblLutSampler, s_ShadowSampler,
+        s_LightDataSampler, s_LightGridSampler, s_LightIndexSampler,
+    };
+    for (u8 i = 0; i < Renderer::c_EngineStageCount; ++i)
+        encoder->setTexture(
+            static_cast<u8>(Renderer::c_FirstEngineStage + i), samplers[i], textures[i]);
+}
+
+// Engine IBL + shadow + light grid bindings for a mesh submit. Called before the
+// material bind so a material never overwrites the engine sampler stages. With
+// the context's view bindings open only the textures resolved by
+// BeginViewBindings are re-set: every submit discards all texture bindings, so
+// a material's stages never leak into the next draw, while the engine uniforms
+// set once for the view carry over (bgfx never discards uniform values).
+static void BindEngineState(bgfx::Encoder* encoder, const Renderer::EncoderContext& context)
+{
+    if (context.viewBindingsOpen) {
+        BindEngineTextures(encoder, context.viewTextures);
+        return;
+    }
+    bgfx::TextureHandle textures[Renderer::c_EngineStageCount];
+    ResolveEngineTextures(context.bindings, textures);
+    BindEngineTextures(encoder, textures);
+    BindEnvironment(encoder, context.bindings);
+    BindShadow(encoder, context.bindings.shadow);
+    BindLightGrid(encoder, context.bindings);
+}
+
+void Renderer::BindVertexDecode(const Mesh& mesh, bgfx::Encoder* encoder)
+{
+    const glm::vec4 decode[2] = {
+        glm::vec4(mesh.PositionScale(), mesh.HasOctahedralNormals() ? 1.0f : 0.0f),
+        glm::vec4(mesh.PositionOffset(), 0.0f),
     };
+    EncoderOrMain(encoder)->setUniform(s_MeshDecode, decode, 2);
+}
+
+// Draw one index range of `mesh` (relative to `baseVertex`) with `material`.
+// The material binds state + uniforms; the renderer issues the submit.
+static void DrawMeshRange(
+    const Renderer::EncoderContext& context, const Mesh& mesh, const glm::mat4& transform,
+    u32 baseVertex, u32 firstIndex, u32 indexCount, const Ref<MaterialAsset>& material)
+{
+    if (!material)
+        return;
+    bgfx::Encoder* encoder = EncoderOrMain(context.encoder);
+    encoder->setTransform(glm::value_ptr(transform));
+    encoder->setVertexBuffer(0, mesh.VertexBuffer(), baseVertex, UINT32_MAX);
+    encoder->setIndexBuffer(mesh.IndexBuffer(), firstIndex, indexCount);
+    BindVertexDecode(mesh, encoder);
+    BindEngineState(encoder, context);
+    material->Bind(encoder);
+    encoder->submit(context.viewId, material->Program());
+}
+
+// Fill a transient instance buffer with up to `count` model matrices (one
+// 64-byte instance each, read as i_data0..3). Returns how many fit this frame;
+// 0 if instancing is unsupported or the transient pool is exhausted.
+static u32 AllocInstanceTransforms(
+    bgfx::InstanceDataBuffer& idb, const glm::mat4* transforms, u32 count)
+{
+    if ((bgfx::getCaps()->supported & BGFX_CAPS_INSTANCING) == 0)
+        return 0;
+    constexpr u16 stride = sizeof(glm::mat4);
+    const u32 avail = bgfx::getAvailInstanceDataBuffer(count, stride);
+    if (avail == 0)
+        return 0;
+    bgfx::allocInstanceDataBuffer(&idb, avail, stride);
+    std::memcpy(idb.data, transforms, static_cast<size_t>(avail) * stride);
+    return avail;
+}
+
+// Visit the index ranges of `mesh`'s level `lod` for a depth-only draw: the
+// whole level at once, or one range per submesh when they have their own base
+// vertex (chunked 16-bit imports).
+template<typename Fn>
+static void ForEachLevelRange(const Mesh& mesh, u32 lod, Fn&& fn)
+{
+    if (!mesh.HasSubmeshBaseVertices()) {
+        const Mesh::IndexRange range = mesh.LevelRange(lod);
+        fn(0u, range.BaseIndex, range.IndexCount);
+        return;
+    }
+    for (u32 i = 0; i < mesh.Submeshes().size(); ++i) {
+        u32 firstIndex = 0, indexCount = 0;
+        if (mesh.SubmeshRange(i, lod, firstIndex, indexCount))
+            fn(mesh.SubmeshBaseVertex(i), firstIndex, indexCount);
+    }
+}
+
+void Renderer::SubmitMesh(
+    const EncoderContext& context, const Mesh& mesh, const glm::mat4& transform,
+    const std::vector<AssetHandle>& materialOverrides)
+{
+    if (!bgfx::isValid(mesh.VertexBuffer()) || !bgfx::isValid(mesh.IndexBuffer()))
+        return;
 
     const std::vector<Mesh::Submesh>& submeshes = mesh.Submeshes();
     if (submeshes.empty()) {
-        drawRange(0, mesh.IndexCount(), resolveSlot(0));
+        DrawMeshRange(context, mesh, transform, 0, 0, mesh.LevelRange(0).IndexCount,
+            ResolveMaterial(mesh, 0, materialOverrides));
     } else {
         for (const Mesh::Submesh& submesh : submeshes)
-            drawRange(submesh.BaseIndex, submesh.IndexCount, resolveSlot(submesh.MaterialSlot));
+            DrawMeshRange(context, mesh, transform, submesh.BaseVertex, submesh.BaseIndex,
+                submesh.IndexCount, ResolveMaterial(mesh, submesh.MaterialSlot, materialOverrides));
     }
 }
 
+void Renderer::SubmitSubmesh(
+    const EncoderContext& context, const Mesh& mesh, u32 submeshIndex,
+    const glm::mat4& transform, const Ref<MaterialAsset>& material, u32 lod)
+{
+    if (!bgfx::isValid(mesh.VertexBuffer()) || !bgfx::isValid(mesh.IndexBuffer()))
+        return;
+
+    u32 firstIndex = 0, indexCount = 0;
+    if (mesh.SubmeshRange(submeshIndex, lod, firstIndex, indexCount))
+        DrawMeshRange(context, mesh, transform,
+            mesh.SubmeshBaseVertex(submeshIndex), firstIndex, indexCount, material);
+}
+
+u32 Renderer::SubmitInstanced(
+    const EncoderContext& context, const Mesh& mesh, u32 submeshIndex,
+    const Ref<MaterialAsset>& material, const glm::mat4* transforms, u32 count, u32 lod)
+{
+    if (!material || count == 0 || !bgfx::isValid(mesh.VertexBuffer()) ||
+        !bgfx::isValid(mesh.IndexBuffer()))
+        return 0;
+
+    u32 firstIndex = 0, indexCount = 0;
+    if (!mesh.SubmeshRange(submeshIndex, lod, firstIndex, indexCount))
+        return 0;
+
+    const bgfx::ProgramHandle program =
+        ShaderManager::GetInstancedProgram(material->Resolve().Shader);
+    if (!bgfx::isValid(program))
+        return 0;
+
+    bgfx::InstanceDataBuffer idb;
+    const u32 drawn = AllocInstanceTransforms(idb, transforms, count);
+    if (drawn == 0)
+        return 0;
+
+    bgfx::Encoder* encoder = EncoderOrMain(context.encoder);
+    encoder->setVertexBuffer(
+        0, mesh.VertexBuffer(), mesh.SubmeshBaseVertex(submeshIndex), UINT32_MAX);
+    encoder->setIndexBuffer(mesh.IndexBuffer(), firstIndex, indexCount);
+    encoder->setInstanceDataBuffer(&idb);
+    BindVertexDecode(mesh, encoder);
+    BindEngineState(encoder, context);
+    material->Bind(encoder);
+    encoder->submit(context.viewId, program);
+    return drawn;
+}
+
 void Renderer::Begin(uint16_t viewId)
 {
     s_RenderData.currentViewId = viewId;
@@ -525,75 +807,192 @@ void Renderer::End()
 
 void Renderer::SetEnvironment(const EnvironmentBinding& env)
 {
-    s_Env = env;
-    s_EnvActive = bgfx::isValid(env.radiance) && bgfx::isValid(env.irradiance) &&
-                  bgfx::isValid(env.brdfLut);
+    s_Bindings.environment = env;
+    s_Bindings.environmentActive = bgfx::isValid(env.radiance) &&
+                                   bgfx::isValid(env.irradiance) && bgfx::isValid(env.brdfLut);
 }
 
 void Renderer::ClearEnvironment()
 {
-    s_Env = {};
-    s_EnvActive = false;
+    s_Bindings.environment = {};
+    s_Bindings.environmentActive = false;
+}
+
+void Renderer::SetLightGrid(const LightGridBinding& grid)
+{
+    s_Bindings.lightGrid = grid;
+    s_Bindings.lightGridActive = bgfx::isValid(grid.lightData) && bgfx::isValid(grid.grid) &&
+                                 bgfx::isValid(grid.indices);
+}
+
+void Renderer::ClearLightGrid()
+{
+    s_Bindings.lightGrid = {};
+    s_Bindings.lightGridActive = false;
+}
+
+Renderer::EncoderContext Renderer::MakeContext(uint16_t viewId, bgfx::Encoder* encoder)
+{
+    EncoderContext context;
+    context.encoder = encoder;
+    context.viewId = viewId;
+    context.bindings = s_Bindings;
+    return context;
 }
 
-void Renderer::BeginShadowCascade(
-    int cascade, const glm::mat4& lightView, const glm::mat4& lightProj)
+void Renderer::BeginViewBindings(EncoderContext& context)
+{
+    bgfx::Encoder* encoder = EncoderOrMain(context.encoder);
+    ResolveEngineTextures(context.bindings, context.viewTextures);
+    BindEnvironment(encoder, context.bindings);
+    BindShadow(encoder, context.bindings.shadow);
+    BindLightGrid(encoder, context.bindings);
+    context.viewBindingsOpen = true;
+}
+
+void Renderer::EndViewBindings(EncoderContext& context)
+{
+    if (!context.viewBindingsOpen)
+        return;
+    // Drop anything set since the last submit so it doesn't attach to whatever
+    // is submitted next on this encoder.
+    EncoderOrMain(context.encoder)->discard(BGFX_DISCARD_ALL);
+    context.viewBindingsOpen = false;
+}
+
+Renderer::EncoderContext Renderer::BeginShadowCascade(
+    int cascade, ShadowAtlas atlas, const glm::mat4& lightView, const glm::mat4& lightProj)
 {
     EnsureShadowMap();
+    if (atlas == ShadowAtlas::Static)
+        EnsureStaticShadowMap();
     uint16_t tx, ty;
     CascadeTilePixel(cascade, tx, ty);
     // Each cascade is its own view (ViewId::Shadow + cascade) targeting the shared
     // atlas framebuffer at this cascade's quadrant rect, so its clear touches only
     // that quadrant. Un-reversed convention: clear depth to 1.0, LESS on submit.
+    const u16 view = ShadowView(cascade, atlas);
     RenderPass pass = RenderPass::ToTarget(
-        static_cast<u16>(ViewId::Shadow + cascade), s_ShadowFb,
+        view, atlas == ShadowAtlas::Static ? s_StaticShadowFb : s_ShadowFb,
         kShadowTileSize, kShadowTileSize);
     pass.x = tx;
     pass.y = ty;
     pass.Clear(BGFX_CLEAR_DEPTH, 0x000000ff, 1.0f).Bind();
-    bgfx::setViewTransform(static_cast<u16>(ViewId::Shadow + cascade),
-        glm::value_ptr(lightView), glm::value_ptr(lightProj));
+    bgfx::setViewTransform(view, glm::value_ptr(lightView), glm::value_ptr(lightProj));
+    // A tile with no casters must still clear: static tiles are composed, and
+    // frame tiles sampled, whatever they last held.
+    bgfx::touch(view);
+
+    // Resolved here (main thread) so caster submits on worker encoders only
+    // read handles from their context.
+    EncoderContext context;
+    context.viewId = view;
+    context.shadowProgram = ShaderManager::GetProgram("shadow");
+    context.shadowInstancedProgram = ShaderManager::GetProgram("shadow_instanced");
+    return context;
 }
 
-void Renderer::SubmitShadowCaster(int cascade, const Mesh& mesh, const glm::mat4& transform)
+void Renderer::ComposeStaticShadow(int cascade)
 {
-    const bgfx::ProgramHandle program = ShaderManager::GetProgram("shadow");
-    const bgfx::VertexBufferHandle vb = mesh.VertexBuffer();
+    const bgfx::ProgramHandle program = ShaderManager::GetProgram("shadow_copy");
+    if (!bgfx::isValid(program) || !bgfx::isValid(s_StaticShadowMap))
+        return;
+
+    EnsureShadowUniforms();
+    const float params[4] = { 1.0f / static_cast<float>(kShadowAtlasSize), 0.0f, 0.0f, 0.0f };
+    bgfx::setTexture(0, s_ShadowStaticSampler, s_StaticShadowMap);
+    bgfx::setUniform(s_ShadowCopyParams, params);
+    // Same depth test as the casters, so the copy and the dynamic casters
+    // resolve to the nearest of both in whatever order bgfx draws them.
+    DrawFullscreen(ShadowView(cascade, ShadowAtlas::Frame), program,
+        BGFX_STATE_WRITE_Z | BGFX_STATE_DEPTH_TEST_LESS);
+}
+
+void Renderer::SubmitShadowCaster(
+    const EncoderContext& context, const Mesh& mesh, const glm::mat4& transform, u32 lod)
+{
+    const bgfx::ProgramHandle program = context.shadowProgram;
+    const bgfx::VertexBufferHandle vb = mesh.DepthVertexBuffer();
     const bgfx::IndexBufferHandle ib = mesh.IndexBuffer();
     if (!bgfx::isValid(program) || !bgfx::isValid(vb) || !bgfx::isValid(ib))
         return;
 
-    bgfx::setTransform(glm::value_ptr(transform));
-    bgfx::setVertexBuffer(0, vb);
-    bgfx::setIndexBuffer(ib);
-    // No culling: front faces (toward the light) win the depth test, so the
-    // shadow map stores the TRUE occluder surface — the receiver's contact stays
-    // attached (no peter-panning). Self-shadow acne is handled by the slope-scaled
-    // depth bias in the sampler, not by shifting the occluder depth.
-    bgfx::setState(BGFX_STATE_WRITE_Z | BGFX_STATE_DEPTH_TEST_LESS);
-    bgfx::submit(static_cast<u16>(ViewId::Shadow + cascade), program);
+    bgfx::Encoder* encoder = EncoderOrMain(context.encoder);
+    ForEachLevelRange(mesh, lod, [&](u32 baseVertex, u32 firstIndex, u32 indexCount) {
+        encoder->setTransform(glm::value_ptr(transform));
+        encoder->setVertexBuffer(0, vb, baseVertex, UINT32_MAX);
+        encoder->setIndexBuffer(ib, firstIndex, indexCount);
+        BindVertexDecode(mesh, encoder);
+        // No culling: front faces (toward the light) win the depth test, so the
+        // shadow map stores the TRUE occluder surface — the receiver's contact
+        // stays attached (no peter-panning). Self-shadow acne is handled by the
+        // slope-scaled depth bias in the sampler, not by shifting the occluder depth.
+        encoder->setState(BGFX_STATE_WRITE_Z | BGFX_STATE_DEPTH_TEST_LESS);
+        encoder->submit(context.viewId, program);
+    });
+}
+
+u32 Renderer::SubmitShadowCastersInstanced(
+    const EncoderContext& context, const Mesh& mesh, const glm::mat4* transforms, u32 count,
+    u32 lod)
+{
+    const bgfx::ProgramHandle program = context.shadowInstancedProgram;
+    const bgfx::VertexBufferHandle vb = mesh.DepthVertexBuffer();
+    const bgfx::IndexBufferHandle ib = mesh.IndexBuffer();
+    if (count == 0 || !bgfx::isValid(program) || !bgfx::isValid(vb) || !bgfx::isValid(ib))
+        return 0;
+
+    bgfx::InstanceDataBuffer idb;
+    const u32 drawn = AllocInstanceTransforms(idb, transforms, count);
+    if (drawn == 0)
+        return 0;
+
+    bgfx::Encoder* encoder = EncoderOrMain(context.encoder);
+    ForEachLevelRange(mesh, lod, [&](u32 baseVertex, u32 firstIndex, u32 indexCount) {
+        encoder->setVertexBuffer(0, vb, baseVertex, UINT32_MAX);
+        encoder->setIndexBuffer(ib, firstIndex, indexCount);
+        encoder->setInstanceDataBuffer(&idb);
+        BindVertexDecode(mesh, encoder);
+        encoder->setState(BGFX_STATE_WRITE_Z | BGFX_STATE_DEPTH_TEST_LESS); // as SubmitShadowCaster
+        encoder->submit(context.viewId, program);
+    });
+    return drawn;
 }
 
 void Renderer::EndShadowCascades(
     const glm::mat4* shadowMtx, const float* normalizedBias, int count,
     const glm::vec4& splits, const glm::vec3& cameraForward, float normalOffset)
 {
-    s_ShadowCascadeCount = count < kMaxCascades ? count : kMaxCascades;
-    for (int i = 0; i < s_ShadowCascadeCount; ++i)
+    ShadowBinding& shadow = s_Bindings.shadow;
+    shadow.cascadeCount = count < kMaxCascades ? count : kMaxCascades;
+    for (int i = 0; i < shadow.cascadeCount; ++i)
     {
-        s_ShadowMtx[i] = shadowMtx[i];
-        s_CsmBias[i] = normalizedBias[i];
+        shadow.shadowMtx[i] = shadowMtx[i];
+        shadow.bias[i] = normalizedBias[i];
     }
-    s_CsmSplits = splits;
-    s_CsmForward = glm::vec4(cameraForward, 0.0f);
-    s_ShadowNormalOffset = normalOffset;
-    s_ShadowActive = s_ShadowCascadeCount > 0;
+    shadow.splits = splits;
+    shadow.forward = glm::vec4(cameraForward, 0.0f);
+    shadow.normalOffset = normalOffset;
+    shadow.active = shadow.cascadeCount > 0;
 }
 
 void Renderer::ClearShadow()
 {
-    s_ShadowActive = false;
-    s_ShadowCascadeCount = 0;
+    s_Bindings.shadow.active = false;
+    s_Bindings.shadow.cascadeCount = 0;
+}
+
+bool Renderer::ClaimShadowAtlas(const void* owner)
+{
+    const bool kept = s_ShadowAtlasOwner == owner;
+    s_ShadowAtlasOwner = owner;
+    return kept;
+}
+
+void Renderer::ReleaseShadowAtlas(const void* owner)
+{
+    if (s_ShadowAtlasOwner == owner)
+        s_ShadowAtlasOwner = nullptr;
 }
 
 u16 Renderer::ShadowMapSize()
@@ -666,7 +1065,8 @@ void Renderer::DrawFullscreen(
 }
 
 void Renderer::TonemapResolve(
-    uint16_t viewId, bgfx::TextureHandle hdrColor, float exposure, int op)
+    uint16_t viewId, bgfx::TextureHandle hdrColor, float exposure, int op,
+    float scale, uint16_t width, uint16_t height)
 {
     const bgfx::ProgramHandle program = ResolveTonemapProgram();
     if (!bgfx::isValid(program) || !bgfx::isValid(hdrColor))
@@ -676,15 +1076,53 @@ void Renderer::TonemapResolve(
         s_TonemapSampler = bgfx::createUniform("s_hdr", bgfx::UniformType::Sampler);
     if (!bgfx::isValid(s_TonemapParams))
         s_TonemapParams = bgfx::createUniform("u_tonemapParams", bgfx::UniformType::Vec4);
-
-    const float params[4] = { exposure, static_cast<float>(op), 0.0f, 0.0f };
+    if (!bgfx::isValid(s_TonemapRegion))
+        s_TonemapRegion = bgfx::createUniform("u_tonemapRegion", bgfx::UniformType::Vec4);
+
+    // The scene's region of the texture in UV space. It sits at the top of the
+    // texture (bgfx view rects are top-left); with a bottom-left origin that is
+    // the top of the V range. Half a texel keeps the bilinear taps off the
+    // stale texels past the region's edge.
+    const bool upscale = scale < 1.0f && width > 0 && height > 0;
+    const float su = upscale
+        ? static_cast<float>(DynamicResolution::ScaledSize(width, scale)) / width : 1.0f;
+    const float sv = upscale
+        ? static_cast<float>(DynamicResolution::ScaledSize(height, scale)) / height : 1.0f;
+    const float vOffset = bgfx::getCaps()->originBottomLeft ? 1.0f - sv : 0.0f;
+    const float region[4] = { su, sv, 0.0f, vOffset };
+    const float params[4] = { exposure, static_cast<float>(op),
+        upscale ? 0.5f / width : 0.0f, upscale ? 0.5f / height : 0.0f };
     bgfx::setUniform(s_TonemapParams, params);
-    bgfx::setTexture(0, s_TonemapSampler, hdrColor);
+    bgfx::setUniform(s_TonemapRegion, region);
+    // Render targets sample point-filtered; an upscale needs bilinear taps.
+    bgfx::setTexture(0, s_TonemapSampler, hdrColor,
+        upscale ? BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP : UINT32_MAX);
 
     // No depth test/write: a fullscreen resolve overwrites the whole target.
     DrawFullscreen(viewId, program, BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A);
 }
 
+void Renderer::FxaaResolve(
+    uint16_t viewId, bgfx::TextureHandle ldrColor, uint16_t width, uint16_t height)
+{
+    const bgfx::ProgramHandle program = ShaderManager::GetProgram("fxaa");
+    if (!bgfx::isValid(program) || !bgfx::isValid(ldrColor) || width == 0 || height == 0)
+        return;
+
+    if (!bgfx::isValid(s_FxaaSampler))
+        s_FxaaSampler = bgfx::createUniform("s_ldr", bgfx::UniformType::Sampler);
+    if (!bgfx::isValid(s_FxaaParams))
+        s_FxaaParams = bgfx::createUniform("u_fxaaParams", bgfx::UniformType::Vec4);
+
+    const float params[4] = { 1.0f / width, 1.0f / height, 0.0f, 0.0f };
+    bgfx::setUniform(s_FxaaParams, params);
+    // Bilinear: the edge search relies on filtered taps between texels (render
+    // targets default to point sampling).
+    bgfx::setTexture(0, s_FxaaSampler, ldrColor, BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP);
+
+    DrawFullscreen(viewId, program, BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A);
+}
+
 void Renderer::DrawSkybox(
     uint16_t viewId, bgfx::TextureHandle cube, const glm::mat4& invViewProj,
     const glm::vec3& cameraPos, float intensity, float rotationYaw, float mipLod)
@@ -770,6 +1208,16 @@ void Renderer::FlushFrame()
     s_RenderData.frameNumber = bgfx::frame(false);
 }
 
+bool Renderer::IsRenderThreaded()
+{
+    return s_RenderData.renderThread;
+}
+
+bool Renderer::IsVSync()
+{
+    return (s_RenderData.resetFlags & BGFX_RESET_VSYNC) != 0;
+}
+
 u32 Renderer::FrameNumber()
 {
     return s_RenderData.frameNumber;
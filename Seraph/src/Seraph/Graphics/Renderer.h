@@ -5,6 +5,7 @@
 #pragma once
 #include "Seraph/Asset/AssetHandle.h"
 #include "Seraph/Core/Base.h"
+#include "Seraph/Core/Ref.h"
 #include "bgfx/bgfx.h"
 
 #include <cstdint>
@@ -15,26 +16,29 @@ namespace Seraph
 class Camera;
 class Mesh;
 class Material;
+class MaterialAsset;
 
 struct Renderer
 {
-    static void Init();
+    // `renderThread` opts into bgfx's multithreaded mode: bgfx creates its own
+    // render thread that owns the graphics context and driver submission, and
+    // FlushFrame only hands the recorded frame over (overlapping the next game
+    // update with this frame's driver work). Off, bgfx renders inline inside
+    // FlushFrame on the calling thread. The r.renderThread CVar (archived, read
+    // here, so it applies on the next launch) also enables it.
+    static void Init(bool renderThread = false);
     static void Cleanup();
 
-    // Draw a mesh. `materialOverrides` is indexed by material slot; a valid
-    // handle at a slot wins over the mesh's baked slot default, which wins over
-    // the engine default material.
-    static void SubmitMesh(
-        const Mesh& mesh, const glm::mat4& transform = glm::mat4(1.0f),
-        const std::vector<AssetHandle>& materialOverrides = {});
+    // True when bgfx is running its own render thread (see Init).
+    static bool IsRenderThreaded();
 
-    static void Begin(uint16_t viewId);
-    static void End();
+    // True when the backbuffer presents with VSync (BGFX_RESET_VSYNC).
+    static bool IsVSync();
 
     // Image-based-lighting environment bound for the frame's mesh submits. The
     // cubes are the scene's prefiltered radiance (mipped) + irradiance; `brdfLut`
-    // is Renderer::BrdfLut(). SubmitMesh binds these per-submesh (a material's
-    // BGFX_DISCARD_ALL clears bindings each submesh), so the PBR shader gets
+    // is Renderer::BrdfLut(). Mesh submits bind these from their context (per
+    // view, see BeginViewBindings, or per submesh), so the PBR shader gets
     // image-based ambient. `radianceMips` scales roughness -> radiance LOD;
     // `rotationYaw`/`intensity` match the skybox. All handles must be valid.
     struct EnvironmentBinding
@@ -47,13 +51,145 @@ struct Renderer
         float radianceMips = 1.0f;
     };
 
-    // Set (or clear) the active IBL environment for subsequent SubmitMesh calls.
+    // Clustered light list for the frame's mesh submits (built by LightGrid): the
+    // light data, per-cluster (first, count) grid and light index textures, plus
+    // the exponential depth-slice mapping slice = log(viewZ) * sliceScale -
+    // sliceBias. `targetHeight` is the full height of the scene view's target,
+    // which GL needs to turn gl_FragCoord into a tile. All handles must be valid.
+    struct LightGridBinding
+    {
+        bgfx::TextureHandle lightData = BGFX_INVALID_HANDLE;
+        bgfx::TextureHandle grid      = BGFX_INVALID_HANDLE;
+        bgfx::TextureHandle indices   = BGFX_INVALID_HANDLE;
+        float sliceScale = 0.0f;
+        float sliceBias  = 0.0f;
+        float targetHeight = 0.0f;
+    };
+
+    // Cascade state the scene pass samples (see the cascaded shadow maps below):
+    // world -> [0,1] shadow UV + depth per cascade, normalized depth bias, the
+    // cascade far view-depths (+ max distance in w) and the camera forward.
+    struct ShadowBinding
+    {
+        glm::mat4 shadowMtx[4] = {
+            glm::mat4(1.0f), glm::mat4(1.0f), glm::mat4(1.0f), glm::mat4(1.0f) };
+        glm::vec4 bias{0.0f};
+        glm::vec4 splits{0.0f};
+        glm::vec4 forward{0.0f};
+        int   cascadeCount = 0;
+        float normalOffset = 0.0f;
+        bool  active = false;
+    };
+
+    // The engine state every mesh submit binds next to its material: IBL
+    // environment, shadow cascades and light grid. The active flags select the
+    // neutral fallbacks (and turn the shader terms off) when one is unset.
+    struct EngineBindings
+    {
+        EnvironmentBinding environment;
+        ShadowBinding      shadow;
+        LightGridBinding   lightGrid;
+        bool environmentActive = false;
+        bool lightGridActive   = false;
+    };
+
+    // Everything a submit reads besides its own arguments: the encoder and view
+    // it records into, the shadow caster programs and a snapshot of the engine
+    // bindings. Contexts are made on the main thread (MakeContext,
+    // BeginShadowCascade) and only read afterwards, so a worker recording through
+    // its own copy never reads renderer state the main thread is still writing
+    // (the next cascade's setup, SetLightGrid for another scene, ...). Set
+    // `encoder` on a worker's copy to the one from its bgfx::begin(true); null
+    // records through the main thread's encoder. Anything that binds a material
+    // (SubmitMesh/SubmitSubmesh/SubmitInstanced) must still be called on the main
+    // thread — material binding touches the uniform cache and asset manager.
+    // Engine sampler stages: IBL 5-7, shadow 8, light grid 9-11.
+    static constexpr u8 c_FirstEngineStage = 5;
+    static constexpr u8 c_EngineStageCount = 7;
+
+    struct EncoderContext
+    {
+        bgfx::Encoder* encoder = nullptr;
+        u16 viewId = UINT16_MAX;
+        bgfx::ProgramHandle shadowProgram          = BGFX_INVALID_HANDLE;
+        bgfx::ProgramHandle shadowInstancedProgram = BGFX_INVALID_HANDLE;
+        EngineBindings bindings;
+        // Set by BeginViewBindings: the engine stages' textures, resolved once.
+        bgfx::TextureHandle viewTextures[c_EngineStageCount] = {};
+        bool viewBindingsOpen = false;
+    };
+
+    // A context submitting to `viewId` with the engine bindings as set right now
+    // (SetEnvironment/SetLightGrid/EndShadowCascades). Main thread.
+    static EncoderContext MakeContext(uint16_t viewId, bgfx::Encoder* encoder = nullptr);
+
+    // View-level engine bindings. BeginViewBindings sets the context's IBL,
+    // cascade and light grid uniforms once on its encoder and resolves the
+    // textures of the engine stages (fallbacks included) into the context; the
+    // mesh submits that follow through the same context then only re-set those
+    // seven texture handles per draw, so per-draw work is transform + material.
+    // Every submit still discards all texture bindings, so a material's stages
+    // never leak into the next draw. EndViewBindings closes the pair. Without an
+    // open pair, each submit binds the engine state itself. Materials must
+    // leave the engine sampler stages (5-11) alone.
+    static void BeginViewBindings(EncoderContext& context);
+    static void EndViewBindings(EncoderContext& context);
+
+    // Draw a mesh. `materialOverrides` is indexed by material slot; a valid
+    // handle at a slot wins over the mesh's baked slot default, which wins over
+    // the engine default material.
+    static void SubmitMesh(
+        const EncoderContext& context, const Mesh& mesh,
+        const glm::mat4& transform = glm::mat4(1.0f),
+        const std::vector<AssetHandle>& materialOverrides = {});
+
+    // The material SubmitMesh would use for `slot` (override -> baked slot
+    // default -> engine default), for callers that batch draws themselves.
+    static Ref<MaterialAsset> ResolveMaterial(
+        const Mesh& mesh, u32 slot, const std::vector<AssetHandle>& materialOverrides = {});
+
+    // Draw a single submesh (index into mesh.Submeshes(); a mesh without a
+    // submesh table has one implicit submesh 0) with an already-resolved
+    // material, at level of detail `lod` (clamped to the mesh's coarsest).
+    // Used when only part of a mesh survives culling, or for batch leftovers
+    // that did not instance. SubmitMesh always draws LOD 0.
+    static void SubmitSubmesh(
+        const EncoderContext& context, const Mesh& mesh, u32 submeshIndex,
+        const glm::mat4& transform, const Ref<MaterialAsset>& material, u32 lod = 0);
+
+    // Instanced draw: one submit of `submeshIndex` for `count` world transforms,
+    // via the material shader's "<name>_instanced" variant and a transient
+    // instance data buffer. Returns how many instances were drawn (a prefix of
+    // `transforms`) — 0 if the GPU lacks instancing, the shader has no instanced
+    // variant, or the frame's transient instance space is exhausted. The caller
+    // draws the remainder through SubmitSubmesh.
+    static u32 SubmitInstanced(
+        const EncoderContext& context, const Mesh& mesh, u32 submeshIndex,
+        const Ref<MaterialAsset>& material, const glm::mat4* transforms, u32 count,
+        u32 lod = 0);
+
+    // Set the u_meshDecode uniform (shader/vertex.sh) for the next draw of
+    // `mesh`: position dequantization and whether normals/tangents are
+    // octahedral-encoded. Every Submit* does this; callers issuing their own
+    // mesh draws (e.g. the editor pick pass) must too.
+    static void BindVertexDecode(const Mesh& mesh, bgfx::Encoder* encoder = nullptr);
+
+    static void Begin(uint16_t viewId);
+    static void End();
+
+    // Set (or clear) the active IBL environment for contexts made afterwards.
     // Call once per frame before the mesh loop (SceneRenderer does this from the
     // scene's SceneEnvironment). Cleared state binds neutral fallbacks and tells
     // the shader to fall back to the flat ambient term.
     static void SetEnvironment(const EnvironmentBinding& env);
     static void ClearEnvironment();
 
+    // Set (or clear) the clustered light list for contexts made afterwards
+    // (SceneRenderer sets it before its scene pass and clears it after). While
+    // cleared, the PBR shader skips direct lighting.
+    static void SetLightGrid(const LightGridBinding& grid);
+    static void ClearLightGrid();
+
     // --- Cascaded shadow maps (Render 17 + 21) -----------------------------
     // Depth-only passes from the sun's per-cascade orthographic views, rendered
     // into a shared 2x2 shadow atlas (cascade i -> quadrant) on ViewId::Shadow+i
@@ -61,21 +197,57 @@ struct Renderer
     // selecting the tightest cascade that contains each fragment.
     //
     // Frame sequence, driven by SceneRenderer, per cascade i in [0, count):
-    //   BeginShadowCascade(i, lightView_i, lightProj_i)   // bind that quadrant
-    //   SubmitShadowCaster(i, mesh, transform) ...         // one per caster
+    //   context_i = BeginShadowCascade(i, ShadowAtlas::Frame, lightView_i, lightProj_i)
+    //   SubmitShadowCaster(context_i, mesh, transform, lod) ...
     // then once:
     //   EndShadowCascades(shadowMtx[count], normalizedBias[count], count, normalOffset)
-    // SubmitMesh binds the atlas + matrices per submesh. ClearShadow() (or simply
-    // not calling the sequence) disables shadowing for the frame. shadowMtx[i]
-    // maps world space to cascade i's [0,1] shadow UV + depth; normalizedBias[i]
-    // is the depth bias already scaled into that cascade's normalized-depth units.
-    static void BeginShadowCascade(
-        int cascade, const glm::mat4& lightView, const glm::mat4& lightProj);
-    static void SubmitShadowCaster(int cascade, const Mesh& mesh, const glm::mat4& transform);
+    // Contexts made after that bind the atlas + matrices (see BeginViewBindings).
+    // ClearShadow() (or simply not calling the sequence) disables shadowing for
+    // the frame. shadowMtx[i] maps world space to cascade i's [0,1] shadow UV +
+    // depth; normalizedBias[i] is the depth bias already scaled into that
+    // cascade's normalized-depth units. Begin/End run on the main thread; the
+    // casters may be submitted from worker encoders through (a copy of) the
+    // cascade's context, which carries its view and programs.
+    //
+    // Cached cascades: a second, persistent atlas (ShadowAtlas::Static, views
+    // ViewId::ShadowStatic+i) holds casters that rarely change. The caller
+    // re-renders a static tile only when its cascade's projection or static
+    // caster set changes; every frame that cascade begins, ComposeStaticShadow
+    // copies the tile into the frame atlas and only the dynamic casters are
+    // submitted. Atlas contents persist across frames, so a cascade that is not
+    // begun at all keeps last frame's tile (and its caller keeps its matrix).
+    enum class ShadowAtlas : u8
+    {
+        Frame,  // sampled by the scene pass
+        Static, // persistent static casters, composed into Frame
+    };
+    static EncoderContext BeginShadowCascade(
+        int cascade, ShadowAtlas atlas, const glm::mat4& lightView, const glm::mat4& lightProj);
+    // Depth-copy cascade's static tile under its frame tile. Main thread, after
+    // BeginShadowCascade(cascade, ShadowAtlas::Frame, ...).
+    static void ComposeStaticShadow(int cascade);
+    // Casters draw the whole index range of LOD `lod` (every submesh at once)
+    // from the mesh's position stream (Mesh::DepthVertexBuffer).
+    static void SubmitShadowCaster(
+        const EncoderContext& context, const Mesh& mesh, const glm::mat4& transform,
+        u32 lod = 0);
+    // Instanced SubmitShadowCaster (the `shadow_instanced` program): draws a
+    // prefix of `transforms` in one submit and returns its length, 0 if the
+    // instanced path is unavailable. Same contract as SubmitInstanced.
+    static u32 SubmitShadowCastersInstanced(
+        const EncoderContext& context, const Mesh& mesh, const glm::mat4* transforms,
+        u32 count, u32 lod = 0);
     static void EndShadowCascades(
         const glm::mat4* shadowMtx, const float* normalizedBias, int count,
         const glm::vec4& splits, const glm::vec3& cameraForward, float normalOffset);
     static void ClearShadow();
+    // Record `owner` as the one whose tiles the atlases hold. Returns false when
+    // they may hold something else (another owner drew last, or the atlases were
+    // recreated), i.e. every cached tile must be rendered again.
+    static bool ClaimShadowAtlas(const void* owner);
+    // Forget `owner`'s claim (e.g. on destruction, so a later owner at the same
+    // address does not inherit its tiles). No-op when another owner holds it.
+    static void ReleaseShadowAtlas(const void* owner);
 
     // Per-cascade shadow tile edge length in texels (square). Exposed so callers
     // can compute the light-space texel size for filtering/stabilization.
@@ -93,9 +265,18 @@ struct Renderer
     // Resolve an HDR (linear) scene color texture to the target currently bound to
     // `viewId` via the `tonemap` pass: exposure, tone-mapping operator, and gamma
     // encode. The caller sets the view's framebuffer + rect first. `op`: 0 None,
-    // 1 Reinhard, 2 ACES.
+    // 1 Reinhard, 2 ACES. With `scale` < 1 only the top-left `scale` fraction of
+    // `hdrColor` (`width` x `height`) holds the scene, and it is upscaled
+    // bilinearly to the whole target (dynamic resolution).
     static void TonemapResolve(
-        uint16_t viewId, bgfx::TextureHandle hdrColor, float exposure, int op);
+        uint16_t viewId, bgfx::TextureHandle hdrColor, float exposure, int op,
+        float scale = 1.0f, uint16_t width = 0, uint16_t height = 0);
+
+    // Anti-alias a tone-mapped (gamma-encoded) LDR texture of `width` x `height`
+    // into the target bound to `viewId` via the `fxaa` pass: luma edge detection,
+    // then a blend along the edge. The caller sets the view's framebuffer + rect.
+    static void FxaaResolve(
+        uint16_t viewId, bgfx::TextureHandle ldrColor, uint16_t width, uint16_t height);
 
     // Draw the environment cube as the scene background on `viewId`, filling only
     // pixels no geometry covered. A fullscreen pass reconstructs the per-pixel
@@ -122,6 +303,9 @@ struct Renderer
     static void Clear(glm::vec3 clearColor, uint16_t flags = BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH);
     static void SetBackBufferSize(u32 width, u32 height);
 
+    // Submit the recorded frame (bgfx::frame). Single-threaded: renders it before
+    // returning. Render-threaded: waits for the render thread to finish the
+    // previous frame, then hands this one over and returns.
     static void FlushFrame();
 
     // bgfx frame counter (last value returned by bgfx::frame in FlushFrame).
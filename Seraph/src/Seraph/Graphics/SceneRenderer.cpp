@@ -9,15 +9,17 @@
 #include "RenderSystem.h"
 #include "SceneCamera.h"
 #include "Seraph/Asset/AssetManager.h"
+#include "Seraph/Console/AutoCVar.h"
+#include "Seraph/Console/ConsoleCommand.h"
+#include "Seraph/Core/Threading/ThreadPool.h"
 #include "Seraph/Graphics/EnvironmentMap.h"
-#include "Seraph/Scene/Components/DirectionalLightComponent.h"
-#include "Seraph/Scene/Components/MeshComponent.h"
-#include "Seraph/Scene/Entity.h"
 #include "Seraph/Scene/Scene.h"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstring>
+#include <limits>
 #include <bgfx/bgfx.h>
 #include <glm/gtc/matrix_inverse.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -27,19 +29,242 @@ namespace Seraph
 {
 struct TransformComponent;
 
+SP_CVAR(CVarFrustumCulling, bool, "r.cull.frustum", true, CVarFlag_None,
+        "Skip meshes/submeshes outside the camera frustum and shadow casters "
+        "outside each cascade's light volume");
+SP_CVAR(CVarInstancing, bool, "r.instancing", true, CVarFlag_None,
+        "Draw repeated mesh/submesh/material groups with one instanced submit");
+SP_CVAR(CVarParallelSubmit, bool, "r.parallelSubmit", true, CVarFlag_None,
+        "Cull and record the shadow cascades on worker threads (bgfx encoders)");
+SP_CVAR(CVarMaxLights, u32, "r.lights.max", c_MaxLights, CVarFlag_None,
+        "Point/spot light budget per frame; the least important visible lights "
+        "beyond it are dropped (capped at c_MaxLights)");
+SP_CVAR(CVarLodThreshold, f32, "r.lod.threshold", 0.001f, CVarFlag_None,
+        "Largest simplification error a mesh LOD may show on screen, as a fraction "
+        "of the viewport height (0 always draws LOD 0)");
+SP_CVAR(CVarLodBias, s32, "r.lod.bias", 0, CVarFlag_None,
+        "Levels added to every selected mesh LOD (negative = finer)");
+SP_CVAR(CVarLodShadowBias, u32, "r.lod.shadowBias", 1, CVarFlag_None,
+        "Levels coarser than the camera's LOD used for shadow casters");
+SP_CVAR(CVarShadowCache, bool, "r.shadow.cache", true, CVarFlag_None,
+        "Keep static shadow casters in persistent cascade tiles, redrawn only when "
+        "the cascade moves or the static set changes");
+SP_CVAR(CVarShadowStaticFrames, u32, "r.shadow.staticFrames", 60, CVarFlag_None,
+        "Frames an entity's mesh and transform must hold before its shadow is cached");
+SP_CVAR(CVarShadowFarInterval, u32, "r.shadow.farInterval", 4, CVarFlag_None,
+        "With r.shadow.cache, far cascades that have not moved redraw their dynamic "
+        "casters every N frames (1 = every frame)");
+SP_CVAR(CVarOcclusionCulling, bool, "r.cull.occlusion", true, CVarFlag_None,
+        "Skip meshes hidden behind occluder meshes (MeshComponent::Occluder), tested "
+        "against a CPU-rasterised depth buffer");
+
+// Smallest group worth an instanced submit; smaller runs take the plain path.
+constexpr u32 c_MinInstanceBatch = 2;
+
+// Cached cascades: the first cascade r.shadow.farInterval applies to, and the
+// light-space step the cascade centre moves in, as a fraction of its radius.
+constexpr int   c_FirstFarCascade = 2;
+constexpr float c_ShadowCacheSnap = 0.125f;
+
+namespace
+{
+// Stats of the most recently ended scene, for the `r.stats` command (the live
+// counters are reset every BeginScene).
+SceneRendererStats s_LastStats;
+
+// Dense id for `ptr` within this frame (first seen -> next id).
+u32 FrameId(std::unordered_map<const void*, u32>& ids, const void* ptr)
+{
+    return ids.try_emplace(ptr, static_cast<u32>(ids.size())).first->second;
+}
+
+// Fingerprint of one static caster: FNV-1a over its entity, mesh and world
+// matrix. A cascade's static set hash is the sum over the static casters it
+// covers, so it ignores submission order.
+u64 CasterHash(const RenderObject& object)
+{
+    u64 hash = 14695981039346656037ull;
+    const auto mix = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const u8*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    const u64 entity = object.Entity;
+    mix(&entity, sizeof(entity));
+    mix(&object.SourceMesh, sizeof(object.SourceMesh));
+    mix(glm::value_ptr(object.Transform), sizeof(glm::mat4));
+    return hash;
+}
+
+// Monotonic integer for a non-negative view depth: the bit pattern of a
+// positive float orders like the float, and its top bits are a logarithmic
+// bucket (exponent + leading mantissa), so near draws get the finer buckets.
+u32 DepthBits(float viewDepth, u32 bits)
+{
+    const float d = std::max(viewDepth, 0.0f);
+    u32 raw;
+    std::memcpy(&raw, &d, sizeof(raw));
+    return raw >> (31 - bits);
+}
+
+// 64-bit draw sort key, ascending = submission order (see RenderItem::SortKey):
+//   opaque:      layer:2 | 0:1 | program:11 | material:14 | mesh:14 | submesh:8 | lod:2 | depth:12
+//   translucent: layer:2 | 1:1 | ~depth:24  | program:11 | material:14 | pad:12
+// Opaque draws are state-major (fewest program/material rebinds) then front-to-
+// back for early-Z; translucent draws are back-to-front for correct blending,
+// state only breaking depth ties. Ids are dense per-frame and wrap past their
+// field width — that only costs sort quality, runs are matched on the real
+// mesh/submesh/material.
+u64 MakeSortKey(
+    RenderLayer layer, bool translucent, u16 program, u32 materialId, u32 meshId,
+    u32 submeshIndex, u32 lod, float viewDepth)
+{
+    static_assert(Mesh::c_MaxLods <= 4, "lod sort-key field is 2 bits");
+    u64 key = static_cast<u64>(static_cast<u8>(layer) & 0x3) << 62;
+    if (!translucent) {
+        return key |
+            (static_cast<u64>(program & 0x7FF) << 50) |
+            (static_cast<u64>(materialId & 0x3FFF) << 36) |
+            (static_cast<u64>(meshId & 0x3FFF) << 22) |
+            (static_cast<u64>(submeshIndex & 0xFF) << 14) |
+            (static_cast<u64>(lod & 0x3) << 12) |
+            static_cast<u64>(DepthBits(viewDepth, 12));
+    }
+    const u32 backToFront = ~DepthBits(viewDepth, 24) & 0xFFFFFF;
+    return key | (u64{1} << 61) |
+        (static_cast<u64>(backToFront) << 37) |
+        (static_cast<u64>(program & 0x7FF) << 26) |
+        (static_cast<u64>(materialId & 0x3FFF) << 12);
+}
+
+// Sphere bounding a local light's reach: its range sphere for a point light;
+// for a spot light, the smallest sphere around the cone (apex, axis, range,
+// outer half-angle recovered from the precomputed falloff).
+BoundingSphere LightBounds(const SceneRendererLight& light)
+{
+    if (light.Type != 2 || light.SpotScale <= 0.0f)
+        return {light.Position, light.Range};
+    const float cosOuter = std::clamp(-light.SpotOffset / light.SpotScale, -1.0f, 1.0f);
+    if (cosOuter <= 0.70710678f) {
+        // Wide cone (>= 45 degrees): centred on the cap's base disc.
+        const float sinOuter = std::sqrt(1.0f - cosOuter * cosOuter);
+        return {light.Position + light.Direction * (light.Range * std::max(cosOuter, 0.0f)),
+                light.Range * (cosOuter > 0.0f ? sinOuter : 1.0f)};
+    }
+    // Narrow cone: circumsphere of the apex and the base rim.
+    const float radius = light.Range / (2.0f * cosOuter);
+    return {light.Position + light.Direction * radius, radius};
+}
+
+// How much of the frame a local light is likely to light: its luminous
+// intensity times its bounding sphere's squared angular size as seen from the
+// camera (a camera inside the sphere sees it fill the screen). Unbounded lights
+// (range 0) reach every fragment and rank first.
+float LightImportance(const SceneRendererLight& light, const glm::vec3& cameraPos, float nearClip)
+{
+    if (light.Range <= 0.0f)
+        return std::numeric_limits<float>::infinity();
+    const float luminance =
+        glm::dot(light.Color, glm::vec3(0.2126f, 0.7152f, 0.0722f)) * light.Intensity;
+    const BoundingSphere bounds = LightBounds(light);
+    const float gap = glm::length(bounds.Center - cameraPos) - bounds.Radius;
+    const float size = bounds.Radius / std::max(gap, std::max(nearClip, 1e-3f));
+    return luminance * size * size;
+}
+
+// Two items can share an instanced submit: same geometry range and material.
+bool SameBatch(const RenderList& list, const RenderItem& a, const RenderItem& b)
+{
+    const RenderObject& objectA = list.Objects[a.Object];
+    const RenderObject& objectB = list.Objects[b.Object];
+    return a.Material == b.Material && a.SubmeshIndex == b.SubmeshIndex &&
+        objectA.SourceMesh == objectB.SourceMesh && objectA.Lod == objectB.Lod;
+}
+
+// Coarsest level of `mesh` whose simplification error, seen from `distance`
+// (world units; scaled by the object's largest axis scale `scale`), stays
+// within `threshold` of the viewport height under projection `proj`.
+u32 SelectLod(const Mesh& mesh, float distance, float scale, const glm::mat4& proj,
+              float threshold)
+{
+    // proj[1][1] = 1 / tan(fovY / 2): NDC height per view-space unit at depth 1
+    // (halved: NDC spans 2). Orthographic projections don't divide by depth.
+    const bool orthographic = proj[3][3] == 1.0f;
+    const float screenPerUnit = proj[1][1] * 0.5f * scale / (orthographic ? 1.0f : distance);
+    u32 lod = 0;
+    while (threshold > 0.0f && lod + 1 < mesh.LodCount() &&
+           mesh.LodError(lod + 1) * screenPerUnit <= threshold)
+        ++lod;
+    return lod;
+}
+} // namespace
+
+SP_CONSOLE_COMMAND("r.stats", "Print the last scene frame's visibility counters",
+    [](const ConsoleCommandArgs&)
+    {
+        SP_CONSOLE_LOG_INFO("Meshes:    {} visible ({} below LOD 0), {} culled",
+                            s_LastStats.MeshesVisible, s_LastStats.MeshesReducedLod,
+                            s_LastStats.MeshesCulled);
+        SP_CONSOLE_LOG_INFO("Occlusion: {} occluders ({} triangles), {} of {} tested occluded",
+                            s_LastStats.Occluders, s_LastStats.OccluderTriangles,
+                            s_LastStats.MeshesOccluded, s_LastStats.OcclusionTested);
+        SP_CONSOLE_LOG_INFO("Submeshes: {} visible, {} culled",
+                            s_LastStats.SubmeshesVisible, s_LastStats.SubmeshesCulled);
+        SP_CONSOLE_LOG_INFO("Shadow casters (all cascades): {} drawn, {} culled",
+                            s_LastStats.ShadowCastersDrawn, s_LastStats.ShadowCastersCulled);
+        SP_CONSOLE_LOG_INFO("Shadow cache: {} static tiles redrawn, {} cascades reused",
+                            s_LastStats.ShadowStaticTiles, s_LastStats.ShadowCascadesReused);
+        SP_CONSOLE_LOG_INFO("Instancing: {} instances in {} batches",
+                            s_LastStats.InstancedDraws, s_LastStats.InstanceBatches);
+        SP_CONSOLE_LOG_INFO("Scene pass: {} submits, {} program changes, {} material changes",
+                            s_LastStats.SceneSubmits, s_LastStats.ProgramChanges,
+                            s_LastStats.MaterialChanges);
+        SP_CONSOLE_LOG_INFO("Lights: {} culled, {} dropped over budget",
+                            s_LastStats.LightsCulled, s_LastStats.LightsDropped);
+        SP_CONSOLE_LOG_INFO("Light grid: {} local lights, {} index entries, {} dropped",
+                            s_LastStats.ClusteredLights, s_LastStats.LightIndexEntries,
+                            s_LastStats.LightIndexDropped);
+    });
+
 SceneRenderer::SceneRenderer(
     Ref<Scene> scene, const SceneRendererSettings& settings) : m_Scene(scene), m_Settings(settings)
 {}
 
+SceneRenderer::~SceneRenderer()
+{
+    FinishShadowCascades();
+    FinishOcclusion();
+    // A renderer later allocated at this address must not inherit the tiles;
+    // another renderer's claim is left alone.
+    Renderer::ReleaseShadowAtlas(this);
+}
+
 void SceneRenderer::BeginScene(const SceneRendererCamera& camera)
 {
     Renderer::Begin(camera.Camera.GetViewId());
     m_SceneRenderData.SceneCamera = camera;
     m_Lights.clear();
+    m_LightImportance.clear();
     m_LightsUploaded = false;
+    // A cull left pending (no scene pass ran) must not outlive the list.
+    FinishOcclusion();
+    m_Stats = {};
+    m_RenderList.Clear();
+    m_ScenePassDone = false;
+    m_FrustumTested = 0;
+    m_MeshIds.clear();
+    m_MaterialIds.clear();
 
     auto& sceneCamera = m_SceneRenderData.SceneCamera;
+    // Draws go out already ordered by RenderItem::SortKey (plus skybox/debug
+    // after them); keep that order instead of bgfx's own per-view sort.
+    bgfx::setViewMode(camera.Camera.GetViewId(), bgfx::ViewMode::Sequential);
     bgfx::setViewTransform(camera.Camera.GetViewId(), glm::value_ptr(sceneCamera.ViewMatrix), glm::value_ptr(sceneCamera.Camera.GetProjectionMatrix()));
+    m_SceneRenderData.CameraFrustum = Frustum::FromMatrix(
+        sceneCamera.Camera.GetUnReversedProjectionMatrix() * sceneCamera.ViewMatrix);
+    m_SceneRenderData.CameraPosition = glm::vec3(glm::inverse(sceneCamera.ViewMatrix)[3]);
 
     BindEnvironment();
 }
@@ -70,6 +295,10 @@ void SceneRenderer::BindEnvironment()
 
 void SceneRenderer::EndScene()
 {
+    RenderScenePass();
+    // Worker encoders must be ended before the frame is flushed.
+    FinishShadowCascades();
+    s_LastStats = m_Stats;
     m_SceneRenderData = {};
     Renderer::End();
 }
@@ -81,97 +310,341 @@ void SceneRenderer::SetScene(Ref<Scene> scene)
 
 void SceneRenderer::SubmitLight(const SceneRendererLight& light)
 {
-    if (m_Lights.size() < c_MaxLights)
-        m_Lights.push_back(light);
+    float importance = 0.0f;
+    if (light.Type != 0) {
+        if (CVarFrustumCulling.Get() && light.Range > 0.0f &&
+            m_SceneRenderData.CameraFrustum.Test(LightBounds(light)) == FrustumTest::Outside) {
+            ++m_Stats.LightsCulled;
+            return;
+        }
+        importance = LightImportance(light, m_SceneRenderData.CameraPosition,
+                                     m_SceneRenderData.SceneCamera.Near);
+    }
+    m_Lights.push_back(light);
+    m_LightImportance.push_back(importance);
 }
 
-void SceneRenderer::UploadLightUniforms()
+void SceneRenderer::RankLights()
 {
-    const auto count = static_cast<u32>(std::min<size_t>(m_Lights.size(), c_MaxLights));
-
-    std::array<glm::vec4, c_MaxLights> posRange{};
-    std::array<glm::vec4, c_MaxLights> colorIntensity{};
-    std::array<glm::vec4, c_MaxLights> dirType{};
-    std::array<glm::vec4, c_MaxLights> spot{};
-    for (u32 i = 0; i < count; ++i) {
-        const SceneRendererLight& L = m_Lights[i];
-        posRange[i] = glm::vec4(L.Position, L.Range);
-        colorIntensity[i] = glm::vec4(L.Color, L.Intensity);
-        dirType[i] = glm::vec4(L.Direction, static_cast<float>(L.Type));
-        spot[i] = glm::vec4(L.SpotScale, L.SpotOffset, 0.0f, 0.0f);
-    }
+    // Directional lights first in submission order (the sun stays first), then
+    // local lights by descending importance.
+    const auto count = static_cast<u32>(m_Lights.size());
+    m_LightOrder.resize(count);
+    for (u32 i = 0; i < count; ++i)
+        m_LightOrder[i] = i;
+    std::stable_sort(m_LightOrder.begin(), m_LightOrder.end(), [this](u32 a, u32 b) {
+        const bool directionalA = m_Lights[a].Type == 0;
+        const bool directionalB = m_Lights[b].Type == 0;
+        if (directionalA != directionalB)
+            return directionalA;
+        return m_LightImportance[a] > m_LightImportance[b];
+    });
+
+    u32 directional = 0;
+    while (directional < count && m_Lights[m_LightOrder[directional]].Type == 0)
+        ++directional;
+    const u32 keptDirectional = std::min(directional, c_MaxDirectionalLights);
+    const u32 budget = std::min(CVarMaxLights.Get(), c_MaxLights - keptDirectional);
+    const u32 keptLocal = std::min(count - directional, budget);
+
+    m_RankedLights.clear();
+    for (u32 i = 0; i < keptDirectional; ++i)
+        m_RankedLights.push_back(m_Lights[m_LightOrder[i]]);
+    for (u32 i = 0; i < keptLocal; ++i)
+        m_RankedLights.push_back(m_Lights[m_LightOrder[directional + i]]);
+    m_Stats.LightsDropped = count - keptDirectional - keptLocal;
+    m_Lights.swap(m_RankedLights);
+}
 
-    const glm::vec3 camPos = glm::vec3(glm::inverse(m_SceneRenderData.SceneCamera.ViewMatrix)[3]);
-    const glm::vec4 cameraPos(camPos, 1.0f);
-    const glm::vec4 lightCount(static_cast<float>(count), 0.0f, 0.0f, 0.0f);
+void SceneRenderer::UploadLightUniforms()
+{
+    RankLights();
+    const SceneRendererCamera& cam = m_SceneRenderData.SceneCamera;
+    m_LightGrid.Build(m_Lights, cam.ViewMatrix, cam.Camera.GetUnReversedProjectionMatrix(),
+                      cam.Near, cam.Far);
+    Renderer::LightGridBinding binding = m_LightGrid.GetBinding();
+    binding.targetHeight = static_cast<float>(m_TargetHeight);
+    Renderer::SetLightGrid(binding);
+
+    const LightGridStats& grid = m_LightGrid.GetStats();
+    m_Stats.ClusteredLights = grid.LocalLights;
+    m_Stats.LightIndexEntries = grid.IndexEntries;
+    m_Stats.LightIndexDropped = grid.DroppedEntries;
+
+    const glm::vec4 cameraPos(m_SceneRenderData.CameraPosition, 1.0f);
+    // x: directional lights (light data rows [0, x)), looped by every fragment.
+    const glm::vec4 lightCount(static_cast<float>(grid.DirectionalLights),
+                               static_cast<float>(grid.LocalLights), 0.0f, 0.0f);
     const glm::vec4 ambient(m_Settings.AmbientColor * m_Settings.AmbientIntensity, 1.0f);
 
-    using bgfx::UniformType::Vec4;
-    bgfx::setUniform(UniformCache::GetOrCreate("u_lightCount", Vec4), &lightCount);
-    bgfx::setUniform(UniformCache::GetOrCreate("u_ambient", Vec4), &ambient);
-    bgfx::setUniform(UniformCache::GetOrCreate("u_cameraPos", Vec4), &cameraPos);
-
-    // Arrays are always created at full c_MaxLights; only `count` elements are
-    // pushed (the shader loop is bounded by u_lightCount). Skip when there are no
-    // lights so we never call setUniform with num == 0.
-    if (count > 0) {
-        const auto posRangeH = UniformCache::GetOrCreate("u_lightPosRange", Vec4, c_MaxLights);
-        const auto colorH = UniformCache::GetOrCreate("u_lightColorIntensity", Vec4, c_MaxLights);
-        const auto dirTypeH = UniformCache::GetOrCreate("u_lightDirType", Vec4, c_MaxLights);
-        const auto spotH = UniformCache::GetOrCreate("u_lightSpot", Vec4, c_MaxLights);
-        bgfx::setUniform(posRangeH, posRange.data(), count);
-        bgfx::setUniform(colorH, colorIntensity.data(), count);
-        bgfx::setUniform(dirTypeH, dirType.data(), count);
-        bgfx::setUniform(spotH, spot.data(), count);
+    // Handles are looked up by name once per renderer, not every frame.
+    if (!m_LightUniforms.Resolved) {
+        using bgfx::UniformType::Vec4;
+        m_LightUniforms.LightCount = UniformCache::GetOrCreate("u_lightCount", Vec4);
+        m_LightUniforms.Ambient = UniformCache::GetOrCreate("u_ambient", Vec4);
+        m_LightUniforms.CameraPos = UniformCache::GetOrCreate("u_cameraPos", Vec4);
+        m_LightUniforms.Resolved = true;
     }
+
+    bgfx::setUniform(m_LightUniforms.LightCount, &lightCount);
+    bgfx::setUniform(m_LightUniforms.Ambient, &ambient);
+    bgfx::setUniform(m_LightUniforms.CameraPos, &cameraPos);
 }
 
 void SceneRenderer::SubmitMesh(
     const Mesh& mesh, const glm::mat4& transform,
-    const std::vector<AssetHandle>& materialOverrides)
+    const std::vector<AssetHandle>& materialOverrides, UUID entity, bool occluder)
+{
+    RenderObject object;
+    object.SourceMesh = &mesh;
+    object.Transform = transform;
+    object.Entity = entity;
+    object.Occluder = occluder;
+    if (mesh.Bounds().IsValid()) {
+        const float maxScale = std::max({glm::length(glm::vec3(transform[0])),
+            glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))});
+        object.WorldBounds = mesh.Bounds().Transformed(transform);
+        object.WorldSphere = {glm::vec3(transform * glm::vec4(mesh.Sphere().Center, 1.0f)),
+            mesh.Sphere().Radius * maxScale};
+
+        // Level of detail from the distance to the bounds (not the origin), so a
+        // large mesh the camera is close to keeps full detail.
+        if (mesh.LodCount() > 1) {
+            const SceneRendererCamera& cam = m_SceneRenderData.SceneCamera;
+            const float distance = std::max(
+                glm::length(object.WorldSphere.Center - m_SceneRenderData.CameraPosition) -
+                    object.WorldSphere.Radius,
+                cam.Near);
+            const s32 coarsest = static_cast<s32>(mesh.LodCount()) - 1;
+            const s32 selected = static_cast<s32>(SelectLod(mesh, distance, maxScale,
+                cam.Camera.GetUnReversedProjectionMatrix(), CVarLodThreshold.Get()));
+            object.Lod =
+                static_cast<u32>(std::clamp<s32>(selected + CVarLodBias.Get(), 0, coarsest));
+            object.ShadowLod = std::min(object.Lod + CVarLodShadowBias.Get(),
+                                        static_cast<u32>(coarsest));
+        }
+    }
+    object.FirstItem = static_cast<u32>(m_RenderList.Items.size());
+
+    const auto objectIndex = static_cast<u32>(m_RenderList.Objects.size());
+    const u32 meshId = FrameId(m_MeshIds, &mesh);
+    // Camera-space depth of the object's origin (or bounds centre), for the
+    // front-to-back / back-to-front part of the sort keys.
+    const glm::vec3 keyPoint = object.WorldBounds.IsValid()
+        ? object.WorldSphere.Center : glm::vec3(transform[3]);
+    const float viewDepth =
+        -(m_SceneRenderData.SceneCamera.ViewMatrix * glm::vec4(keyPoint, 1.0f)).z;
+    const std::vector<Mesh::Submesh>& submeshes = mesh.Submeshes();
+    const u32 submeshCount = submeshes.empty() ? 1 : static_cast<u32>(submeshes.size());
+    for (u32 i = 0; i < submeshCount; ++i) {
+        RenderItem item;
+        item.Object = objectIndex;
+        item.SubmeshIndex = i;
+        mesh.SubmeshRange(i, object.Lod, item.BaseIndex, item.IndexCount);
+        const u32 slot = submeshes.empty() ? 0 : submeshes[i].MaterialSlot;
+        item.Material = Renderer::ResolveMaterial(mesh, slot, materialOverrides);
+        if (item.Material) {
+            const bool translucent = item.Material->Resolve().State.Blend != BlendMode::Opaque;
+            item.Program = item.Material->Program();
+            item.SortKey = MakeSortKey(RenderLayer::World, translucent, item.Program.idx,
+                FrameId(m_MaterialIds, item.Material.Raw()), meshId, i, object.Lod, viewDepth);
+        }
+        m_RenderList.Items.push_back(std::move(item));
+    }
+    object.ItemCount = submeshCount;
+    m_RenderList.Objects.push_back(object);
+}
+
+void SceneRenderer::RenderScenePass()
 {
+    if (m_ScenePassDone)
+        return;
+    m_ScenePassDone = true;
+    FinishOcclusion();
+    if (m_RenderList.Items.empty())
+        return;
+
     if (!m_LightsUploaded) {
         UploadLightUniforms();
         m_LightsUploaded = true;
     }
-    Renderer::SubmitMesh(mesh, transform, materialOverrides);
+    // IBL + shadow state is the same for every draw of the view: bind it once
+    // (the environment was set in BeginScene, the cascades ended already).
+    Renderer::EncoderContext context =
+        Renderer::MakeContext(m_SceneRenderData.SceneCamera.Camera.GetViewId());
+    Renderer::BeginViewBindings(context);
+
+    // Visibility (objects CullOcclusion already tested keep their result). Only
+    // a straddling object with several submeshes tests each submesh's own box.
+    CullFrustum();
+    const Frustum& frustum = m_SceneRenderData.CameraFrustum;
+    m_VisibleItems.clear();
+    for (const RenderObject& object : m_RenderList.Objects) {
+        const FrustumTest test = object.Visibility;
+        if (test == FrustumTest::Outside) {
+            ++m_Stats.MeshesCulled;
+            m_Stats.SubmeshesCulled += object.ItemCount;
+            continue;
+        }
+        if (object.Occluded) {
+            ++m_Stats.MeshesOccluded;
+            m_Stats.SubmeshesCulled += object.ItemCount;
+            continue;
+        }
+
+        ++m_Stats.MeshesVisible;
+        if (object.Lod > 0)
+            ++m_Stats.MeshesReducedLod;
+        const std::vector<Mesh::Submesh>& submeshes = object.SourceMesh->Submeshes();
+        const bool testSubmeshes = test != FrustumTest::Inside && submeshes.size() > 1;
+        for (u32 i = object.FirstItem; i < object.FirstItem + object.ItemCount; ++i) {
+            if (testSubmeshes) {
+                const AABB& bounds = submeshes[m_RenderList.Items[i].SubmeshIndex].Bounds;
+                if (bounds.IsValid() && !frustum.Intersects(bounds.Transformed(object.Transform))) {
+                    ++m_Stats.SubmeshesCulled;
+                    continue;
+                }
+            }
+            ++m_Stats.SubmeshesVisible;
+            m_VisibleItems.push_back(i);
+        }
+    }
+
+    // Sort into submission order; identical mesh/submesh/material draws end up
+    // adjacent (opaque ones differ only in the depth bits), forming the
+    // instancing runs. The scene view is Sequential, so this order is final.
+    const std::vector<RenderItem>& items = m_RenderList.Items;
+    std::sort(m_VisibleItems.begin(), m_VisibleItems.end(),
+        [&](u32 a, u32 b) { return items[a].SortKey < items[b].SortKey; });
+
+    const bool instancing = CVarInstancing.Get();
+    const size_t count = m_VisibleItems.size();
+    const MaterialAsset* lastMaterial = nullptr;
+    u16 lastProgram = bgfx::kInvalidHandle;
+    for (size_t begin = 0; begin < count;) {
+        const RenderItem& head = items[m_VisibleItems[begin]];
+        size_t end = begin + 1;
+        while (end < count && SameBatch(m_RenderList, items[m_VisibleItems[end]], head))
+            ++end;
+
+        // Rebind counters: every run binds its material's program + parameters.
+        if (head.Material && head.Material.Raw() != lastMaterial) {
+            ++m_Stats.MaterialChanges;
+            lastMaterial = head.Material.Raw();
+            if (head.Program.idx != lastProgram)
+                ++m_Stats.ProgramChanges;
+            lastProgram = head.Program.idx;
+        }
+
+        const RenderObject& headObject = m_RenderList.Objects[head.Object];
+        const Mesh& mesh = *headObject.SourceMesh;
+        const auto runCount = static_cast<u32>(end - begin);
+        u32 drawn = 0;
+        if (instancing && runCount >= c_MinInstanceBatch) {
+            m_InstanceTransforms.clear();
+            for (size_t i = begin; i < end; ++i)
+                m_InstanceTransforms.push_back(
+                    m_RenderList.Objects[items[m_VisibleItems[i]].Object].Transform);
+            // SubmitInstanced may draw only a prefix (transient space); keep
+            // going until it stops making progress.
+            while (drawn < runCount) {
+                const u32 n = Renderer::SubmitInstanced(context, mesh, head.SubmeshIndex,
+                    head.Material, m_InstanceTransforms.data() + drawn, runCount - drawn,
+                    headObject.Lod);
+                if (n == 0)
+                    break;
+                drawn += n;
+                ++m_Stats.InstanceBatches;
+                ++m_Stats.SceneSubmits;
+            }
+            m_Stats.InstancedDraws += drawn;
+        }
+        // Singletons, shaders without an instanced variant, and any overflow.
+        m_Stats.SceneSubmits += runCount - drawn;
+        for (size_t i = begin + drawn; i < end; ++i) {
+            const RenderItem& item = items[m_VisibleItems[i]];
+            Renderer::SubmitSubmesh(context, mesh, item.SubmeshIndex,
+                m_RenderList.Objects[item.Object].Transform, item.Material, headObject.Lod);
+        }
+        begin = end;
+    }
+    Renderer::EndViewBindings(context);
+    // The grid's textures belong to this renderer; don't leave them bound for
+    // another one's submits.
+    Renderer::ClearLightGrid();
 }
 
 void SceneRenderer::RenderSunShadow()
 {
-    if (!m_Scene) {
+    // The sun is the first submitted directional light.
+    const auto sun = std::find_if(m_Lights.begin(), m_Lights.end(),
+        [](const SceneRendererLight& light) { return light.Type == 0; });
+    if (sun == m_Lights.end()) {
         Renderer::ClearShadow();
         return;
     }
 
-    // The sun is the first directional light. Direction of travel = world -Z.
-    glm::vec3 lightDir(0.0f);
-    bool haveSun = false;
-    for (auto [e, dl] : m_Scene->GetAllEntitiesWith<DirectionalLightComponent>().each()) {
-        (void)dl;
-        const glm::mat4 world = m_Scene->GetWorldSpaceTransformMatrix({e, m_Scene.Raw()});
-        lightDir = glm::normalize(glm::mat3(world) * glm::vec3(0.0f, 0.0f, -1.0f));
-        haveSun = true;
-        break;
-    }
-    if (!haveSun) {
-        Renderer::ClearShadow();
-        return;
-    }
+    const glm::vec3 lightDir = sun->Direction;
 
-    constexpr int   kNumCascades   = 4;     // must be <= Renderer's kMaxCascades
+    constexpr int   kNumCascades   = c_ShadowCascades;
     constexpr float kShadowDistance = 60.0f; // max view distance the CSM covers
     constexpr float kCasterPull    = 30.0f;  // near-plane pull-back for tall casters
 
-    // Gather shadow casters once (reused across all cascade passes).
-    struct Caster { const Mesh* mesh; glm::mat4 transform; };
-    std::vector<Caster> casters;
-    for (auto [e, mc] : m_Scene->GetAllEntitiesWith<MeshComponent>().each()) {
-        if (Ref<Mesh> mesh = mc.Mesh.As())
-            casters.push_back({ mesh.Raw(),
-                m_Scene->GetWorldSpaceTransformMatrix({e, m_Scene.Raw()}) });
+    // Cached cascades. The tiles persist across frames, so they are only
+    // trusted while this renderer was the last to draw them. A caster is static
+    // once its entity's mesh and transform have held for r.shadow.staticFrames
+    // consecutive frames. Each cascade hashes the static casters inside its
+    // light volume, so one joining, leaving or moving re-renders only the
+    // static tiles it touches.
+    const bool cache = CVarShadowCache.Get();
+    if (!Renderer::ClaimShadowAtlas(this) || !cache)
+        m_CachedCascades = {};
+    ++m_ShadowFrame;
+    if (cache) {
+        const u32 staticFrames = CVarShadowStaticFrames.Get();
+        for (RenderObject& object : m_RenderList.Objects) {
+            object.StaticCaster = false;
+            if (object.Entity == 0)
+                continue;
+            CasterHistory& history = m_CasterHistory[object.Entity];
+            if (history.LastFrame + 1 == m_ShadowFrame &&
+                history.SourceMesh == object.SourceMesh && history.Transform == object.Transform) {
+                history.StableFrames = std::min(history.StableFrames + 1, staticFrames);
+            } else {
+                history.SourceMesh = object.SourceMesh;
+                history.Transform = object.Transform;
+                history.StableFrames = 0;
+            }
+            history.LastFrame = m_ShadowFrame;
+            object.StaticCaster = history.StableFrames >= staticFrames;
+        }
+        for (auto it = m_CasterHistory.begin(); it != m_CasterHistory.end();) {
+            if (it->second.LastFrame != m_ShadowFrame)
+                it = m_CasterHistory.erase(it);
+            else
+                ++it;
+        }
+    } else {
+        m_CasterHistory.clear();
+        for (RenderObject& object : m_RenderList.Objects)
+            object.StaticCaster = false;
     }
 
+    // Casters are the render list's objects (whole meshes at their ShadowLod,
+    // reused across all cascade passes), split static / dynamic and grouped by
+    // mesh + level so each cascade's surviving casters form instancing runs.
+    m_ShadowCasters.clear();
+    m_ShadowCasters.reserve(m_RenderList.Objects.size());
+    for (const RenderObject& object : m_RenderList.Objects)
+        m_ShadowCasters.push_back(&object);
+    std::sort(m_ShadowCasters.begin(), m_ShadowCasters.end(),
+        [](const RenderObject* a, const RenderObject* b) {
+            if (a->StaticCaster != b->StaticCaster)
+                return a->StaticCaster;
+            return a->SourceMesh != b->SourceMesh ? a->SourceMesh < b->SourceMesh
+                                                  : a->ShadowLod < b->ShadowLod;
+        });
+
     // --- Camera basis + frustum params (for fitting cascades to the view) ----
     const SceneRendererCamera& cam = m_SceneRenderData.SceneCamera;
     const glm::mat4 invView = glm::inverse(cam.ViewMatrix);
@@ -252,6 +725,16 @@ void SceneRenderer::RenderSunShadow()
         for (const glm::vec3& p : corners)
             radius = std::max(radius, glm::length(p - sphereCenter));
         radius = std::ceil(radius * 16.0f) / 16.0f; // quantize -> stable
+        if (cache) {
+            // Move the cascade in coarse light-space steps (and grow it by one so
+            // the slice stays covered), so its projection, and with it the
+            // static tile, holds while the camera wanders within a step.
+            const float step = radius * c_ShadowCacheSnap;
+            const glm::mat3 lightBasis(glm::lookAt(glm::vec3(0.0f), lightDir, up));
+            sphereCenter =
+                glm::transpose(lightBasis) * (glm::round(lightBasis * sphereCenter / step) * step);
+            radius += step;
+        }
 
         const glm::vec3 eye = sphereCenter - lightDir * radius;
         glm::mat4 lightView = glm::lookAt(eye, sphereCenter, up);
@@ -273,10 +756,81 @@ void SceneRenderer::RenderSunShadow()
 
         shadowMtx[c] = crop * lightProj * lightView;
         normalizedBias[c] = gs.ShadowBias / depthRange;
+        const Frustum lightFrustum = Frustum::FromMatrix(lightProj * lightView);
+
+        // Static casters sort first; those outside the light volume can't
+        // reach this cascade's tile.
+        u64 staticHash = 0;
+        if (cache) {
+            for (const RenderObject* caster : m_ShadowCasters) {
+                if (!caster->StaticCaster)
+                    break;
+                if (!caster->WorldBounds.IsValid() || lightFrustum.Intersects(caster->WorldBounds))
+                    staticHash += CasterHash(*caster);
+            }
+        }
 
-        Renderer::BeginShadowCascade(c, lightView, lightProj);
-        for (const Caster& caster : casters)
-            Renderer::SubmitShadowCaster(c, *caster.mesh, caster.transform);
+        CachedCascade& cached = m_CachedCascades[c];
+        const bool moved = !cached.FrameValid || cached.LightView != lightView ||
+            cached.LightProj != lightProj;
+        const bool staticChanged = !cached.StaticValid || cached.StaticHash != staticHash;
+        // A far cascade that has not moved keeps its whole tile between refreshes
+        // (staggered across cascades); only its dynamic casters lag behind.
+        const u32 farInterval = std::max(CVarShadowFarInterval.Get(), 1u);
+        if (cache && !moved && !staticChanged && c >= c_FirstFarCascade &&
+            (m_ShadowFrame + static_cast<u64>(c)) % farInterval != 0) {
+            ++m_Stats.ShadowCascadesReused;
+            continue;
+        }
+
+        ShadowCascadeWork& work = m_ShadowCascades[c];
+        work.LightFrustum = lightFrustum;
+        work.Sweep = lightDir * depthRange;
+        work.ZNear = zNear;
+        work.CameraPos = camPos;
+        work.CameraForward = camFwd;
+        work.Stats = {};
+        work.Active = true;
+        work.DrawStatic = cache && (moved || staticChanged);
+        work.Dropped = false;
+        // Static tile first (lower view ids), so the frame tile composes it.
+        if (work.DrawStatic) {
+            work.StaticContext = Renderer::BeginShadowCascade(
+                c, Renderer::ShadowAtlas::Static, lightView, lightProj);
+            ++m_Stats.ShadowStaticTiles;
+        }
+        work.FrameContext = Renderer::BeginShadowCascade(
+            c, Renderer::ShadowAtlas::Frame, lightView, lightProj);
+        if (cache)
+            Renderer::ComposeStaticShadow(c);
+        cached = {cache, cache, lightView, lightProj, staticHash};
+    }
+
+    // Every cascade view is set up, so the casters can be recorded in any order
+    // and from any thread: one job per cascade on its own encoder, overlapping
+    // the main thread's scene pass.
+    if (CVarParallelSubmit.Get()) {
+        if (!m_SubmitPool)
+            m_SubmitPool = std::make_unique<ThreadPool>(kNumCascades, "RenderWorker");
+        for (int c = 0; c < kNumCascades; ++c) {
+            if (!m_ShadowCascades[c].Active)
+                continue;
+            m_SubmitPool->Enqueue([this, c] {
+                bgfx::Encoder* encoder = bgfx::begin(true);
+                if (!encoder) {
+                    SP_CORE_WARN_TAG("Renderer", "No free bgfx encoder; cascade {} skipped", c);
+                    m_ShadowCascades[c].Dropped = true;
+                    return;
+                }
+                RenderShadowCascade(c, encoder);
+                bgfx::end(encoder);
+            });
+        }
+    } else {
+        for (int c = 0; c < kNumCascades; ++c) {
+            if (m_ShadowCascades[c].Active)
+                RenderShadowCascade(c, nullptr);
+        }
     }
 
     // Max shadow distance (.w) fades the term out at the last cascade's far edge.
@@ -286,8 +840,153 @@ void SceneRenderer::RenderSunShadow()
         gs.ShadowNormalOffset);
 }
 
+void SceneRenderer::RenderShadowCascade(int cascade, bgfx::Encoder* encoder)
+{
+    ShadowCascadeWork& work = m_ShadowCascades[cascade];
+    const bool cullCasters = CVarFrustumCulling.Get();
+    const bool instancing = CVarInstancing.Get();
+    const glm::vec3& camPos = work.CameraPos;
+    const glm::vec3& camFwd = work.CameraForward;
+    const glm::vec3 absFwd = glm::abs(camFwd);
+
+    // Caster culling. The cascade's light volume already reaches kCasterPull
+    // toward the sun, so tall off-screen casters survive; anything outside it
+    // would be clipped by the depth pass anyway. For the outer cascades, also
+    // skip casters whose shadow (the box swept depthRange along the light)
+    // ends before this cascade's view-depth slab starts: every receiver they
+    // can darken is shaded from a nearer cascade.
+    // Cached static casters already sit in the static tile unless it is being
+    // re-rendered this frame.
+    std::vector<const RenderObject*>& visible = work.Visible;
+    visible.clear();
+    for (const RenderObject* caster : m_ShadowCasters) {
+        if (caster->StaticCaster && !work.DrawStatic)
+            continue;
+        const AABB& bounds = caster->WorldBounds;
+        if (cullCasters && bounds.IsValid()) {
+            if (!work.LightFrustum.Intersects(bounds)) {
+                ++work.Stats.ShadowCastersCulled;
+                continue;
+            }
+            if (cascade > 0) {
+                AABB swept = bounds;
+                swept.Expand(AABB(bounds.Min + work.Sweep, bounds.Max + work.Sweep));
+                const float maxDepth = glm::dot(swept.Center() - camPos, camFwd) +
+                    glm::dot(swept.Extents(), absFwd);
+                if (maxDepth < work.ZNear) {
+                    ++work.Stats.ShadowCastersCulled;
+                    continue;
+                }
+            }
+        }
+        visible.push_back(caster);
+    }
+    work.Stats.ShadowCastersDrawn += static_cast<u32>(visible.size());
+
+    // Casters are drawn whole with one program, so any run sharing a mesh and
+    // level instances (casters are already grouped that way, see RenderSunShadow).
+    // Static casters go to the static tile. The contexts were made on the main
+    // thread; this job records through its own copies.
+    Renderer::EncoderContext frameContext = work.FrameContext;
+    Renderer::EncoderContext staticContext = work.StaticContext;
+    frameContext.encoder = encoder;
+    staticContext.encoder = encoder;
+    for (size_t begin = 0; begin < visible.size();) {
+        size_t end = begin + 1;
+        while (end < visible.size() && visible[end]->SourceMesh == visible[begin]->SourceMesh &&
+               visible[end]->ShadowLod == visible[begin]->ShadowLod &&
+               visible[end]->StaticCaster == visible[begin]->StaticCaster)
+            ++end;
+        const Renderer::EncoderContext& context =
+            visible[begin]->StaticCaster ? staticContext : frameContext;
+
+        const auto runCount = static_cast<u32>(end - begin);
+        u32 drawn = 0;
+        if (instancing && runCount >= c_MinInstanceBatch) {
+            work.InstanceTransforms.clear();
+            for (size_t i = begin; i < end; ++i)
+                work.InstanceTransforms.push_back(visible[i]->Transform);
+            while (drawn < runCount) {
+                const u32 n = Renderer::SubmitShadowCastersInstanced(context,
+                    *visible[begin]->SourceMesh, work.InstanceTransforms.data() + drawn,
+                    runCount - drawn, visible[begin]->ShadowLod);
+                if (n == 0)
+                    break;
+                drawn += n;
+                ++work.Stats.InstanceBatches;
+            }
+            work.Stats.InstancedDraws += drawn;
+        }
+        for (size_t i = begin + drawn; i < end; ++i)
+            Renderer::SubmitShadowCaster(context, *visible[i]->SourceMesh,
+                visible[i]->Transform, visible[i]->ShadowLod);
+        begin = end;
+    }
+}
+
+void SceneRenderer::FinishShadowCascades()
+{
+    if (m_SubmitPool)
+        m_SubmitPool->Drain();
+    for (ShadowCascadeWork& work : m_ShadowCascades) {
+        if (!work.Active)
+            continue;
+        m_Stats.ShadowCastersDrawn += work.Stats.ShadowCastersDrawn;
+        m_Stats.ShadowCastersCulled += work.Stats.ShadowCastersCulled;
+        m_Stats.InstancedDraws += work.Stats.InstancedDraws;
+        m_Stats.InstanceBatches += work.Stats.InstanceBatches;
+        // Nothing was recorded, so neither tile holds what the cache says.
+        if (work.Dropped)
+            m_CachedCascades[&work - m_ShadowCascades.data()] = {};
+        work.Active = false;
+    }
+}
+
+void SceneRenderer::CullFrustum()
+{
+    // Objects without bounds are never culled. The world sphere is the cheap
+    // first test; only a straddling sphere pays for the box.
+    const Frustum& frustum = m_SceneRenderData.CameraFrustum;
+    const bool cull = CVarFrustumCulling.Get();
+    for (; m_FrustumTested < m_RenderList.Objects.size(); ++m_FrustumTested) {
+        RenderObject& object = m_RenderList.Objects[m_FrustumTested];
+        FrustumTest test = FrustumTest::Inside;
+        if (cull && object.WorldBounds.IsValid()) {
+            test = frustum.Test(object.WorldSphere);
+            if (test == FrustumTest::Intersects)
+                test = frustum.Test(object.WorldBounds);
+        }
+        object.Visibility = test;
+    }
+}
+
+void SceneRenderer::CullOcclusion()
+{
+    if (!CVarOcclusionCulling.Get() || m_RenderList.Objects.empty())
+        return;
+    // Off-screen objects are never drawn: keep them out of the occlusion
+    // buffer and its tests.
+    CullFrustum();
+    if (!m_OcclusionCuller)
+        m_OcclusionCuller = std::make_unique<OcclusionCuller>();
+    const SceneRendererCamera& camera = m_SceneRenderData.SceneCamera;
+    m_OcclusionCuller->Begin(
+        m_RenderList, camera.Camera.GetUnReversedProjectionMatrix() * camera.ViewMatrix);
+}
+
+void SceneRenderer::FinishOcclusion()
+{
+    if (!m_OcclusionCuller || !m_OcclusionCuller->IsPending())
+        return;
+    const OcclusionStats stats = m_OcclusionCuller->Finish(m_RenderList);
+    m_Stats.Occluders += stats.Occluders;
+    m_Stats.OccluderTriangles += stats.OccluderTriangles;
+    m_Stats.OcclusionTested += stats.Tested;
+}
+
 void SceneRenderer::DrawSkybox()
 {
+    RenderScenePass();
     if (!m_Scene)
         return;
 
@@ -4,15 +4,25 @@
 
 #pragma once
 #include "Camera.h"
+#include "LightGrid.h"
 #include "Mesh.h"
+#include "Material/MaterialAsset.h"
+#include "OcclusionCuller.h"
+#include "RenderList.h"
 #include "Seraph/Asset/AssetHandle.h"
 #include "Seraph/Core/Ref.h"
+#include "Seraph/Core/UUID.h"
+#include "Seraph/Math/Bounds.h"
 
+#include <array>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace Seraph
 {
 class SceneCamera;
+class ThreadPool;
 
 class Scene;
 
@@ -26,11 +36,7 @@ struct SceneRendererSettings
     float AmbientIntensity = 0.03f;
 };
 
-// Max simultaneous lights in the forward loop. MUST match MAX_LIGHTS in the lit
-// shaders (shader/lights.sh) — the uniform arrays are sized to it on both sides.
-inline constexpr u32 c_MaxLights = 16;
-
-// One light packed for the forward loop. Direction is the (normalized) direction
+// One light packed for the clustered forward loop (LightGrid). Direction is the (normalized) direction
 // of travel from the light. Type: 0 = directional, 1 = point, 2 = spot. Spot
 // falloff is precomputed as scale/offset so the shader just does
 // saturate(cosAngle * SpotScale + SpotOffset).
@@ -54,33 +60,97 @@ struct SceneRendererCamera
     f32 FOV;
 };
 
+// Per-frame visibility counters, reset in BeginScene. A mesh is culled when its
+// world bounds miss the camera frustum; a visible mesh that straddles the frustum
+// is refined per submesh. Shadow caster counts sum over all cascades.
+struct SceneRendererStats
+{
+    u32 MeshesVisible = 0;
+    u32 MeshesCulled = 0;
+    u32 MeshesOccluded = 0;   // in the frustum but hidden behind occluders
+    u32 MeshesReducedLod = 0; // visible meshes drawn at a simplified LOD
+    u32 SubmeshesVisible = 0;
+    u32 SubmeshesCulled = 0;
+    u32 ShadowCastersDrawn = 0;
+    u32 ShadowCastersCulled = 0;
+    u32 InstancedDraws = 0;  // instances drawn through instanced submits
+    u32 InstanceBatches = 0; // instanced submits (scene + shadow)
+    // Scene pass state churn: draw runs submitted, and how many of them had to
+    // switch program / material from the previous run.
+    u32 SceneSubmits = 0;
+    u32 ProgramChanges = 0;
+    u32 MaterialChanges = 0;
+    // Clustered lighting: local (point/spot) lights binned into the light grid,
+    // the (cluster, light) entries written, and those dropped over capacity.
+    u32 ClusteredLights = 0;
+    u32 LightIndexEntries = 0;
+    u32 LightIndexDropped = 0;
+    // Lights culled against the camera frustum in SubmitLight, and visible ones
+    // dropped by RankLights (over the r.lights.max budget, or directional lights
+    // past c_MaxDirectionalLights).
+    u32 LightsCulled = 0;
+    u32 LightsDropped = 0;
+    // Cached shadow cascades: static tiles re-rendered this frame, and cascades
+    // whose whole tile was kept from an earlier frame.
+    u32 ShadowStaticTiles = 0;
+    u32 ShadowCascadesReused = 0;
+    // Occlusion culling: occluders rasterised (and their triangles), and objects
+    // tested against the occlusion buffer (MeshesOccluded counts the hidden ones).
+    u32 Occluders = 0;
+    u32 OccluderTriangles = 0;
+    u32 OcclusionTested = 0;
+};
+
 class SceneRenderer: public RefCounted
 {
 public:
     SceneRenderer(Ref<Scene> scene, const SceneRendererSettings& settings);
+    ~SceneRenderer() override;
 
     void BeginScene(const SceneRendererCamera& camera);
     void EndScene();
 
     void SetScene(Ref<Scene> scene);
 
-    // Stage a light for this frame. Call between BeginScene and the first
-    // SubmitMesh (the light uniform arrays are uploaded lazily on the first mesh
-    // submit). Lights beyond c_MaxLights are dropped.
+    // Stage a light for this frame. Call after BeginScene, before
+    // RenderSunShadow (the sun is picked from these) and the scene pass (which
+    // bins them into the light grid). Point/spot lights whose range sphere (or
+    // cone bounds) misses the camera frustum are culled here; the scene pass
+    // keeps the most important survivors up to r.lights.max (see RankLights).
     void SubmitLight(const SceneRendererLight& light);
 
+    // Extraction: append the mesh (world bounds, resolved per-submesh materials,
+    // sort keys) to this frame's render list. Nothing is drawn here — the shadow
+    // cascades and the scene pass consume the list. `entity` tags the object for
+    // the editor pick pass; `occluder` rasterises it into the occlusion buffer.
     void SubmitMesh(
         const Mesh& mesh, const glm::mat4& transform = glm::mat4(1.0f),
-        const std::vector<AssetHandle>& materialOverrides = {});
+        const std::vector<AssetHandle>& materialOverrides = {}, UUID entity = 0,
+        bool occluder = false);
+
+    // Start occlusion culling the render list (r.cull.occlusion): the occluder
+    // objects are rasterised into a small CPU depth buffer and every object's
+    // bounds tested against it, on worker threads. Objects outside the camera
+    // frustum are culled first and left out of both. The scene pass waits for
+    // the result and skips the occluded objects (they still cast shadows). Call
+    // after the mesh loop; without it nothing is occlusion culled.
+    void CullOcclusion();
 
     // Render the sun's directional shadow map (depth-only, from the first
-    // DirectionalLight) and publish it for the scene pass. No-op (shadows off)
-    // if the scene has no directional light. Call before the mesh loop; the
-    // shadow view id is lower than the scene view, so bgfx orders it first.
+    // submitted directional light) and publish it for the scene pass. No-op
+    // (shadows off) if there is none. Casters come from the render list, culled
+    // per cascade against its light volume. Call after SubmitLight and the mesh
+    // loop; the shadow view id is lower than the scene view, so bgfx orders it
+    // first. With r.parallelSubmit on, each cascade is culled and recorded on a
+    // worker thread's encoder while the main thread moves on to the scene pass;
+    // EndScene waits for them. With r.shadow.cache on, static casters are drawn
+    // into persistent tiles only when a cascade's projection or the static set
+    // changes, and the far cascades may keep their whole tile for a few frames.
     void RenderSunShadow();
 
     // Draw the active scene's environment cube as the background on the current
-    // scene view. No-op unless the scene's SceneEnvironment selects a Skybox
+    // scene view (drawing the render list's scene pass first, if still pending).
+    // No-op unless the scene's SceneEnvironment selects a Skybox
     // background with a resolved EnvironmentMap. Call after the mesh loop (while
     // the scene view + its depth buffer are still bound), before EndScene.
     void DrawSkybox();
@@ -90,25 +160,149 @@ public:
     const SceneRendererSettings& GetSettings() const { return m_Settings; }
     SceneRendererSettings& GetSettings() { return m_Settings; }
 
+    // Height of the target the scene view renders into: the whole target, not
+    // its dynamic-resolution region. On GL gl_FragCoord.y counts up from the
+    // target's bottom edge, so the clustered lights need it to find a
+    // fragment's tile. Set before rendering the scene.
+    void SetTargetHeight(u32 height) { m_TargetHeight = height; }
+
+    // Counters for the frame in flight (or the last one, after EndScene).
+    const SceneRendererStats& GetStats() const { return m_Stats; }
+
+    // This frame's extracted render list (valid until the next BeginScene).
+    const RenderList& GetRenderList() const { return m_RenderList; }
+
 private:
-    // Uploads the staged lights + camera/ambient into the shared engine uniforms
-    // (created once via UniformCache). Called once per frame on the first mesh.
+    // Bins the staged lights into m_LightGrid, binds it on the Renderer, and
+    // uploads the camera/ambient/light-count engine uniforms (handles resolved
+    // once via UniformCache). Called once per frame by the scene pass.
     void UploadLightUniforms();
 
+    // Reorder m_Lights for the light grid: directional lights first, then
+    // point/spot lights by descending importance (luminance x squared angular
+    // size from the camera), truncated to the light budget. The grid fills
+    // clusters in this order, so a full cluster drops the least important.
+    void RankLights();
+
+    // The scene pass over the render list, once per frame: frustum-cull objects
+    // (then the submeshes of straddling ones), sort the surviving items by key,
+    // and submit — runs sharing mesh, submesh and resolved material go out as
+    // one instanced draw (when the material's shader has an instanced variant);
+    // the rest take the per-draw path.
+    void RenderScenePass();
+
     // Resolve the scene's EnvironmentMap and bind it on the Renderer for this
     // frame's mesh submits (image-based ambient), or clear it if unset/not ready.
     void BindEnvironment();
 
+    // Everything one shadow cascade's cull + submit reads or writes. Filled by
+    // RenderSunShadow on the main thread; RenderShadowCascade then only touches
+    // its own entry (plus the read-only render list), so cascades can run on
+    // separate worker threads.
+    struct ShadowCascadeWork
+    {
+        Frustum LightFrustum;
+        glm::vec3 Sweep{0.0f};  // light direction * depth slab, for the swept test
+        float ZNear = 0.0f;     // view-depth start of the cascade's slab
+        glm::vec3 CameraPos{0.0f};
+        glm::vec3 CameraForward{0.0f, 0.0f, -1.0f};
+        bool Active = false;
+        bool DrawStatic = false; // re-render the static tile (cached cascades)
+        bool Dropped = false;    // no encoder; nothing was recorded
+        Renderer::EncoderContext FrameContext;  // from BeginShadowCascade, per atlas
+        Renderer::EncoderContext StaticContext;
+        std::vector<const RenderObject*> Visible;
+        std::vector<glm::mat4> InstanceTransforms;
+        SceneRendererStats Stats; // shadow counters only; merged by EndScene
+    };
+    static constexpr int c_ShadowCascades = 4; // must be <= Renderer's kMaxCascades
+
+    // Test the render list objects not yet tested against the camera frustum,
+    // setting RenderObject::Visibility.
+    void CullFrustum();
+
+    // Cull m_ShadowCasters against cascade `cascade` and record the survivors
+    // into `encoder` (null: the main thread's encoder).
+    void RenderShadowCascade(int cascade, bgfx::Encoder* encoder);
+
+    // Wait for in-flight cascade jobs and fold their counters into m_Stats.
+    void FinishShadowCascades();
+
+    // Wait for an in-flight CullOcclusion, flag the occluded objects and fold its
+    // counters into m_Stats.
+    void FinishOcclusion();
+
     Ref<Scene> m_Scene;
     SceneRendererSettings m_Settings;
+    u32 m_TargetHeight = 0;
 
     struct SceneRenderData
     {
         SceneRendererCamera SceneCamera;
+        Frustum CameraFrustum; // world space, from the un-reversed projection
+        glm::vec3 CameraPosition{0.0f};
     } m_SceneRenderData {};
 
+    SceneRendererStats m_Stats;
+
     std::vector<SceneRendererLight> m_Lights;
+    std::vector<float> m_LightImportance; // parallel to m_Lights until RankLights
+    std::vector<u32> m_LightOrder;                 // scratch for RankLights
+    std::vector<SceneRendererLight> m_RankedLights; // scratch for RankLights
     bool m_LightsUploaded = false;
+
+    // Shared light uniform handles, fetched from the UniformCache on first use.
+    struct LightUniformHandles
+    {
+        bgfx::UniformHandle LightCount = BGFX_INVALID_HANDLE;
+        bgfx::UniformHandle Ambient = BGFX_INVALID_HANDLE;
+        bgfx::UniformHandle CameraPos = BGFX_INVALID_HANDLE;
+        bool Resolved = false;
+    } m_LightUniforms;
+    LightGrid m_LightGrid;
+
+    RenderList m_RenderList;
+    bool m_ScenePassDone = false;
+    size_t m_FrustumTested = 0; // leading objects CullFrustum has tested
+    // Dense per-frame ids for meshes / materials, packed into the sort keys.
+    std::unordered_map<const void*, u32> m_MeshIds;
+    std::unordered_map<const void*, u32> m_MaterialIds;
+
+    std::vector<u32> m_VisibleItems;             // scratch: scene pass item indices
+    std::vector<glm::mat4> m_InstanceTransforms; // scratch for instanced submits
+
+    // Shadow casters grouped by mesh, shared read-only by the cascade jobs.
+    std::vector<const RenderObject*> m_ShadowCasters;
+    std::array<ShadowCascadeWork, c_ShadowCascades> m_ShadowCascades;
+
+    // Cached cascades (r.shadow.cache). An entity's caster turns static once its
+    // mesh and transform have held for r.shadow.staticFrames frames.
+    struct CasterHistory
+    {
+        const Mesh* SourceMesh = nullptr;
+        glm::mat4 Transform{1.0f};
+        u32 StableFrames = 0;
+        u64 LastFrame = 0;
+    };
+    std::unordered_map<UUID, CasterHistory> m_CasterHistory;
+    // What each cascade's tiles hold: the projection both were rendered with,
+    // and the static casters inside its light volume (a hash) behind the static
+    // tile.
+    struct CachedCascade
+    {
+        bool FrameValid = false;
+        bool StaticValid = false;
+        glm::mat4 LightView{1.0f};
+        glm::mat4 LightProj{1.0f};
+        u64 StaticHash = 0;
+    };
+    std::array<CachedCascade, c_ShadowCascades> m_CachedCascades;
+    u64 m_ShadowFrame = 0;
+    // Created on first CullOcclusion (owns its own worker threads).
+    std::unique_ptr<OcclusionCuller> m_OcclusionCuller;
+    // Created on first parallel shadow pass. Declared last so it is destroyed
+    // (draining its jobs) before the state the jobs read.
+    std::unique_ptr<ThreadPool> m_SubmitPool;
 };
 
 } // namespace Seraph
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <bgfx/embedded_shader.h>
 
 #include <functional>
+#include <string_view>
 #include <unordered_map>
 
 namespace Seraph
@@ -49,6 +50,16 @@ std::unordered_map<std::string, Ref<ShaderAsset>>& EmbeddedCache()
     return s_embedded;
 }
 
+// Base shader handle -> name of its instanced variant ("" = none). Rebuilt
+// lazily; cleared whenever the cooked name mapping changes.
+std::unordered_map<u64, std::string>& InstancedVariantCache()
+{
+    static std::unordered_map<u64, std::string> s_variants;
+    return s_variants;
+}
+
+constexpr std::string_view c_InstancedSuffix = "_instanced";
+
 } // namespace
 
 AssetHandle ShaderHandleFromName(std::string_view name)
@@ -68,11 +79,13 @@ void ShaderManager::RegisterEmbedded(
 void ShaderManager::RegisterCooked(const std::string& name, AssetHandle handle)
 {
     CookedRegistry()[name] = handle;
+    InstancedVariantCache().clear();
 }
 
 void ShaderManager::UnregisterCooked(const std::string& name)
 {
     CookedRegistry().erase(name);
+    InstancedVariantCache().clear();
 }
 
 AssetHandle ShaderManager::GetHandle(const std::string& name)
@@ -146,6 +159,43 @@ bool ShaderManager::Has(const std::string& name)
     return Registry().contains(name);
 }
 
+bgfx::ProgramHandle ShaderManager::GetInstancedProgram(AssetHandle shader)
+{
+    auto& cache = InstancedVariantCache();
+    auto it = cache.find(static_cast<u64>(shader));
+    if (it == cache.end()) {
+        // Reverse-map the base handle to its name: cooked registrations by value,
+        // embedded ones by their deterministic name hash.
+        std::string baseName;
+        for (const auto& [name, handle] : CookedRegistry()) {
+            if (handle == shader) {
+                baseName = name;
+                break;
+            }
+        }
+        if (baseName.empty()) {
+            for (const auto& [name, src] : Registry()) {
+                if (ShaderHandleFromName(name) == shader) {
+                    baseName = name;
+                    break;
+                }
+            }
+        }
+
+        std::string variant;
+        if (!baseName.empty()) {
+            variant = baseName + std::string(c_InstancedSuffix);
+            if (!Has(variant) && !CookedRegistry().contains(variant))
+                variant.clear();
+        }
+        it = cache.emplace(static_cast<u64>(shader), std::move(variant)).first;
+    }
+
+    if (it->second.empty())
+        return BGFX_INVALID_HANDLE;
+    return GetProgram(it->second);
+}
+
 bool ShaderManager::ExportEmbeddedShader(const std::string& name, ShaderAsset& out)
 {
     const auto src = Registry().find(name);
@@ -204,6 +254,7 @@ void ShaderManager::Shutdown()
     EmbeddedCache().clear();
     Registry().clear();
     CookedRegistry().clear();
+    InstancedVariantCache().clear();
 }
 
 } // namespace Seraph
@@ -71,6 +71,12 @@ public:
 
     [[nodiscard]] static bool Has(const std::string& name);
 
+    // Resolve the instanced variant of a shader, by the base shader's handle: the
+    // program registered as "<name>_instanced", which reads its model matrix
+    // from the per-instance stream (i_data0..3) instead of u_model. Returns
+    // BGFX_INVALID_HANDLE if the shader has no instanced variant.
+    [[nodiscard]] static bgfx::ProgramHandle GetInstancedProgram(AssetHandle shader);
+
     // Stage a registered embedded shader's compiled blobs for EVERY renderer
     // profile it was built with into `out` (via ShaderAsset::StageVariant), so
     // it can be cooked to a portable .sshader / pack. Returns false if the name
@@ -115,16 +115,24 @@ bool Texture2D::Upload()
     bimg::ImageContainer* imageContainer = m_ImageContainer;
     const u64 flags = m_CreateFlags;
 
+    const auto format =
+        static_cast<bgfx::TextureFormat::Enum>(imageContainer->m_format);
+
+    // Reject before makeRef: a reference bgfx never consumes is never released,
+    // which would leak the image.
+    const bool is2D = !imageContainer->m_cubeMap && imageContainer->m_depth <= 1;
+    if (is2D && !bgfx::isTextureValid(0, false, imageContainer->m_numLayers, format, flags))
+        return false;
+
     // Hand the CPU image to bgfx; the release callback frees it once bgfx is
-    // done, so clear our pointer to avoid a double free in the destructor.
+    // done, so clear our pointer to avoid a double free in the destructor. With
+    // a render thread the callback runs on that thread, up to two frames later;
+    // it only frees through the image's own (thread-safe) allocator.
     const bgfx::Memory* mem = bgfx::makeRef(
         imageContainer->m_data, imageContainer->m_size, ImageReleaseCb,
         imageContainer);
     m_ImageContainer = nullptr;
 
-    const auto format =
-        static_cast<bgfx::TextureFormat::Enum>(imageContainer->m_format);
-
     bgfx::TextureHandle handle = BGFX_INVALID_HANDLE;
     if (imageContainer->m_cubeMap) {
         handle = bgfx::createTextureCube(
@@ -137,8 +145,7 @@ bool Texture2D::Upload()
             static_cast<uint16_t>(imageContainer->m_height),
             static_cast<uint16_t>(imageContainer->m_depth),
             1 < imageContainer->m_numMips, format, flags, mem);
-    } else if (bgfx::isTextureValid(
-                   0, false, imageContainer->m_numLayers, format, flags)) {
+    } else {
         handle = bgfx::createTexture2D(
             static_cast<uint16_t>(imageContainer->m_width),
             static_cast<uint16_t>(imageContainer->m_height),
@@ -1,7 +1,7 @@
 //
 // Canonical bgfx view ids for the engine's passes. bgfx submits views in
 // ascending id order, so a pass that samples another pass's output must have a
-// higher id. Centralized here so the editor, runtime, picker, and ImGui layers
+// higher id. Centralized here so the editor, runtime, and ImGui layers
 // agree on one numbering instead of each defining its own constants.
 //
 
@@ -15,16 +15,19 @@ namespace Seraph::ViewId
 constexpr u16 Backbuffer = 0;   // backbuffer clear only; no scene geometry
 
 // Shadow depth passes render BEFORE the scene samples them, so their ids are
-// lower than Scene. Reserve a contiguous range for directional cascades (Render
-// 21) so adding CSM needs no renumber.
-constexpr u16 Shadow            = 1;   // directional shadow map (cascade 0)
+// lower than the graph's. Reserve a contiguous range for directional cascades (Render
+// 21) so adding CSM needs no renumber. The cached cascades' static tiles come
+// first: each frame cascade composites its static tile before its own casters.
+constexpr u16 ShadowStatic      = 1;   // static-caster shadow tiles (ShadowStatic .. +3)
+constexpr u16 Shadow            = 5;   // directional shadow map (cascade 0)
 constexpr u16 ShadowCascadeMax  = 4;   // cascades occupy Shadow .. Shadow+3
 
-constexpr u16 Scene      = 5;   // scene geometry (the HDR target in the HDR pipeline)
-constexpr u16 Pick       = 6;   // editor entity color-id render (EntityPicker)
-constexpr u16 PickBlit   = 7;   // editor entity color-id readback blit
-constexpr u16 Tonemap    = 8;   // fullscreen HDR -> LDR resolve
-constexpr u16 EnvBake    = 9;   // one-time environment/IBL bakes (BRDF LUT, ...)
+// The frame's passes (scene, tonemap, post-processing) are declared on a
+// RenderGraph, which hands out this range in execution order each frame.
+constexpr u16 GraphFirst = 9;
+constexpr u16 GraphLast  = 253;
+
+constexpr u16 EnvBake    = 254; // one-time environment/IBL bakes (BRDF LUT, ...)
 constexpr u16 ImGui      = 255; // Dear ImGui overlay
 
 } // namespace Seraph::ViewId
@@ -0,0 +1,86 @@
+//
+// Created by ruben on 2026/10/17.
+//
+
+#include "Bounds.h"
+
+namespace Seraph
+{
+
+AABB AABB::Transformed(const glm::mat4& transform) const
+{
+    if (!IsValid())
+        return {};
+
+    const glm::vec3 center = glm::vec3(transform * glm::vec4(Center(), 1.0f));
+    const glm::vec3 extents = Extents();
+
+    // |M| * extents, column-major: world extent on axis r is the sum over local
+    // axes c of |M[c][r]| * extents[c].
+    glm::vec3 worldExtents(0.0f);
+    for (int c = 0; c < 3; ++c)
+        worldExtents += glm::abs(glm::vec3(transform[c])) * extents[c];
+
+    return {center - worldExtents, center + worldExtents};
+}
+
+Frustum Frustum::FromMatrix(const glm::mat4& m)
+{
+    // Rows of the (column-major) matrix.
+    const glm::vec4 r0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    const glm::vec4 r1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    const glm::vec4 r2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    const glm::vec4 r3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    Frustum f;
+    f.Planes[Left]   = r3 + r0;
+    f.Planes[Right]  = r3 - r0;
+    f.Planes[Bottom] = r3 + r1;
+    f.Planes[Top]    = r3 - r1;
+    f.Planes[Near]   = r2;      // [0,1] clip depth: z >= 0
+    f.Planes[Far]    = r3 - r2; // z <= w
+
+    for (glm::vec4& p : f.Planes) {
+        const float len = glm::length(glm::vec3(p));
+        if (len > 0.0f)
+            p /= len;
+    }
+    return f;
+}
+
+FrustumTest Frustum::Test(const BoundingSphere& sphere) const
+{
+    FrustumTest result = FrustumTest::Inside;
+    for (const glm::vec4& p : Planes) {
+        const float d = glm::dot(glm::vec3(p), sphere.Center) + p.w;
+        if (d < -sphere.Radius)
+            return FrustumTest::Outside;
+        if (d < sphere.Radius)
+            result = FrustumTest::Intersects;
+    }
+    return result;
+}
+
+FrustumTest Frustum::Test(const AABB& box) const
+{
+    if (!box.IsValid())
+        return FrustumTest::Outside;
+
+    const glm::vec3 center = box.Center();
+    const glm::vec3 extents = box.Extents();
+
+    FrustumTest result = FrustumTest::Inside;
+    for (const glm::vec4& p : Planes) {
+        const glm::vec3 n(p);
+        // Projected radius of the box onto the plane normal.
+        const float r = glm::dot(extents, glm::abs(n));
+        const float d = glm::dot(n, center) + p.w;
+        if (d < -r)
+            return FrustumTest::Outside;
+        if (d < r)
+            result = FrustumTest::Intersects;
+    }
+    return result;
+}
+
+} // namespace Seraph
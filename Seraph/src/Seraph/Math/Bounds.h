@@ -0,0 +1,94 @@
+//
+// Bounding volumes + view-frustum tests used for visibility culling. AABB is the
+// stored form (mesh / submesh bounds in object space, serialized in .smesh v3);
+// a BoundingSphere is derived from it for the cheap first-pass reject. Frustum
+// planes are extracted from a view-projection matrix (Gribb/Hartmann) and point
+// inward, so a point p is inside a plane when dot(n, p) + d >= 0.
+//
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <limits>
+
+namespace Seraph
+{
+
+struct AABB
+{
+    // Default is the empty box (Min > Max), so Expand() from it yields exactly
+    // the expanded points.
+    glm::vec3 Min{std::numeric_limits<float>::max()};
+    glm::vec3 Max{std::numeric_limits<float>::lowest()};
+
+    AABB() = default;
+    AABB(const glm::vec3& min, const glm::vec3& max) : Min(min), Max(max) {}
+
+    [[nodiscard]] bool IsValid() const
+    {
+        return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z;
+    }
+
+    [[nodiscard]] glm::vec3 Center() const { return (Min + Max) * 0.5f; }
+    [[nodiscard]] glm::vec3 Extents() const { return (Max - Min) * 0.5f; }
+
+    void Expand(const glm::vec3& p)
+    {
+        Min = glm::min(Min, p);
+        Max = glm::max(Max, p);
+    }
+
+    void Expand(const AABB& other)
+    {
+        if (!other.IsValid())
+            return;
+        Min = glm::min(Min, other.Min);
+        Max = glm::max(Max, other.Max);
+    }
+
+    // Tight world box of this box under an affine transform (Arvo: project the
+    // extents onto each world axis via |M|). Invalid boxes stay invalid.
+    [[nodiscard]] AABB Transformed(const glm::mat4& transform) const;
+};
+
+struct BoundingSphere
+{
+    glm::vec3 Center{0.0f};
+    float Radius = 0.0f;
+
+    // Sphere enclosing the box (centre + half-diagonal).
+    [[nodiscard]] static BoundingSphere FromAABB(const AABB& box)
+    {
+        return {box.Center(), glm::length(box.Extents())};
+    }
+};
+
+enum class FrustumTest
+{
+    Outside,
+    Intersects,
+    Inside,
+};
+
+struct Frustum
+{
+    enum Plane { Left = 0, Right, Bottom, Top, Near, Far, Count };
+
+    glm::vec4 Planes[Count]{}; // xyz = inward normal (normalized), w = distance
+
+    // Extract the six planes from `viewProj` (clip = viewProj * world). Expects
+    // an UN-reversed projection with [0,1] clip depth (GLM_FORCE_DEPTH_ZERO_TO_ONE),
+    // i.e. Camera::GetUnReversedProjectionMatrix().
+    [[nodiscard]] static Frustum FromMatrix(const glm::mat4& viewProj);
+
+    [[nodiscard]] FrustumTest Test(const BoundingSphere& sphere) const;
+    [[nodiscard]] FrustumTest Test(const AABB& box) const;
+
+    [[nodiscard]] bool Intersects(const AABB& box) const
+    {
+        return Test(box) != FrustumTest::Outside;
+    }
+};
+
+} // namespace Seraph
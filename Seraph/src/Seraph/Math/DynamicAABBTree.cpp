@@ -0,0 +1,335 @@
+//
+// Created by ruben on 2026/10/17.
+//
+
+#include "DynamicAABBTree.h"
+
+#include "Seraph/Core/Assert.h"
+
+#include <queue>
+
+namespace Seraph
+{
+
+namespace
+{
+// Fat box margin: a fraction of the box's half extents, with an absolute floor
+// so thin or point-like boxes still get room to move.
+constexpr float c_FatMarginScale = 0.1f;
+constexpr float c_FatMarginMin = 0.05f;
+
+AABB Union(const AABB& a, const AABB& b)
+{
+    return {glm::min(a.Min, b.Min), glm::max(a.Max, b.Max)};
+}
+
+float SurfaceArea(const AABB& box)
+{
+    const glm::vec3 d = box.Max - box.Min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+bool Contains(const AABB& outer, const AABB& inner)
+{
+    return glm::all(glm::lessThanEqual(outer.Min, inner.Min)) &&
+           glm::all(glm::greaterThanEqual(outer.Max, inner.Max));
+}
+} // namespace
+
+AABB DynamicAABBTree::Fatten(const AABB& box)
+{
+    const glm::vec3 margin =
+        glm::max(box.Extents() * c_FatMarginScale, glm::vec3(c_FatMarginMin));
+    return {box.Min - margin, box.Max + margin};
+}
+
+s32 DynamicAABBTree::AllocateNode()
+{
+    if (m_FreeList == c_NullNode) {
+        m_Nodes.emplace_back();
+        return static_cast<s32>(m_Nodes.size() - 1);
+    }
+    const s32 node = m_FreeList;
+    m_FreeList = m_Nodes[node].Parent;
+    m_Nodes[node] = Node{};
+    return node;
+}
+
+void DynamicAABBTree::FreeNode(s32 node)
+{
+    m_Nodes[node].Parent = m_FreeList;
+    m_Nodes[node].Height = -1;
+    m_FreeList = node;
+}
+
+s32 DynamicAABBTree::CreateProxy(const AABB& box, u64 userData)
+{
+    SP_CORE_ASSERT(box.IsValid(), "DynamicAABBTree proxy needs a valid box");
+    const s32 proxy = AllocateNode();
+    Node& node = m_Nodes[proxy];
+    node.Tight = box;
+    node.Box = Fatten(box);
+    node.UserData = userData;
+    node.Height = 0;
+    InsertLeaf(proxy);
+    ++m_ProxyCount;
+    return proxy;
+}
+
+void DynamicAABBTree::DestroyProxy(s32 proxy)
+{
+    SP_CORE_ASSERT(m_Nodes[proxy].IsLeaf() && m_Nodes[proxy].Height == 0,
+                   "DynamicAABBTree: not a proxy");
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    --m_ProxyCount;
+}
+
+bool DynamicAABBTree::MoveProxy(s32 proxy, const AABB& box)
+{
+    Node& node = m_Nodes[proxy];
+    node.Tight = box;
+    // Keep the node while the box fits, unless it shrank enough that the fat
+    // box would make it a false positive for most queries.
+    const AABB fat = Fatten(box);
+    if (Contains(node.Box, box) &&
+        glm::all(glm::lessThanEqual(node.Box.Max - node.Box.Min, (fat.Max - fat.Min) * 2.0f)))
+        return false;
+    RemoveLeaf(proxy);
+    m_Nodes[proxy].Box = fat;
+    InsertLeaf(proxy);
+    return true;
+}
+
+void DynamicAABBTree::Clear()
+{
+    m_Nodes.clear();
+    m_Root = c_NullNode;
+    m_FreeList = c_NullNode;
+    m_ProxyCount = 0;
+}
+
+void DynamicAABBTree::InsertLeaf(s32 leaf)
+{
+    if (m_Root == c_NullNode) {
+        m_Root = leaf;
+        m_Nodes[leaf].Parent = c_NullNode;
+        return;
+    }
+
+    // Descend to the sibling that minimises the added surface area: pairing at
+    // a node costs the new parent's area plus the growth of every ancestor.
+    const AABB leafBox = m_Nodes[leaf].Box;
+    s32 index = m_Root;
+    while (!m_Nodes[index].IsLeaf()) {
+        const Node& node = m_Nodes[index];
+        const float area = SurfaceArea(node.Box);
+        const float combinedArea = SurfaceArea(Union(node.Box, leafBox));
+        const float cost = 2.0f * combinedArea;
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        const auto descendCost = [&](s32 child) {
+            const Node& c = m_Nodes[child];
+            const float unionArea = SurfaceArea(Union(leafBox, c.Box));
+            return (c.IsLeaf() ? unionArea : unionArea - SurfaceArea(c.Box)) + inheritanceCost;
+        };
+        const float cost1 = descendCost(node.Child1);
+        const float cost2 = descendCost(node.Child2);
+        if (cost < cost1 && cost < cost2)
+            break;
+        index = cost1 < cost2 ? node.Child1 : node.Child2;
+    }
+
+    const s32 sibling = index;
+    const s32 oldParent = m_Nodes[sibling].Parent;
+    const s32 newParent = AllocateNode();
+    m_Nodes[newParent].Parent = oldParent;
+    m_Nodes[newParent].Box = Union(leafBox, m_Nodes[sibling].Box);
+    m_Nodes[newParent].Height = m_Nodes[sibling].Height + 1;
+    m_Nodes[newParent].Child1 = sibling;
+    m_Nodes[newParent].Child2 = leaf;
+    m_Nodes[sibling].Parent = newParent;
+    m_Nodes[leaf].Parent = newParent;
+    if (oldParent == c_NullNode) {
+        m_Root = newParent;
+    } else if (m_Nodes[oldParent].Child1 == sibling) {
+        m_Nodes[oldParent].Child1 = newParent;
+    } else {
+        m_Nodes[oldParent].Child2 = newParent;
+    }
+
+    // Refit and rebalance up to the root.
+    index = m_Nodes[leaf].Parent;
+    while (index != c_NullNode) {
+        index = Balance(index);
+        Node& node = m_Nodes[index];
+        node.Height = 1 + std::max(m_Nodes[node.Child1].Height, m_Nodes[node.Child2].Height);
+        node.Box = Union(m_Nodes[node.Child1].Box, m_Nodes[node.Child2].Box);
+        index = node.Parent;
+    }
+}
+
+void DynamicAABBTree::RemoveLeaf(s32 leaf)
+{
+    if (leaf == m_Root) {
+        m_Root = c_NullNode;
+        return;
+    }
+
+    const s32 parent = m_Nodes[leaf].Parent;
+    const s32 grandParent = m_Nodes[parent].Parent;
+    const s32 sibling =
+        m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+    if (grandParent == c_NullNode) {
+        m_Root = sibling;
+        m_Nodes[sibling].Parent = c_NullNode;
+        FreeNode(parent);
+        return;
+    }
+
+    // The sibling takes the parent's place.
+    if (m_Nodes[grandParent].Child1 == parent)
+        m_Nodes[grandParent].Child1 = sibling;
+    else
+        m_Nodes[grandParent].Child2 = sibling;
+    m_Nodes[sibling].Parent = grandParent;
+    FreeNode(parent);
+
+    s32 index = grandParent;
+    while (index != c_NullNode) {
+        index = Balance(index);
+        Node& node = m_Nodes[index];
+        node.Box = Union(m_Nodes[node.Child1].Box, m_Nodes[node.Child2].Box);
+        node.Height = 1 + std::max(m_Nodes[node.Child1].Height, m_Nodes[node.Child2].Height);
+        index = node.Parent;
+    }
+}
+
+// Rotate the taller child of `iA` up when the children's heights differ by
+// more than one. Returns the subtree's new root.
+s32 DynamicAABBTree::Balance(s32 iA)
+{
+    Node& a = m_Nodes[iA];
+    if (a.IsLeaf() || a.Height < 2)
+        return iA;
+
+    const s32 iB = a.Child1;
+    const s32 iC = a.Child2;
+    Node& b = m_Nodes[iB];
+    Node& c = m_Nodes[iC];
+    const s32 balance = c.Height - b.Height;
+
+    // Rotate `up` (a child of A) into A's place; A keeps `keep` and takes the
+    // shorter of up's children, up keeps the taller one.
+    const auto rotate = [&](s32 iUp, Node& up, Node& keep, bool upIsChild2) {
+        const s32 iF = up.Child1;
+        const s32 iG = up.Child2;
+        Node& f = m_Nodes[iF];
+        Node& g = m_Nodes[iG];
+
+        up.Child1 = iA;
+        up.Parent = a.Parent;
+        a.Parent = iUp;
+        if (up.Parent == c_NullNode)
+            m_Root = iUp;
+        else if (m_Nodes[up.Parent].Child1 == iA)
+            m_Nodes[up.Parent].Child1 = iUp;
+        else
+            m_Nodes[up.Parent].Child2 = iUp;
+
+        const bool keepF = f.Height > g.Height;
+        const s32 iTall = keepF ? iF : iG;
+        const s32 iShort = keepF ? iG : iF;
+        Node& tall = m_Nodes[iTall];
+        Node& shortNode = m_Nodes[iShort];
+        up.Child2 = iTall;
+        if (upIsChild2)
+            a.Child2 = iShort;
+        else
+            a.Child1 = iShort;
+        shortNode.Parent = iA;
+        a.Box = Union(keep.Box, shortNode.Box);
+        up.Box = Union(a.Box, tall.Box);
+        a.Height = 1 + std::max(keep.Height, shortNode.Height);
+        up.Height = 1 + std::max(a.Height, tall.Height);
+        return iUp;
+    };
+
+    if (balance > 1)
+        return rotate(iC, c, b, true);
+    if (balance < -1)
+        return rotate(iB, b, c, false);
+    return iA;
+}
+
+float DynamicAABBTree::RayBoxEntry(const glm::vec3& origin, const glm::vec3& invDirection,
+                                   const AABB& box, float maxT)
+{
+    const glm::vec3 t0 = (box.Min - origin) * invDirection;
+    const glm::vec3 t1 = (box.Max - origin) * invDirection;
+    const glm::vec3 tLow = glm::min(t0, t1);
+    const glm::vec3 tHigh = glm::max(t0, t1);
+    // NaN (0 * inf, an axis-parallel ray on a slab face) fails both compares
+    // below and so counts as a hit on that axis.
+    float entry = 0.0f;
+    float exit = maxT;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (tLow[axis] > entry)
+            entry = tLow[axis];
+        if (tHigh[axis] < exit)
+            exit = tHigh[axis];
+    }
+    return entry <= exit ? entry : -1.0f;
+}
+
+void DynamicAABBTree::FindNearest(const glm::vec3& point, u32 count, float maxDistance,
+                                  std::vector<std::pair<s32, float>>& out) const
+{
+    if (m_Root == c_NullNode || count == 0)
+        return;
+
+    // Best-first: nodes by distance to their box (min-heap), results so far by
+    // distance (max-heap, at most `count`). Once the nearest pending node is
+    // farther than the worst kept result, nothing closer remains.
+    using Entry = std::pair<float, s32>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> pending;
+    std::priority_queue<Entry> best;
+    float limit = maxDistance < std::numeric_limits<float>::max()
+                      ? maxDistance * maxDistance
+                      : std::numeric_limits<float>::max();
+
+    pending.emplace(DistanceSquared(point, m_Nodes[m_Root].Box), m_Root);
+    while (!pending.empty()) {
+        const auto [distance, index] = pending.top();
+        pending.pop();
+        if (distance > limit)
+            break;
+        const Node& node = m_Nodes[index];
+        if (node.IsLeaf()) {
+            const float tight = DistanceSquared(point, node.Tight);
+            if (tight > limit)
+                continue;
+            best.emplace(tight, index);
+            if (best.size() > count)
+                best.pop();
+            if (best.size() == count)
+                limit = std::min(limit, best.top().first);
+            continue;
+        }
+        for (const s32 child : {node.Child1, node.Child2}) {
+            const float d = DistanceSquared(point, m_Nodes[child].Box);
+            if (d <= limit)
+                pending.emplace(d, child);
+        }
+    }
+
+    const size_t first = out.size();
+    while (!best.empty()) {
+        out.emplace_back(best.top().second, best.top().first);
+        best.pop();
+    }
+    std::reverse(out.begin() + static_cast<std::ptrdiff_t>(first), out.end());
+}
+
+} // namespace Seraph
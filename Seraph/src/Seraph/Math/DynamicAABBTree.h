@@ -0,0 +1,280 @@
+//
+// Dynamic AABB tree (incremental bounding volume hierarchy). Leaves are proxies
+// holding a user value, their tight box, and a fattened box that the tree is
+// built from: a proxy whose new tight box still fits its fat box moves without
+// touching the tree. Otherwise it is removed and reinserted: the sibling is
+// picked by the surface-area cost (branch-and-bound descent), and the path back
+// to the root is rebalanced with AVL-style rotations. Insert, move and remove
+// are O(log n). Node indices are stable for a proxy's lifetime; freed nodes are
+// recycled through a free list.
+//
+// Queries walk the fat boxes and test the tight box at the leaves, so results
+// are exact for the stored boxes. Callbacks receive (proxy, userData); the
+// overlap / frustum callbacks return false to stop the query early.
+//
+
+#pragma once
+
+#include "Bounds.h"
+#include "Seraph/Core/Base.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+namespace Seraph
+{
+
+class DynamicAABBTree
+{
+public:
+    static constexpr s32 c_NullNode = -1;
+
+    // Create a proxy for `box` (must be valid); returns its id.
+    s32 CreateProxy(const AABB& box, u64 userData);
+    void DestroyProxy(s32 proxy);
+    // Update a proxy's tight box. Returns true when it left its fat box (or the
+    // fat box became far too loose) and the proxy was reinserted.
+    bool MoveProxy(s32 proxy, const AABB& box);
+    void Clear();
+
+    [[nodiscard]] u64 GetUserData(s32 proxy) const { return m_Nodes[proxy].UserData; }
+    [[nodiscard]] const AABB& GetBounds(s32 proxy) const { return m_Nodes[proxy].Tight; }
+    [[nodiscard]] const AABB& GetFatBounds(s32 proxy) const { return m_Nodes[proxy].Box; }
+    [[nodiscard]] u32 GetProxyCount() const { return m_ProxyCount; }
+    // Root height (0 for a single leaf, -1 when empty).
+    [[nodiscard]] s32 GetHeight() const
+    {
+        return m_Root == c_NullNode ? -1 : m_Nodes[m_Root].Height;
+    }
+
+    // Proxies whose box overlaps `box`. fn(proxy, userData) -> bool (continue).
+    template<typename Fn>
+    void QueryBox(const AABB& box, Fn&& fn) const;
+
+    // Proxies whose box overlaps the sphere. fn(proxy, userData) -> bool.
+    template<typename Fn>
+    void QuerySphere(const glm::vec3& center, float radius, Fn&& fn) const;
+
+    // Proxies whose box is not outside `frustum`. Subtrees entirely inside are
+    // reported without further plane tests. fn(proxy, userData) -> bool.
+    template<typename Fn>
+    void QueryFrustum(const Frustum& frustum, Fn&& fn) const;
+
+    // Boxes hit by the ray origin + t * direction, t in [0, maxT], in no
+    // particular order. fn(proxy, userData, t) returns the new maxT: t to keep
+    // only closer hits (closest hit), maxT to collect all, 0 to stop.
+    // `direction` need not be normalised; t is in its units.
+    template<typename Fn>
+    void RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxT, Fn&& fn) const;
+
+    // The (up to) `count` proxies whose boxes are nearest `point`, nearest
+    // first, appended to `out` with their squared distances (0 inside a box).
+    // Only boxes within `maxDistance` are considered.
+    void FindNearest(const glm::vec3& point, u32 count, float maxDistance,
+                     std::vector<std::pair<s32, float>>& out) const;
+
+    // Entry distance of a ray into `box` (0 when the origin is inside), or a
+    // negative value on a miss. `invDirection` is 1 / direction per axis.
+    [[nodiscard]] static float RayBoxEntry(const glm::vec3& origin,
+                                           const glm::vec3& invDirection,
+                                           const AABB& box, float maxT);
+
+    [[nodiscard]] static float DistanceSquared(const glm::vec3& point, const AABB& box)
+    {
+        const glm::vec3 d = glm::max(glm::max(box.Min - point, point - box.Max), glm::vec3(0.0f));
+        return glm::dot(d, d);
+    }
+
+private:
+    struct Node
+    {
+        AABB Box;   // fat box for leaves, union of the children otherwise
+        AABB Tight; // leaves only
+        u64 UserData = 0;
+        s32 Parent = c_NullNode; // next free node while on the free list
+        s32 Child1 = c_NullNode;
+        s32 Child2 = c_NullNode;
+        s32 Height = -1; // 0 for leaves, -1 while free
+
+        [[nodiscard]] bool IsLeaf() const { return Child1 == c_NullNode; }
+    };
+
+    // Traversal stack: inline for any balanced tree, spilling to the heap past
+    // that.
+    class Stack
+    {
+    public:
+        void Push(s32 node)
+        {
+            if (m_Size < m_Inline.size())
+                m_Inline[m_Size] = node;
+            else
+                m_Spill.push_back(node);
+            ++m_Size;
+        }
+        s32 Pop()
+        {
+            --m_Size;
+            if (m_Size < m_Inline.size())
+                return m_Inline[m_Size];
+            const s32 node = m_Spill.back();
+            m_Spill.pop_back();
+            return node;
+        }
+        [[nodiscard]] bool Empty() const { return m_Size == 0; }
+
+    private:
+        std::array<s32, 64> m_Inline{};
+        std::vector<s32> m_Spill;
+        size_t m_Size = 0;
+    };
+
+    s32 AllocateNode();
+    void FreeNode(s32 node);
+    void InsertLeaf(s32 leaf);
+    void RemoveLeaf(s32 leaf);
+    s32 Balance(s32 node);
+    static AABB Fatten(const AABB& box);
+
+    template<typename Visit, typename Fn>
+    void Traverse(Visit&& visit, Fn&& fn) const;
+
+    std::vector<Node> m_Nodes;
+    s32 m_Root = c_NullNode;
+    s32 m_FreeList = c_NullNode;
+    u32 m_ProxyCount = 0;
+};
+
+namespace Detail
+{
+inline bool BoxesOverlap(const AABB& a, const AABB& b)
+{
+    return a.Min.x <= b.Max.x && a.Max.x >= b.Min.x && a.Min.y <= b.Max.y &&
+           a.Max.y >= b.Min.y && a.Min.z <= b.Max.z && a.Max.z >= b.Min.z;
+}
+} // namespace Detail
+
+// Depth-first walk. visit(box) -> FrustumTest: Outside prunes, Inside reports
+// the whole subtree's leaves without visiting them again, Intersects descends
+// (and at a leaf re-tests the tight box).
+template<typename Visit, typename Fn>
+void DynamicAABBTree::Traverse(Visit&& visit, Fn&& fn) const
+{
+    if (m_Root == c_NullNode)
+        return;
+    Stack stack;
+    stack.Push(m_Root);
+    // A subtree known inside is walked without tests; this marker, pushed
+    // below its children, ends it.
+    constexpr s32 c_InsideEnd = -2;
+    bool inside = false;
+    while (!stack.Empty()) {
+        const s32 index = stack.Pop();
+        if (index == c_InsideEnd) {
+            inside = false;
+            continue;
+        }
+        const Node& node = m_Nodes[index];
+        if (!inside) {
+            const FrustumTest test = visit(node.Box);
+            if (test == FrustumTest::Outside)
+                continue;
+            if (node.IsLeaf()) {
+                if (visit(node.Tight) != FrustumTest::Outside && !fn(index, node.UserData))
+                    return;
+                continue;
+            }
+            if (test == FrustumTest::Inside) {
+                inside = true;
+                stack.Push(c_InsideEnd);
+            }
+        } else if (node.IsLeaf()) {
+            if (!fn(index, node.UserData))
+                return;
+            continue;
+        }
+        stack.Push(node.Child2);
+        stack.Push(node.Child1);
+    }
+}
+
+template<typename Fn>
+void DynamicAABBTree::QueryBox(const AABB& box, Fn&& fn) const
+{
+    Traverse(
+        [&](const AABB& bounds) {
+            if (!Detail::BoxesOverlap(bounds, box))
+                return FrustumTest::Outside;
+            const bool contained = glm::all(glm::greaterThanEqual(bounds.Min, box.Min)) &&
+                                   glm::all(glm::lessThanEqual(bounds.Max, box.Max));
+            return contained ? FrustumTest::Inside : FrustumTest::Intersects;
+        },
+        fn);
+}
+
+template<typename Fn>
+void DynamicAABBTree::QuerySphere(const glm::vec3& center, float radius, Fn&& fn) const
+{
+    const float radiusSq = radius * radius;
+    Traverse(
+        [&](const AABB& bounds) {
+            if (DistanceSquared(center, bounds) > radiusSq)
+                return FrustumTest::Outside;
+            // Inside when the farthest corner is within the sphere.
+            const glm::vec3 corner = glm::max(glm::abs(bounds.Min - center),
+                                              glm::abs(bounds.Max - center));
+            return glm::dot(corner, corner) <= radiusSq ? FrustumTest::Inside
+                                                  : FrustumTest::Intersects;
+        },
+        fn);
+}
+
+template<typename Fn>
+void DynamicAABBTree::QueryFrustum(const Frustum& frustum, Fn&& fn) const
+{
+    Traverse([&](const AABB& bounds) { return frustum.Test(bounds); }, fn);
+}
+
+template<typename Fn>
+void DynamicAABBTree::RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxT,
+                              Fn&& fn) const
+{
+    if (m_Root == c_NullNode)
+        return;
+    // Division by a zero component gives +-inf, which the slab test handles.
+    const glm::vec3 invDirection = 1.0f / direction;
+    Stack stack;
+    stack.Push(m_Root);
+    while (!stack.Empty()) {
+        const Node& node = m_Nodes[stack.Pop()];
+        if (RayBoxEntry(origin, invDirection, node.Box, maxT) < 0.0f)
+            continue;
+        if (node.IsLeaf()) {
+            const float t = RayBoxEntry(origin, invDirection, node.Tight, maxT);
+            if (t < 0.0f)
+                continue;
+            const s32 proxy = static_cast<s32>(&node - m_Nodes.data());
+            maxT = fn(proxy, node.UserData, t);
+            if (maxT <= 0.0f)
+                return;
+            continue;
+        }
+        // Nearer child on top, so closest-hit casts shrink maxT sooner.
+        const float t1 = RayBoxEntry(origin, invDirection, m_Nodes[node.Child1].Box, maxT);
+        const float t2 = RayBoxEntry(origin, invDirection, m_Nodes[node.Child2].Box, maxT);
+        if (t1 >= 0.0f && t2 >= 0.0f) {
+            stack.Push(t1 <= t2 ? node.Child2 : node.Child1);
+            stack.Push(t1 <= t2 ? node.Child1 : node.Child2);
+        } else if (t1 >= 0.0f) {
+            stack.Push(node.Child1);
+        } else if (t2 >= 0.0f) {
+            stack.Push(node.Child2);
+        }
+    }
+}
+
+} // namespace Seraph
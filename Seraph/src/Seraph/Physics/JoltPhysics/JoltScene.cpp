@@ -315,8 +315,10 @@ void JoltScene::SyncKinematicTransforms(f32 simTime)
         // pose (resolves parenting) and set the velocity that lands the body there
         // after this frame's substeps. Unlike a teleport this sweeps the collider,
         // so it carries and pushes the dynamic bodies it meets. MoveKinematic wakes
-        // the body if the resulting velocity is non-zero.
-        const TransformComponent world = m_EntityScene->GetWorldSpaceTransform(entity);
+        // the body if the resulting velocity is non-zero. The cached world matrix
+        // is current: Scene refreshes it between scripts and the step.
+        TransformComponent world;
+        world.SetTransform(m_EntityScene->GetWorldTransform(entity));
         bi.MoveKinematic(
             joltBody->GetBodyID(), JoltUtils::ToJoltRVec3(world.Translation),
             JoltUtils::ToJoltQuat(world.GetRotation()), simTime);
@@ -325,17 +327,26 @@ void JoltScene::SyncKinematicTransforms(f32 simTime)
 
 void JoltScene::WriteBackTransforms(f32 alpha)
 {
+    // Fold a world matrix into the entity's local transform. The parent's world
+    // comes from the scene's cache (refreshed just before the step) instead of
+    // re-walking its chain per body.
+    const auto setWorld = [this](Entity entity, Entity parent, const glm::mat4& worldMatrix)
+    {
+        entity.GetComponent<TransformComponent>().SetTransform(
+            glm::inverse(m_EntityScene->GetWorldTransform(parent)) * worldMatrix);
+    };
+
     // Write a world-space pose onto an entity, folding into local space when the
     // entity is parented. Scale is preserved (physics has none).
-    const auto writePose = [this](Entity entity, const glm::vec3& worldPos, const glm::quat& worldRot)
+    const auto writePose = [&setWorld](Entity entity, const glm::vec3& worldPos, const glm::quat& worldRot)
     {
         auto& tc = entity.GetComponent<TransformComponent>();
         const glm::vec3 keepScale = tc.Scale;
-        if (entity.GetParent())
+        if (Entity parent = entity.GetParent())
         {
             const glm::mat4 worldMatrix = glm::translate(glm::mat4(1.0f), worldPos) *
                 glm::toMat4(worldRot) * glm::scale(glm::mat4(1.0f), keepScale);
-            m_EntityScene->SetWorldSpaceTransformMatrix(entity, worldMatrix);
+            setWorld(entity, parent, worldMatrix);
         }
         else
         {
@@ -388,11 +399,11 @@ void JoltScene::WriteBackTransforms(f32 alpha)
             worldPos = glm::mix(prev->second.Translation, worldPos, alpha);
 
         auto& tc = entity.GetComponent<TransformComponent>();
-        if (entity.GetParent())
+        if (Entity parent = entity.GetParent())
         {
             const glm::mat4 worldMatrix = glm::translate(glm::mat4(1.0f), worldPos) *
                 glm::toMat4(tc.GetRotation()) * glm::scale(glm::mat4(1.0f), tc.Scale);
-            m_EntityScene->SetWorldSpaceTransformMatrix(entity, worldMatrix);
+            setWorld(entity, parent, worldMatrix);
         }
         else
         {
@@ -7,10 +7,7 @@
 #include "Seraph/Core/KeyCodes.h"
 #include "Seraph/Core/Log.h"
 #include "Seraph/Events/KeyEvent.h"
-#include "Seraph/Graphics/RenderPass.h"
 #include "Seraph/Graphics/RenderSystem.h"
-#include "Seraph/Graphics/Renderer.h"
-#include "Seraph/Graphics/ViewId.h"
 #include "Seraph/Scene/Components/CameraComponent.h"
 #include "Seraph/Scene/Entity.h"
 
@@ -28,20 +25,9 @@ RuntimeLayer::RuntimeLayer(Ref<Scene> scene, Ref<SceneRenderer> sceneRenderer)
 
 void RuntimeLayer::OnAttach()
 {
-    // Clear the scene view with the renderer's clear color (depth clears to 0.0
-    // for reversed-Z, matching the editor). The scene draws to this view; view 0
-    // touches the backbuffer in Renderer::FlushFrame.
-    const glm::vec3 clearColor = m_SceneRenderer->GetSettings().ClearColor;
-    const u32 rgba =
-        EncodeColorRgba8(clearColor.r, clearColor.g, clearColor.b, 1.0f);
-    bgfx::setViewClear(
-        ViewId::Scene, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH, rgba, 0.0f, 0);
-
-    // A data-loaded camera has no view id set (unlike a hand-built one), so point
-    // the primary camera at the scene view or nothing renders.
-    if (Entity camera = m_Scene->GetMainCameraEntity())
-        camera.GetComponent<CameraComponent>().Camera.SetViewId(ViewId::Scene);
-    else
+    // The primary camera is pointed at the scene pass's view each frame (the
+    // render graph assigns it); without one nothing renders.
+    if (!m_Scene->GetMainCameraEntity())
         SP_CORE_WARN_TAG(
             "Runtime", "Startup scene has no primary camera; nothing will render");
 
@@ -57,7 +43,7 @@ void RuntimeLayer::OnAttach()
 void RuntimeLayer::OnDetach()
 {
     m_Scene->OnRuntimeStop();
-    m_HdrTarget.Destroy();
+    m_RenderGraph.Destroy();
 }
 
 void RuntimeLayer::OnUpdate(f64 dt)
@@ -66,24 +52,30 @@ void RuntimeLayer::OnUpdate(f64 dt)
 
     auto [w, h] = Application::Instance().Window().Size();
 
-    // Render the scene into the HDR target (view 1), then tonemap it to the
-    // backbuffer (view 4). The scene view's clear is set in OnAttach.
-    if (!m_HdrTarget.IsValid())
-        m_HdrTarget.Create(w, h, HDRColorFormat());
-    else if (m_HdrTarget.width != w || m_HdrTarget.height != h)
-        m_HdrTarget.Resize(w, h);
-
-    RenderPass::ToTarget(ViewId::Scene, m_HdrTarget.fb,
-        static_cast<u16>(w), static_cast<u16>(h)).Bind();
     m_Scene->SetViewportBounds(0, 0, w, h);
 
-    m_Scene->OnRenderRuntime(m_SceneRenderer);
-
-    RenderPass::ToBackbuffer(ViewId::Tonemap,
-        static_cast<u16>(w), static_cast<u16>(h)).Bind();
-    const ProjectGraphicsSettings& gs = RenderSystem::GetSettings();
-    Renderer::TonemapResolve(
-        ViewId::Tonemap, m_HdrTarget.color, gs.Exposure, static_cast<int>(gs.Tonemap));
+    // Render the scene into a transient HDR target (multisampled under MSAA;
+    // only its dynamic-resolution region), then resolve it to the backbuffer
+    // (upscale + tonemap, + FXAA when enabled). SceneRenderer clears the scene
+    // view; the resolve overwrites every backbuffer pixel.
+    const f32 scale = m_DynamicResolution.Update(dt);
+    const RenderGraphResource hdr =
+        m_RenderGraph.CreateTarget("SceneHDR", RenderSystem::SceneColorDesc(w, h));
+    const RenderGraphResource backbuffer =
+        m_RenderGraph.ImportBackbuffer(static_cast<u16>(w), static_cast<u16>(h));
+
+    m_RenderGraph.AddPass("Scene", [this, scale](const RenderGraphPassContext& pass) {
+            if (Entity camera = m_Scene->GetMainCameraEntity())
+                camera.GetComponent<CameraComponent>().Camera.SetViewId(pass.ViewId);
+            m_SceneRenderer->SetTargetHeight(pass.Height);
+            m_Scene->OnRenderRuntime(m_SceneRenderer);
+            DynamicResolution::SetViewRect(pass, scale);
+        })
+        .Write(hdr);
+
+    RenderSystem::AddResolvePasses(m_RenderGraph, hdr, backbuffer, scale);
+
+    m_RenderGraph.Execute();
 }
 
 void RuntimeLayer::OnImGuiRender()
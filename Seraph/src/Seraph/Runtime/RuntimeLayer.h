@@ -10,7 +10,8 @@
 #include "Seraph/Console/ConsolePanel.h"
 #include "Seraph/Core/Layer.h"
 #include "Seraph/Core/Ref.h"
-#include "Seraph/Graphics/RenderTarget.h"
+#include "Seraph/Graphics/DynamicResolution.h"
+#include "Seraph/Graphics/RenderGraph.h"
 #include "Seraph/Graphics/SceneRenderer.h"
 #include "Seraph/Scene/Scene.h"
 
@@ -29,12 +30,11 @@ public:
     void OnEvent(Event& e) override;
 
 private:
-    // Canonical bgfx view ids live in Seraph/Graphics/ViewId.h.
-
     Ref<Scene>         m_Scene;
     Ref<SceneRenderer> m_SceneRenderer;
     ConsolePanel       m_ConsolePanel;
-    RenderTarget       m_HdrTarget; // HDR scene target; tonemapped to the backbuffer
+    RenderGraph        m_RenderGraph; // scene -> transient HDR target -> tonemap to backbuffer
+    DynamicResolution  m_DynamicResolution; // scale of the scene's region of the HDR target
 };
 
 } // namespace Seraph
@@ -12,7 +12,9 @@
 #include "PointLightComponent.h"
 #include "RelationshipComponent.h"
 #include "RigidBodyComponent.h"
+#include "SpatialProxyComponent.h"
 #include "SpotLightComponent.h"
 #include "SphereColliderComponent.h"
 #include "TagComponent.h"
 #include "TransformComponent.h"
+#include "WorldTransformComponent.h"
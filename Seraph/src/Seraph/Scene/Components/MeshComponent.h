@@ -33,6 +33,11 @@ struct SCLASS() MeshComponent
     SPROPERTY(serialize.flow = true, serialize.omitempty = true)
     std::vector<AssetHandle> MaterialOverrides;
 
+    // Rasterised (at its coarsest LOD) into the runtime occlusion buffer, hiding
+    // the meshes behind it. Meant for large, solid meshes: walls, terrain, rocks.
+    SPROPERTY(settings.display = "Occluder")
+    bool Occluder = false;
+
     // Convenience handle accessors retained for existing call sites.
     [[nodiscard]] AssetHandle GetMeshHandle() const { return Mesh.Handle(); }
     void SetMeshHandle(AssetHandle handle) { Mesh = handle; }
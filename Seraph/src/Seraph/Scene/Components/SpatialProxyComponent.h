@@ -0,0 +1,29 @@
+//
+// Created by ruben on 2026/10/17.
+//
+
+#pragma once
+
+#include "Seraph/Asset/AssetHandle.h"
+#include "Seraph/Core/Base.h"
+#include "Seraph/Math/Bounds.h"
+
+namespace Seraph
+{
+
+// Derived, runtime-only link from a renderable entity to its leaf in the scene's
+// spatial index (not serialized, not copied by Scene::Copy). Owned by
+// SceneSpatialIndex::Update. The mesh handle, its object-space bounds and the
+// WorldTransformComponent revision snapshot what the leaf's box was built from,
+// so an unchanged entity costs no asset lookup or tree work. The asset
+// generation catches the mesh reloading under the same handle.
+struct SpatialProxyComponent
+{
+    s32 Proxy = -1;
+    AssetHandle Mesh = c_NullAssetHandle;
+    AABB LocalBounds;
+    u32 TransformRevision = 0;
+    u64 AssetGeneration = 0;
+};
+
+} // namespace Seraph
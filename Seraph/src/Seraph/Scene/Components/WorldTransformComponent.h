@@ -0,0 +1,35 @@
+//
+// Created by ruben on 2026/10/17.
+//
+
+#pragma once
+
+#include "Seraph/Core/Base.h"
+#include "Seraph/Core/UUID.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace Seraph
+{
+
+// Derived, runtime-only cache of an entity's world matrix (not serialized, not
+// copied by Scene::Copy). Owned by Scene::UpdateWorldTransforms, which refreshes
+// it once per frame in hierarchy order. The Local* / Parent fields snapshot the
+// inputs the matrix was built from: TransformComponent is mutated in place with
+// no change notification, so an entity is dirty when its current local TRS or
+// parent no longer matches the snapshot (or an ancestor was recomputed).
+struct WorldTransformComponent
+{
+    glm::mat4 Transform{1.0f};
+    // Bumped each time Transform is recomputed, so other caches (the spatial
+    // index) can tell a moved entity from a still one without comparing matrices.
+    u32 Revision = 0;
+
+    glm::vec3 LocalTranslation{0.0f};
+    glm::quat LocalRotation{1.0f, 0.0f, 0.0f, 0.0f};
+    glm::vec3 LocalScale{1.0f};
+    UUID Parent = 0;
+};
+
+} // namespace Seraph
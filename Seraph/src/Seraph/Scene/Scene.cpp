@@ -18,6 +18,7 @@
 #include "Components/SphereColliderComponent.h"
 #include "Components/TagComponent.h"
 #include "Components/TransformComponent.h"
+#include "Components/WorldTransformComponent.h"
 #include "CopyableComponents.h"
 #include "Seraph/Core/Assert.h"
 #include "Seraph/Editor/EditorCamera.h"
@@ -105,6 +106,7 @@ void Scene::DrainDestroyQueue()
             m_PhysicsScene->DestroyBody(entity);
         if (m_PhysicsScene && entity.HasComponent<CharacterControllerComponent>())
             m_PhysicsScene->DestroyCharacterController(entity);
+        m_SpatialIndex.Remove(m_Registry, handle);
         m_EntityIDMap.erase(m_Registry.get<IDComponent>(handle).ID);
         m_Registry.destroy(handle);
         m_DestroyQueue.pop();
@@ -124,6 +126,9 @@ void Scene::OnUpdateRuntime(f64 dt)
     // Simulate with every instance already live.
     if (m_ScriptEngine)
         m_ScriptEngine->OnUpdate(dt);
+    // Kinematic bodies are driven from the cached world pose, so refresh it after
+    // scripts have moved things and before the step reads it.
+    UpdateWorldTransforms();
     if (m_PhysicsScene)
         m_PhysicsScene->Simulate(static_cast<f32>(dt));
     // Drain again — the step (or a contact callback) may have queued destroys.
@@ -252,13 +257,15 @@ Entity Scene::TryGetEntityWithUUID(UUID id) const
 
 void Scene::SubmitLights(Ref<SceneRenderer> sceneRenderer)
 {
+    // Every light is submitted; the scene renderer culls them against the
+    // camera and keeps the most important ones (SceneRenderer::SubmitLight).
     // The light's direction of travel is the entity's forward axis (world -Z).
     const auto directionOf = [this](Entity entity) {
-        const glm::mat4 world = GetWorldSpaceTransformMatrix(entity);
+        const glm::mat4 world = GetWorldTransform(entity);
         return glm::normalize(glm::mat3(world) * glm::vec3(0.0f, 0.0f, -1.0f));
     };
     const auto positionOf = [this](Entity entity) {
-        return glm::vec3(GetWorldSpaceTransformMatrix(entity)[3]);
+        return glm::vec3(GetWorldTransform(entity)[3]);
     };
 
     for (auto [e, dl] : m_Registry.view<DirectionalLightComponent>().each()) {
@@ -297,6 +304,15 @@ void Scene::SubmitLights(Ref<SceneRenderer> sceneRenderer)
     }
 }
 
+void Scene::ExtractMeshes(Ref<SceneRenderer> sceneRenderer)
+{
+    for (auto [e, mc, id] : m_Registry.view<MeshComponent, IDComponent>().each()) {
+        if (Ref<Mesh> mesh = mc.Mesh.As())
+            sceneRenderer->SubmitMesh(*mesh, GetWorldTransform({e, this}), mc.MaterialOverrides,
+                                      id.ID, mc.Occluder);
+    }
+}
+
 void Scene::OnRenderRuntime(Ref<SceneRenderer> sceneRenderer)
 {
     Entity cameraEntity = GetMainCameraEntity();
@@ -305,8 +321,10 @@ void Scene::OnRenderRuntime(Ref<SceneRenderer> sceneRenderer)
         return;
     }
 
-    glm::mat4 cameraViewMatrix =
-        glm::inverse(GetWorldSpaceTransformMatrix(cameraEntity));
+    // Picks up the physics writeback and anything else moved since the update.
+    UpdateWorldTransforms();
+
+    glm::mat4 cameraViewMatrix = glm::inverse(GetWorldTransform(cameraEntity));
 
     SceneCamera& camera = cameraEntity.GetComponent<CameraComponent>();
     camera.SetViewportBounds(m_ViewportLeft, m_ViewportTop, m_ViewportRight, m_ViewportBottom);
@@ -317,15 +335,9 @@ void Scene::OnRenderRuntime(Ref<SceneRenderer> sceneRenderer)
             camera.GetRadPerspectiveVerticalFOV()});
     sceneRenderer->Clear();
     SubmitLights(sceneRenderer);
+    ExtractMeshes(sceneRenderer);
+    sceneRenderer->CullOcclusion();
     sceneRenderer->RenderSunShadow();
-
-    for (auto [e, mc] : m_Registry.view<MeshComponent>().each()) {
-        if (Ref<Mesh> mesh = mc.Mesh.As()) {
-            Entity entity{e, this};
-            sceneRenderer->SubmitMesh(
-                *mesh, GetWorldSpaceTransformMatrix(entity), mc.MaterialOverrides);
-        }
-    }
     sceneRenderer->DrawSkybox();
     RenderDebug(sceneRenderer, camera.GetViewId(), /*runtime=*/true);
     sceneRenderer->EndScene();
@@ -333,6 +345,8 @@ void Scene::OnRenderRuntime(Ref<SceneRenderer> sceneRenderer)
 
 void Scene::OnRenderEditor(Ref<SceneRenderer> sceneRenderer, const EditorCamera& editorCamera)
 {
+    UpdateWorldTransforms();
+
     sceneRenderer->SetScene(this);
     sceneRenderer->BeginScene({
         static_cast<const Camera&>(editorCamera),
@@ -343,15 +357,8 @@ void Scene::OnRenderEditor(Ref<SceneRenderer> sceneRenderer, const EditorCamera&
     });
     sceneRenderer->Clear();
     SubmitLights(sceneRenderer);
+    ExtractMeshes(sceneRenderer);
     sceneRenderer->RenderSunShadow();
-
-    for (auto [e, mc] : m_Registry.view<MeshComponent>().each()) {
-        if (Ref<Mesh> mesh = mc.Mesh.As()) {
-            Entity entity{e, this};
-            sceneRenderer->SubmitMesh(
-                *mesh, GetWorldSpaceTransformMatrix(entity), mc.MaterialOverrides);
-        }
-    }
     sceneRenderer->DrawSkybox();
     RenderDebug(sceneRenderer, editorCamera.GetViewId(), /*runtime=*/false);
     sceneRenderer->EndScene();
@@ -374,13 +381,13 @@ void Scene::RenderDebug(Ref<SceneRenderer> sceneRenderer, u16 viewId, bool runti
         // positioned by the entity's world transform combined with the offset.
         for (auto [handle, c] : m_Registry.view<BoxColliderComponent>().each()) {
             Entity e{handle, this};
-            const glm::mat4 world = GetWorldSpaceTransformMatrix(e) *
+            const glm::mat4 world = GetWorldTransform(e) *
                 glm::translate(glm::mat4(1.0f), c.Offset);
             DebugRenderer::DrawBox(world, c.HalfExtents, colliderColor);
         }
         for (auto [handle, c] : m_Registry.view<SphereColliderComponent>().each()) {
             Entity e{handle, this};
-            const glm::mat4 world = GetWorldSpaceTransformMatrix(e) *
+            const glm::mat4 world = GetWorldTransform(e) *
                 glm::translate(glm::mat4(1.0f), c.Offset);
             const glm::vec3 center = glm::vec3(world[3]);
             // Sphere can't show non-uniform scale; approximate with the X axis length.
@@ -389,7 +396,7 @@ void Scene::RenderDebug(Ref<SceneRenderer> sceneRenderer, u16 viewId, bool runti
         }
         for (auto [handle, c] : m_Registry.view<CapsuleColliderComponent>().each()) {
             Entity e{handle, this};
-            const glm::mat4 world = GetWorldSpaceTransformMatrix(e) *
+            const glm::mat4 world = GetWorldTransform(e) *
                 glm::translate(glm::mat4(1.0f), c.Offset);
             DebugRenderer::DrawCapsule(world, c.Radius, c.HalfHeight, colliderColor);
         }
@@ -425,6 +432,58 @@ void Scene::ConvertToWorldSpace(Entity entity)
     entityTransform.SetTransform(transform);
 }
 
+void Scene::UpdateWorldTransforms()
+{
+    // Roots: no parent, or a parent that no longer resolves (matches
+    // GetWorldSpaceTransformMatrix, which treats a dangling parent as identity).
+    for (auto [handle, rel] : m_Registry.view<RelationshipComponent>().each()) {
+        if (rel.ParentHandle != 0 && m_EntityIDMap.contains(rel.ParentHandle))
+            continue;
+        UpdateWorldTransform(handle, glm::mat4(1.0f), false);
+    }
+    m_SpatialIndex.Update(m_Registry);
+}
+
+void Scene::UpdateWorldTransform(entt::entity handle, const glm::mat4& parentWorld, bool parentChanged)
+{
+    const auto* tc = m_Registry.try_get<TransformComponent>(handle);
+    if (!tc)
+        return;
+    const auto& rel = m_Registry.get<RelationshipComponent>(handle);
+
+    auto* wt = m_Registry.try_get<WorldTransformComponent>(handle);
+    const glm::quat rotation = tc->GetRotation();
+    const bool dirty = parentChanged || !wt ||
+        wt->LocalTranslation != tc->Translation || wt->LocalRotation != rotation ||
+        wt->LocalScale != tc->Scale || wt->Parent != rel.ParentHandle;
+    if (dirty) {
+        if (!wt)
+            wt = &m_Registry.emplace<WorldTransformComponent>(handle);
+        wt->LocalTranslation = tc->Translation;
+        wt->LocalRotation = rotation;
+        wt->LocalScale = tc->Scale;
+        wt->Parent = rel.ParentHandle;
+        wt->Transform = parentWorld * tc->GetTransform();
+        ++wt->Revision;
+    }
+
+    // By value: children may emplace their own cache entry on first visit.
+    const glm::mat4 world = wt->Transform;
+    for (const UUID child : rel.Children) {
+        const auto it = m_EntityIDMap.find(child);
+        if (it == m_EntityIDMap.end())
+            continue;
+        UpdateWorldTransform(static_cast<entt::entity>(it->second), world, dirty);
+    }
+}
+
+glm::mat4 Scene::GetWorldTransform(Entity entity)
+{
+    if (const auto* wt = m_Registry.try_get<WorldTransformComponent>(entity))
+        return wt->Transform;
+    return GetWorldSpaceTransformMatrix(entity);
+}
+
 glm::mat4 Scene::GetWorldSpaceTransformMatrix(Entity entity)
 {
     glm::mat4 transform(1.0f);
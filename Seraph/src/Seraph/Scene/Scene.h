@@ -7,6 +7,7 @@
 #include "Components/TransformComponent.h"
 #include "Entity.h"
 #include "SceneEnvironment.h"
+#include "SceneSpatialIndex.h"
 #include "Seraph/Core/Base.h"
 #include "Seraph/Core/Ref.h"
 #include "Seraph/Core/UUID.h"
@@ -66,6 +67,11 @@ public:
     void OnRuntimeStop();
     bool IsPlaying() const { return m_IsPlaying; }
     Ref<PhysicsScene> GetPhysicsScene() const { return m_PhysicsScene; }
+
+    // Bounds-level spatial queries (ray, frustum, overlap, nearest) over every
+    // entity with a loaded mesh, in edit and play mode. Current as of the last
+    // UpdateWorldTransforms.
+    const SceneSpatialIndex& GetSpatialIndex() const { return m_SpatialIndex; }
     // Render using the primary CameraComponent entity (runtime/play mode).
     virtual void OnRenderRuntime(Ref<SceneRenderer> sceneRenderer);
     // Render using an external editor camera (editor mode). Caller is
@@ -84,6 +90,12 @@ public:
     // transform. Call after BeginScene, before the mesh loop.
     void SubmitLights(Ref<SceneRenderer> sceneRenderer);
 
+    // Render extraction: the frame's single walk over MeshComponents. Resolves
+    // each mesh asset and cached world transform into the renderer's render list,
+    // which the shadow, scene and pick passes then consume. Call after
+    // SubmitLights, before RenderSunShadow.
+    void ExtractMeshes(Ref<SceneRenderer> sceneRenderer);
+
     virtual void OnDestroy() {}
     virtual void OnEvent([[maybe_unused]] Event& e) {}
 
@@ -97,6 +109,20 @@ public:
         return m_Registry.view<Components...>();
     }
 
+    // Refresh every entity's WorldTransformComponent in hierarchy order (roots
+    // first), recomputing only subtrees whose local transform or parent changed
+    // since the last refresh, then sync the spatial index with the moved
+    // entities. Runs once per frame from the update/render entry points;
+    // per-frame consumers then read GetWorldTransform.
+    void UpdateWorldTransforms();
+
+    // Cached world matrix as of the last UpdateWorldTransforms. Edits made to a
+    // TransformComponent since then are not reflected — tools that edit and read
+    // back in the same frame (gizmo, reparenting) use GetWorldSpaceTransformMatrix,
+    // which always walks the parent chain. Falls back to that walk for an entity
+    // created after the last refresh.
+    glm::mat4 GetWorldTransform(Entity entity);
+
     void ConvertToLocalSpace(Entity entity);
     void ConvertToWorldSpace(Entity entity);
     glm::mat4 GetWorldSpaceTransformMatrix(Entity entity);
@@ -116,6 +142,10 @@ private:
     // releasing each one's physics body (if any) before it leaves the registry.
     void DrainDestroyQueue();
 
+    // UpdateWorldTransforms recursion: refresh `handle` under `parentWorld`,
+    // forcing a rebuild when `parentChanged`, then descend into its children.
+    void UpdateWorldTransform(entt::entity handle, const glm::mat4& parentWorld, bool parentChanged);
+
 	UUID m_SceneID;
 	std::string m_Name;
 
@@ -124,6 +154,7 @@ private:
     EntityMap m_EntityIDMap;
 
     SceneEnvironment m_Environment;
+    SceneSpatialIndex m_SpatialIndex{this};
 
     Ref<PhysicsScene> m_PhysicsScene;
     // Created in OnRuntimeStart, dropped in OnRuntimeStop. Incomplete type here
@@ -0,0 +1,210 @@
+//
+// Created by ruben on 2026/10/17.
+//
+
+#include "SceneSpatialIndex.h"
+
+#include "Components/MeshComponent.h"
+#include "Components/SpatialProxyComponent.h"
+#include "Components/WorldTransformComponent.h"
+#include "Seraph/Asset/AssetManager.h"
+#include "Seraph/Graphics/Mesh.h"
+
+#include <entt/entt.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Seraph
+{
+
+namespace
+{
+// Face of `box` the ray enters through (the slab that set the entry distance);
+// -direction when the origin is inside.
+glm::vec3 EntryNormal(const glm::vec3& origin, const glm::vec3& direction, const AABB& box,
+                      float t)
+{
+    if (t <= 0.0f)
+        return -glm::normalize(direction);
+    const glm::vec3 point = origin + direction * t;
+    float closest = std::numeric_limits<float>::max();
+    glm::vec3 normal(0.0f);
+    for (int axis = 0; axis < 3; ++axis) {
+        for (const float side : {-1.0f, 1.0f}) {
+            const float face = side < 0.0f ? box.Min[axis] : box.Max[axis];
+            const float distance = std::abs(point[axis] - face);
+            if (distance < closest) {
+                closest = distance;
+                normal = glm::vec3(0.0f);
+                normal[axis] = side;
+            }
+        }
+    }
+    return normal;
+}
+} // namespace
+
+Entity SceneSpatialIndex::ToEntity(u64 userData) const
+{
+    return {static_cast<entt::entity>(userData), m_Scene};
+}
+
+void SceneSpatialIndex::Update(entt::registry& registry)
+{
+    // Bumped when an asset is reloaded or unloaded: every leaf re-reads its
+    // mesh's bounds, since a mesh may have changed under the same handle.
+    const u64 generation = AssetManager::GetGeneration();
+    for (auto [handle, mc, wt] : registry.view<MeshComponent, WorldTransformComponent>().each()) {
+        auto* proxy = registry.try_get<SpatialProxyComponent>(handle);
+        const bool sameMesh = proxy && proxy->Mesh == mc.Mesh.Handle() &&
+                              proxy->AssetGeneration == generation;
+        // Unchanged since the leaf was built: no asset lookup, no tree work.
+        if (sameMesh && proxy->TransformRevision == wt.Revision)
+            continue;
+
+        AABB localBounds;
+        if (sameMesh) {
+            localBounds = proxy->LocalBounds;
+        } else if (Ref<Mesh> mesh = mc.Mesh.As()) {
+            localBounds = mesh->Bounds();
+        }
+        // No (loaded) mesh, or one without bounds: not indexed until it has one.
+        if (!localBounds.IsValid()) {
+            if (proxy)
+                Remove(registry, handle);
+            continue;
+        }
+
+        const AABB world = localBounds.Transformed(wt.Transform);
+        if (!proxy) {
+            proxy = &registry.emplace<SpatialProxyComponent>(handle);
+            proxy->Proxy = m_Tree.CreateProxy(world, static_cast<u64>(entt::to_integral(handle)));
+        } else {
+            m_Tree.MoveProxy(proxy->Proxy, world);
+        }
+        proxy->Mesh = mc.Mesh.Handle();
+        proxy->LocalBounds = localBounds;
+        proxy->TransformRevision = wt.Revision;
+        proxy->AssetGeneration = generation;
+    }
+
+    // Entities that lost their MeshComponent since the last update.
+    m_Stale.clear();
+    for (const entt::entity handle :
+         registry.view<SpatialProxyComponent>(entt::exclude<MeshComponent>))
+        m_Stale.push_back(handle);
+    for (const entt::entity handle : m_Stale)
+        Remove(registry, handle);
+}
+
+void SceneSpatialIndex::Remove(entt::registry& registry, entt::entity handle)
+{
+    const auto* proxy = registry.try_get<SpatialProxyComponent>(handle);
+    if (!proxy)
+        return;
+    m_Tree.DestroyProxy(proxy->Proxy);
+    registry.remove<SpatialProxyComponent>(handle);
+}
+
+SceneQueryHit SceneSpatialIndex::CastRay(const glm::vec3& origin, const glm::vec3& direction,
+                                         float maxDistance) const
+{
+    SceneQueryHit hit;
+    const float length = glm::length(direction);
+    if (length <= 0.0f)
+        return hit;
+    const glm::vec3 dir = direction / length;
+
+    s32 closest = DynamicAABBTree::c_NullNode;
+    float closestT = maxDistance;
+    m_Tree.RayCast(origin, dir, maxDistance, [&](s32 proxy, u64, float t) {
+        if (t <= closestT) {
+            closest = proxy;
+            closestT = t;
+        }
+        return closestT;
+    });
+    if (closest == DynamicAABBTree::c_NullNode)
+        return hit;
+
+    hit.HitEntity = ToEntity(m_Tree.GetUserData(closest));
+    hit.Distance = closestT;
+    hit.Position = origin + dir * closestT;
+    hit.Normal = EntryNormal(origin, dir, m_Tree.GetBounds(closest), closestT);
+    return hit;
+}
+
+void SceneSpatialIndex::CastRayAll(const glm::vec3& origin, const glm::vec3& direction,
+                                   float maxDistance, std::vector<SceneQueryHit>& out) const
+{
+    out.clear();
+    const float length = glm::length(direction);
+    if (length <= 0.0f)
+        return;
+    const glm::vec3 dir = direction / length;
+
+    m_Tree.RayCast(origin, dir, maxDistance, [&](s32 proxy, u64 userData, float t) {
+        SceneQueryHit& hit = out.emplace_back();
+        hit.HitEntity = ToEntity(userData);
+        hit.Distance = t;
+        hit.Position = origin + dir * t;
+        hit.Normal = EntryNormal(origin, dir, m_Tree.GetBounds(proxy), t);
+        return maxDistance;
+    });
+    std::sort(out.begin(), out.end(), [](const SceneQueryHit& a, const SceneQueryHit& b) {
+        return a.Distance < b.Distance;
+    });
+}
+
+void SceneSpatialIndex::QueryFrustum(const Frustum& frustum, std::vector<Entity>& out) const
+{
+    out.clear();
+    m_Tree.QueryFrustum(frustum, [&](s32, u64 userData) {
+        out.push_back(ToEntity(userData));
+        return true;
+    });
+}
+
+void SceneSpatialIndex::OverlapBox(const AABB& box, std::vector<Entity>& out) const
+{
+    out.clear();
+    if (!box.IsValid())
+        return;
+    m_Tree.QueryBox(box, [&](s32, u64 userData) {
+        out.push_back(ToEntity(userData));
+        return true;
+    });
+}
+
+void SceneSpatialIndex::OverlapSphere(const glm::vec3& center, float radius,
+                                      std::vector<Entity>& out) const
+{
+    out.clear();
+    if (radius < 0.0f)
+        return;
+    m_Tree.QuerySphere(center, radius, [&](s32, u64 userData) {
+        out.push_back(ToEntity(userData));
+        return true;
+    });
+}
+
+void SceneSpatialIndex::FindNearest(const glm::vec3& point, u32 count, std::vector<Entity>& out,
+                                    float maxDistance) const
+{
+    out.clear();
+    m_Nearest.clear();
+    m_Tree.FindNearest(point, count, maxDistance, m_Nearest);
+    out.reserve(m_Nearest.size());
+    for (const std::pair<s32, float>& nearest : m_Nearest)
+        out.push_back(ToEntity(m_Tree.GetUserData(nearest.first)));
+}
+
+AABB SceneSpatialIndex::GetBounds(Entity entity) const
+{
+    const auto* proxy = entity ? entity.TryGetComponent<SpatialProxyComponent>() : nullptr;
+    return proxy ? m_Tree.GetBounds(proxy->Proxy) : AABB{};
+}
+
+} // namespace Seraph
@@ -0,0 +1,79 @@
+//
+// Scene-level spatial index: a DynamicAABBTree over every renderable entity
+// (MeshComponent with a loaded mesh), keyed by its world-space bounds. Unlike
+// PhysicsScene::CastRay it needs no physics body and works in edit and play
+// mode alike; hits are against the world AABB, not the triangles.
+//
+// Scene owns one and syncs it at the end of UpdateWorldTransforms, so queries
+// see the world as of the last refresh (the previous frame's, from a script's
+// OnUpdate). Only entities whose world transform revision or mesh changed touch
+// the tree, and a leaf that stays within its fattened box is not reinserted.
+//
+
+#pragma once
+
+#include "Seraph/Core/Base.h"
+#include "Seraph/Math/Bounds.h"
+#include "Seraph/Math/DynamicAABBTree.h"
+#include "Seraph/Physics/SceneQueries.h"
+#include "Seraph/Scene/Entity.h"
+
+#include <entt/entity/fwd.hpp>
+#include <glm/glm.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace Seraph
+{
+class Scene;
+
+class SceneSpatialIndex
+{
+public:
+    explicit SceneSpatialIndex(Scene* scene) : m_Scene(scene) {}
+
+    // Closest entity whose bounds the ray hits within maxDistance (direction
+    // need not be normalized). Position / Normal are the entry point and face
+    // of the box; a ray starting inside a box hits it at distance 0, facing back
+    // along the ray. HitEntity is empty on a miss.
+    [[nodiscard]] SceneQueryHit CastRay(const glm::vec3& origin, const glm::vec3& direction,
+                                        float maxDistance = 1.0e6f) const;
+    // Every entity the ray hits within maxDistance, nearest first.
+    void CastRayAll(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                    std::vector<SceneQueryHit>& out) const;
+
+    // Entities whose bounds touch the frustum / box / sphere, in no particular
+    // order. `out` is cleared first.
+    void QueryFrustum(const Frustum& frustum, std::vector<Entity>& out) const;
+    void OverlapBox(const AABB& box, std::vector<Entity>& out) const;
+    void OverlapSphere(const glm::vec3& center, float radius, std::vector<Entity>& out) const;
+
+    // The `count` entities whose bounds are nearest `point` (distance 0 inside),
+    // nearest first, ignoring any farther than maxDistance. `out` is cleared first.
+    void FindNearest(const glm::vec3& point, u32 count, std::vector<Entity>& out,
+                     float maxDistance = std::numeric_limits<float>::max()) const;
+
+    // World bounds the index holds for `entity` (invalid if it is not indexed).
+    [[nodiscard]] AABB GetBounds(Entity entity) const;
+    [[nodiscard]] u32 GetEntityCount() const { return m_Tree.GetProxyCount(); }
+    [[nodiscard]] const DynamicAABBTree& GetTree() const { return m_Tree; }
+
+private:
+    // Insert, refit or drop the leaves of every entity whose mesh, mesh bounds
+    // or world transform changed since the last call.
+    void Update(entt::registry& registry);
+    // Drop an entity's leaf (before it leaves the registry).
+    void Remove(entt::registry& registry, entt::entity handle);
+
+    [[nodiscard]] Entity ToEntity(u64 userData) const;
+
+    Scene* m_Scene = nullptr;
+    DynamicAABBTree m_Tree;
+    std::vector<entt::entity> m_Stale; // scratch for Update
+    mutable std::vector<std::pair<s32, float>> m_Nearest; // scratch for FindNearest
+
+    friend class Scene;
+};
+
+} // namespace Seraph
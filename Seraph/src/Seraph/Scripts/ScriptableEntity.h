@@ -96,6 +96,11 @@ protected:
     // Unlike FindEntity, never asserts — the safe way to dereference an EntityRef.
     [[nodiscard]] Entity TryFindEntity(UUID id) const { return m_Scene->TryGetEntityWithUUID(id); }
 
+    // Bounds-level queries over the scene's renderable entities (ray, frustum,
+    // overlap, nearest); no physics body needed. See SceneSpatialIndex.h.
+    [[nodiscard]] const SceneSpatialIndex& GetSpatialIndex() const
+    { return m_Scene->GetSpatialIndex(); }
+
     [[nodiscard]] Ref<PhysicsBody> GetPhysicsBody() const
     { return m_Scene->GetPhysicsScene()->GetBody(m_Entity); }
 
@@ -0,0 +1,371 @@
+//
+// Created by ruben on 2026/10/17.
+//
+// Checks DynamicAABBTree against a brute-force scan of the same boxes. A
+// seeded random sequence of creates, small moves (inside the fat box), long
+// moves (reinsertion) and destroys runs for a number of rounds; after each
+// round every query kind (box, sphere, frustum, ray: all hits and closest hit,
+// nearest k) is run at random places and its result compared with the scan.
+// Exits non-zero on the first mismatch round.
+//
+//   DynamicAABBTreeCheck [proxies] [rounds] [queries per round] [seed]
+//
+
+#include <Seraph/Math/DynamicAABBTree.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace Seraph;
+
+namespace
+{
+struct Entry
+{
+    s32 Proxy = DynamicAABBTree::c_NullNode;
+    AABB Box;
+};
+
+struct Timer
+{
+    std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now();
+    [[nodiscard]] double Ms() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start)
+            .count();
+    }
+};
+
+class Check
+{
+public:
+    Check(u32 proxies, u32 seed) : m_Target(proxies), m_Rng(seed) {}
+
+    bool Run(u32 rounds, u32 queries)
+    {
+        Timer insert;
+        while (m_Live < m_Target)
+            Create();
+        std::printf("inserted %u proxies in %.1f ms, height %d\n", m_Target, insert.Ms(),
+                    m_Tree.GetHeight());
+
+        for (u32 round = 0; round < rounds; ++round) {
+            Mutate();
+            if (m_Tree.GetProxyCount() != m_Live) {
+                std::printf("round %u: tree holds %u proxies, expected %u\n", round,
+                            m_Tree.GetProxyCount(), m_Live);
+                return false;
+            }
+            for (u32 q = 0; q < queries; ++q) {
+                CheckBox();
+                CheckSphere();
+                CheckFrustum();
+                CheckRay();
+                CheckNearest();
+            }
+            if (m_Mismatches > 0) {
+                std::printf("round %u: %u mismatches\n", round, m_Mismatches);
+                return false;
+            }
+        }
+
+        std::printf("%u rounds: %u creates, %u small moves, %u long moves (%u reinserted), "
+                    "%u destroys; %u live, height %d\n",
+                    rounds, m_Creates, m_SmallMoves, m_LongMoves, m_Reinserts, m_Destroys,
+                    m_Live, m_Tree.GetHeight());
+        std::printf("%-8s %8s %10s %12s %12s\n", "query", "count", "results", "tree ms",
+                    "scan ms");
+        for (const Stat& stat : m_Stats)
+            std::printf("%-8s %8u %10llu %12.2f %12.2f\n", stat.Name, stat.Count,
+                        static_cast<unsigned long long>(stat.Results), stat.TreeMs, stat.ScanMs);
+        std::printf("all queries matched the brute-force scan\n");
+        return true;
+    }
+
+private:
+    enum Kind { Box, Sphere, FrustumQuery, Ray, RayClosest, Nearest, KindCount };
+    struct Stat
+    {
+        const char* Name;
+        u32 Count = 0;
+        u64 Results = 0;
+        double TreeMs = 0.0;
+        double ScanMs = 0.0;
+    };
+
+    float Uniform(float lo, float hi)
+    {
+        return std::uniform_real_distribution<float>(lo, hi)(m_Rng);
+    }
+    glm::vec3 Point() { return {Uniform(-500, 500), Uniform(-50, 50), Uniform(-500, 500)}; }
+    AABB RandomBox(const glm::vec3& center)
+    {
+        const glm::vec3 half(Uniform(0.1f, 4.0f), Uniform(0.1f, 4.0f), Uniform(0.1f, 4.0f));
+        return {center - half, center + half};
+    }
+
+    void Create()
+    {
+        const auto slot = static_cast<u32>(m_Entries.size());
+        Entry& entry = m_Entries.emplace_back();
+        entry.Box = RandomBox(Point());
+        entry.Proxy = m_Tree.CreateProxy(entry.Box, slot);
+        ++m_Live;
+    }
+
+    // Random live entry, or null when there is none.
+    Entry* PickLive()
+    {
+        if (m_Live == 0)
+            return nullptr;
+        for (;;) {
+            Entry& entry = m_Entries[std::uniform_int_distribution<size_t>(
+                0, m_Entries.size() - 1)(m_Rng)];
+            if (entry.Proxy != DynamicAABBTree::c_NullNode)
+                return &entry;
+        }
+    }
+
+    void Mutate()
+    {
+        const u32 operations = m_Target / 4;
+        for (u32 i = 0; i < operations; ++i) {
+            const float roll = Uniform(0.0f, 1.0f);
+            if (roll < 0.1f) {
+                Create();
+                ++m_Creates;
+            } else if (roll < 0.2f) {
+                if (Entry* entry = PickLive()) {
+                    m_Tree.DestroyProxy(entry->Proxy);
+                    entry->Proxy = DynamicAABBTree::c_NullNode;
+                    --m_Live;
+                    ++m_Destroys;
+                }
+            } else if (Entry* entry = PickLive()) {
+                const bool small = roll < 0.85f;
+                const glm::vec3 delta = small
+                    ? glm::vec3(Uniform(-0.05f, 0.05f), Uniform(-0.05f, 0.05f),
+                                Uniform(-0.05f, 0.05f))
+                    : glm::vec3(Uniform(-60, 60), Uniform(-5, 5), Uniform(-60, 60));
+                // Long moves also resize, so shrinking boxes are covered.
+                entry->Box = small ? AABB(entry->Box.Min + delta, entry->Box.Max + delta)
+                                   : RandomBox(entry->Box.Center() + delta);
+                m_Reinserts += m_Tree.MoveProxy(entry->Proxy, entry->Box) ? 1 : 0;
+                ++(small ? m_SmallMoves : m_LongMoves);
+            }
+        }
+    }
+
+    // Runs `tree` and `scan` (each filling a sorted result list), times both and
+    // counts a mismatch when the lists differ.
+    template<typename T, typename TreeFn, typename ScanFn>
+    void Compare(Kind kind, TreeFn&& tree, ScanFn&& scan)
+    {
+        std::vector<T> fromTree, fromScan;
+        Timer treeTimer;
+        tree(fromTree);
+        const double treeMs = treeTimer.Ms();
+        Timer scanTimer;
+        scan(fromScan);
+        const double scanMs = scanTimer.Ms();
+        std::sort(fromTree.begin(), fromTree.end());
+        std::sort(fromScan.begin(), fromScan.end());
+
+        Stat& stat = m_Stats[kind];
+        ++stat.Count;
+        stat.Results += fromScan.size();
+        stat.TreeMs += treeMs;
+        stat.ScanMs += scanMs;
+        if (fromTree != fromScan) {
+            if (m_Mismatches == 0)
+                std::printf("%s: tree %zu results, scan %zu\n", stat.Name, fromTree.size(),
+                            fromScan.size());
+            ++m_Mismatches;
+        }
+    }
+
+    // Overlap query: `query(collect)` runs the tree query with a callback that
+    // records each proxy; `test(box)` is the scan's predicate.
+    template<typename Test, typename Query>
+    void CompareOverlap(Kind kind, Test&& test, Query&& query)
+    {
+        Compare<s32>(
+            kind,
+            [&](std::vector<s32>& out) {
+                query([&out](s32 proxy, u64) {
+                    out.push_back(proxy);
+                    return true;
+                });
+            },
+            [&](std::vector<s32>& out) {
+                for (const Entry& entry : m_Entries)
+                    if (entry.Proxy != DynamicAABBTree::c_NullNode && test(entry.Box))
+                        out.push_back(entry.Proxy);
+            });
+    }
+
+    void CheckBox()
+    {
+        const AABB box = [&] {
+            const glm::vec3 c = Point();
+            const glm::vec3 half(Uniform(1, 40), Uniform(1, 40), Uniform(1, 40));
+            return AABB(c - half, c + half);
+        }();
+        CompareOverlap(
+            Box, [&](const AABB& b) { return Detail::BoxesOverlap(b, box); },
+            [&](const auto& collect) { m_Tree.QueryBox(box, collect); });
+    }
+
+    void CheckSphere()
+    {
+        const glm::vec3 center = Point();
+        const float radius = Uniform(1, 40);
+        CompareOverlap(
+            Sphere,
+            [&](const AABB& b) {
+                return DynamicAABBTree::DistanceSquared(center, b) <= radius * radius;
+            },
+            [&](const auto& collect) { m_Tree.QuerySphere(center, radius, collect); });
+    }
+
+    void CheckFrustum()
+    {
+        const glm::vec3 eye = Point();
+        const glm::vec3 at = Point();
+        if (glm::length(at - eye) < 1.0f)
+            return;
+        const glm::vec3 up = std::abs(glm::normalize(at - eye).y) > 0.99f
+                                 ? glm::vec3(0, 0, 1)
+                                 : glm::vec3(0, 1, 0);
+        const glm::mat4 view = glm::lookAt(eye, at, up);
+        const glm::mat4 proj =
+            glm::perspective(glm::radians(Uniform(30, 90)), Uniform(1, 2), 0.1f, Uniform(50, 400));
+        const Frustum frustum = Frustum::FromMatrix(proj * view);
+        CompareOverlap(
+            FrustumQuery, [&](const AABB& b) { return frustum.Test(b) != FrustumTest::Outside; },
+            [&](const auto& collect) { m_Tree.QueryFrustum(frustum, collect); });
+    }
+
+    void CheckRay()
+    {
+        const glm::vec3 origin = Point();
+        glm::vec3 direction = Point() - origin;
+        // Some rays run along an axis, where the slab test divides by zero.
+        if (Uniform(0, 1) < 0.1f)
+            direction = glm::vec3(0.0f, 0.0f, direction.z);
+        if (glm::length(direction) < 1.0f)
+            return;
+        const float maxT = Uniform(0.2f, 1.5f);
+        const glm::vec3 inv = 1.0f / direction;
+
+        using Hit = std::pair<s32, float>;
+        const auto scanAll = [&](std::vector<Hit>& out) {
+            for (const Entry& entry : m_Entries) {
+                if (entry.Proxy == DynamicAABBTree::c_NullNode)
+                    continue;
+                const float t = DynamicAABBTree::RayBoxEntry(origin, inv, entry.Box, maxT);
+                if (t >= 0.0f)
+                    out.emplace_back(entry.Proxy, t);
+            }
+        };
+        Compare<Hit>(
+            Ray,
+            [&](std::vector<Hit>& out) {
+                m_Tree.RayCast(origin, direction, maxT, [&](s32 proxy, u64, float t) {
+                    out.emplace_back(proxy, t);
+                    return maxT;
+                });
+            },
+            scanAll);
+
+        // Closest hit: only the entry distance is compared (ties may pick
+        // either box).
+        Compare<float>(
+            RayClosest,
+            [&](std::vector<float>& out) {
+                float closest = -1.0f;
+                m_Tree.RayCast(origin, direction, maxT, [&](s32, u64, float t) {
+                    closest = closest < 0.0f ? t : std::min(closest, t);
+                    return t;
+                });
+                if (closest >= 0.0f)
+                    out.push_back(closest);
+            },
+            [&](std::vector<float>& out) {
+                std::vector<Hit> hits;
+                scanAll(hits);
+                if (!hits.empty())
+                    out.push_back(std::min_element(hits.begin(), hits.end(),
+                        [](const Hit& a, const Hit& b) { return a.second < b.second; })->second);
+            });
+    }
+
+    void CheckNearest()
+    {
+        const glm::vec3 point = Point();
+        const auto count = std::uniform_int_distribution<u32>(1, 16)(m_Rng);
+        const float maxDistance = Uniform(5, 200);
+        // Distances only: equally distant boxes may be returned in any order.
+        Compare<float>(
+            Nearest,
+            [&](std::vector<float>& out) {
+                std::vector<std::pair<s32, float>> nearest;
+                m_Tree.FindNearest(point, count, maxDistance, nearest);
+                for (size_t i = 0; i < nearest.size(); ++i) {
+                    const auto [proxy, distanceSq] = nearest[i];
+                    // Reported distance must be the proxy's own, and nearest first.
+                    if (distanceSq != DynamicAABBTree::DistanceSquared(point,
+                                          m_Tree.GetBounds(proxy)) ||
+                        (i > 0 && distanceSq < nearest[i - 1].second))
+                        out.push_back(-1.0f);
+                    out.push_back(distanceSq);
+                }
+            },
+            [&](std::vector<float>& out) {
+                for (const Entry& entry : m_Entries) {
+                    if (entry.Proxy == DynamicAABBTree::c_NullNode)
+                        continue;
+                    const float d = DynamicAABBTree::DistanceSquared(point, entry.Box);
+                    if (d <= maxDistance * maxDistance)
+                        out.push_back(d);
+                }
+                std::sort(out.begin(), out.end());
+                if (out.size() > count)
+                    out.resize(count);
+            });
+    }
+
+    DynamicAABBTree m_Tree;
+    std::vector<Entry> m_Entries; // index = user data; destroyed ones keep their slot
+    u32 m_Target;
+    u32 m_Live = 0;
+    std::mt19937 m_Rng;
+    u32 m_Creates = 0, m_Destroys = 0, m_SmallMoves = 0, m_LongMoves = 0, m_Reinserts = 0;
+    u32 m_Mismatches = 0;
+    Stat m_Stats[KindCount] = {{"box"}, {"sphere"}, {"frustum"}, {"ray"}, {"closest"},
+                               {"nearest"}};
+};
+
+u32 Arg(int argc, char** argv, int index, u32 fallback)
+{
+    return argc > index ? static_cast<u32>(std::strtoul(argv[index], nullptr, 10)) : fallback;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const u32 proxies = std::max(Arg(argc, argv, 1, 100000), 1u);
+    const u32 rounds = Arg(argc, argv, 2, 20);
+    const u32 queries = Arg(argc, argv, 3, 50);
+    const u32 seed = Arg(argc, argv, 4, 1);
+    std::printf("DynamicAABBTree check: %u proxies, %u rounds x %u queries, seed %u\n", proxies,
+                rounds, queries, seed);
+    return Check(proxies, seed).Run(rounds, queries) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
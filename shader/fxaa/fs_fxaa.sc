@@ -0,0 +1,67 @@
+$input v_texcoord0
+
+#include "../common.sh"
+
+// FXAA over the tone-mapped (gamma-encoded) LDR image. Edges are found from the
+// luma of the 3x3 corners; an edge pixel is re-sampled with bilinear taps along
+// the edge direction, and the wider blend is kept unless it overshoots the local
+// luma range (then it crossed the edge and the narrow blend is used).
+SAMPLER2D(s_ldr, 0);
+
+// xy = 1 / target size in pixels.
+uniform vec4 u_fxaaParams;
+
+#define FXAA_REDUCE_MIN   (1.0 / 128.0)
+#define FXAA_REDUCE_MUL   (1.0 / 8.0)
+#define FXAA_SPAN_MAX     8.0
+#define FXAA_EDGE_MIN     (1.0 / 16.0)  // ignore contrast below this (flat areas)
+#define FXAA_EDGE_REL     (1.0 / 8.0)   // ... or below this fraction of the local max
+
+float fxaaLuma(vec3 rgb)
+{
+	return dot(rgb, vec3(0.299, 0.587, 0.114));
+}
+
+void main()
+{
+	vec2 texel = u_fxaaParams.xy;
+	vec2 uv    = v_texcoord0;
+
+	vec3 rgbM  = texture2D(s_ldr, uv).xyz;
+	float lumaM  = fxaaLuma(rgbM);
+	float lumaNW = fxaaLuma(texture2D(s_ldr, uv + vec2(-1.0, -1.0) * texel).xyz);
+	float lumaNE = fxaaLuma(texture2D(s_ldr, uv + vec2( 1.0, -1.0) * texel).xyz);
+	float lumaSW = fxaaLuma(texture2D(s_ldr, uv + vec2(-1.0,  1.0) * texel).xyz);
+	float lumaSE = fxaaLuma(texture2D(s_ldr, uv + vec2( 1.0,  1.0) * texel).xyz);
+
+	float lumaMin = min(lumaM, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+	float lumaMax = max(lumaM, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+
+	// Not an edge: keep the pixel (most of the frame takes this branch).
+	vec3 color = rgbM;
+	if (lumaMax - lumaMin >= max(FXAA_EDGE_MIN, lumaMax * FXAA_EDGE_REL))
+	{
+		// Direction along the edge (perpendicular to the luma gradient).
+		vec2 dir;
+		dir.x = -((lumaNW + lumaNE) - (lumaSW + lumaSE));
+		dir.y =   (lumaNW + lumaSW) - (lumaNE + lumaSE);
+
+		float dirReduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * (0.25 * FXAA_REDUCE_MUL),
+			FXAA_REDUCE_MIN);
+		float rcpDirMin = 1.0 / (min(abs(dir.x), abs(dir.y)) + dirReduce);
+		dir = clamp(dir * rcpDirMin, vec2_splat(-FXAA_SPAN_MAX), vec2_splat(FXAA_SPAN_MAX));
+		dir *= texel;
+
+		vec3 rgbA = 0.5 * (
+			texture2D(s_ldr, uv + dir * (1.0 / 3.0 - 0.5)).xyz +
+			texture2D(s_ldr, uv + dir * (2.0 / 3.0 - 0.5)).xyz);
+		vec3 rgbB = rgbA * 0.5 + 0.25 * (
+			texture2D(s_ldr, uv - dir * 0.5).xyz +
+			texture2D(s_ldr, uv + dir * 0.5).xyz);
+
+		float lumaB = fxaaLuma(rgbB);
+		color = (lumaB < lumaMin || lumaB > lumaMax) ? rgbA : rgbB;
+	}
+
+	gl_FragColor = vec4(color, 1.0);
+}
@@ -1,27 +1,89 @@
 #ifndef __SERAPH_LIGHTS_SH__
 #define __SERAPH_LIGHTS_SH__
 
-// Per-frame light + camera uniforms staged by SceneRenderer::UploadLightUniforms.
-// MAX_LIGHTS MUST match Seraph::c_MaxLights (Graphics/SceneRenderer.h): the arrays
-// are created and sized to it on the C++ side.
+// Per-frame lights, staged by SceneRenderer::UploadLightUniforms and binned by
+// Seraph::LightGrid (Graphics/LightGrid.h) into a clustered (Forward+) light
+// list. The defines below MUST match the constants there: the textures are
+// created and laid out from them on the C++ side.
 //
-// Packing (all vec4):
-//   u_lightCount.x              active light count (loop bound)
+// Uniforms (all vec4):
+//   u_lightCount.x              directional light count (light data rows [0, x))
 //   u_ambient.rgb               flat ambient radiance (color * intensity)
 //   u_cameraPos.xyz             camera world position
-//   u_lightPosRange[i]          xyz world position, w range (point/spot)
-//   u_lightColorIntensity[i]    rgb color, w intensity
-//   u_lightDirType[i]           xyz direction of travel, w type (0 dir/1 point/2 spot)
-//   u_lightSpot[i]              x spotScale, y spotOffset (cone: saturate(cosA*x + y))
+//   u_clusterParams             x slice scale, y slice bias, z originBottomLeft,
+//                               w active (0: no light grid bound, skip lights)
+//
+// Light data row i (LIGHT_DATA_TEXELS texels):
+//   0  xyz world position, w range (point/spot; 0 = unbounded)
+//   1  rgb color, w intensity
+//   2  xyz direction of travel, w type (0 dir/1 point/2 spot)
+//   3  x spotScale, y spotOffset (cone: saturate(cosA*x + y))
+//
+// A fragment's cluster is its screen tile (CLUSTER_X x CLUSTER_Y over the view
+// rect) and depth slice floor(log(viewZ) * scale - bias) of CLUSTER_Z; the grid
+// texel holds (first, count) into the light index list.
 
-#define MAX_LIGHTS 16
+#define MAX_LIGHTS             1024
+#define MAX_DIRECTIONAL_LIGHTS 4
+#define MAX_CLUSTER_LIGHTS     128
+#define CLUSTER_X              16
+#define CLUSTER_Y              9
+#define CLUSTER_Z              24
+#define LIGHT_DATA_TEXELS      4
+#define LIGHT_INDEX_WIDTH      256
+#define LIGHT_INDEX_HEIGHT     256
 
 uniform vec4 u_lightCount;
 uniform vec4 u_ambient;
 uniform vec4 u_cameraPos;
-uniform vec4 u_lightPosRange[MAX_LIGHTS];
-uniform vec4 u_lightColorIntensity[MAX_LIGHTS];
-uniform vec4 u_lightDirType[MAX_LIGHTS];
-uniform vec4 u_lightSpot[MAX_LIGHTS];
+uniform vec4 u_clusterParams;
+
+// Bound by the renderer next to the IBL (5-7) and shadow (8) stages.
+SAMPLER2D(s_lightData,    9);
+SAMPLER2D(s_lightGrid,    10);
+SAMPLER2D(s_lightIndices, 11);
+
+// Texel `column` of light data row `light`.
+vec4 LightTexel(int light, int column)
+{
+	vec2 uv = vec2((float(column) + 0.5) / float(LIGHT_DATA_TEXELS),
+	               (float(light)  + 0.5) / float(MAX_LIGHTS));
+	return texture2DLod(s_lightData, uv, 0.0);
+}
+
+// (first index-list entry, count) of the cluster holding a fragment at world
+// position `wpos` and window position `fragCoord` (gl_FragCoord.xy).
+vec2 ClusterLightRange(vec3 wpos, vec2 fragCoord)
+{
+	float viewZ = -mul(u_view, vec4(wpos, 1.0)).z;
+	float slice = floor(log(max(viewZ, 1e-4)) * u_clusterParams.x - u_clusterParams.y);
+	slice = clamp(slice, 0.0, float(CLUSTER_Z - 1));
+
+	// u_viewRect is measured down from the target's top edge. On GL
+	// gl_FragCoord.y counts up from its bottom (u_clusterParams.z = target
+	// height), and a rect smaller than the target does not reach that edge.
+	if (u_clusterParams.z > 0.0)
+		fragCoord.y = u_clusterParams.z - fragCoord.y;
+	// Tiles count up from the bottom like NDC y (the CPU bins in NDC).
+	vec2 f = (fragCoord - u_viewRect.xy) / u_viewRect.zw;
+	f.y = 1.0 - f.y;
+	vec2 tile = clamp(floor(f * vec2(CLUSTER_X, CLUSTER_Y)),
+	                  vec2_splat(0.0), vec2(CLUSTER_X - 1, CLUSTER_Y - 1));
+
+	vec2 uv = vec2((tile.y * float(CLUSTER_X) + tile.x + 0.5) / float(CLUSTER_X * CLUSTER_Y),
+	               (slice + 0.5) / float(CLUSTER_Z));
+	return texture2DLod(s_lightGrid, uv, 0.0).xy;
+}
+
+// Light data row stored at `entry` of the light index list.
+int ClusterLightIndex(int entry)
+{
+	float e = float(entry);
+	float row = floor(e / float(LIGHT_INDEX_WIDTH));
+	float col = e - row * float(LIGHT_INDEX_WIDTH);
+	vec2 uv = vec2((col + 0.5) / float(LIGHT_INDEX_WIDTH),
+	               (row + 0.5) / float(LIGHT_INDEX_HEIGHT));
+	return int(texture2DLod(s_lightIndices, uv, 0.0).x + 0.5);
+}
 
 #endif // __SERAPH_LIGHTS_SH__
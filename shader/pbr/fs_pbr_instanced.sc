@@ -0,0 +1,3 @@
+$input v_color0, v_texcoord0, v_wpos, v_normal, v_tangent
+
+#include "pbr.sh"
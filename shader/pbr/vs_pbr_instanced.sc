@@ -0,0 +1,25 @@
+$input a_position, a_color0, a_texcoord0, a_normal, a_tangent, i_data0, i_data1, i_data2, i_data3
+$output v_color0, v_texcoord0, v_wpos, v_normal, v_tangent
+
+#include "../common.sh"
+#include "../vertex.sh"
+
+// Instanced vs_pbr: the model matrix comes from the per-instance data stream
+// (four columns in i_data0..3, written by Renderer::SubmitInstanced) instead of
+// u_model[0]. Everything downstream matches vs_pbr.
+void main()
+{
+	mat4 model = mtxFromCols(i_data0, i_data1, i_data2, i_data3);
+
+	vec4 wpos = mul(model, vec4(decodePosition(a_position), 1.0));
+	v_wpos = wpos.xyz;
+	gl_Position = mul(u_viewProj, wpos);
+
+	vec4 tangent = decodeTangent(a_tangent);
+	v_normal = normalize(mul(cofactor(model), decodeNormal(a_normal)));
+	v_tangent.xyz = normalize(mul(model, vec4(tangent.xyz, 0.0)).xyz);
+	v_tangent.w = tangent.w;
+
+	v_texcoord0 = a_texcoord0;
+	v_color0 = a_color0;
+}
@@ -1 +0,0 @@
-vec3 a_position : POSITION;
\ No newline at end of file
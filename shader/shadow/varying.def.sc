@@ -1 +1,6 @@
 vec3 a_position : POSITION;
+
+vec4 i_data0    : TEXCOORD7;
+vec4 i_data1    : TEXCOORD6;
+vec4 i_data2    : TEXCOORD5;
+vec4 i_data3    : TEXCOORD4;
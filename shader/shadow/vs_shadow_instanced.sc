@@ -0,0 +1,12 @@
+$input a_position, i_data0, i_data1, i_data2, i_data3
+
+#include "../common.sh"
+#include "../vertex.sh"
+
+// Instanced depth-only caster: per-instance model matrix from i_data0..3, then
+// the shadow view's light view+proj (u_viewProj).
+void main()
+{
+	mat4 model = mtxFromCols(i_data0, i_data1, i_data2, i_data3);
+	gl_Position = mul(u_viewProj, mul(model, vec4(decodePosition(a_position), 1.0)));
+}
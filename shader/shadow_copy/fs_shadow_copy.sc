@@ -0,0 +1,19 @@
+$input v_texcoord0
+
+#include "../common.sh"
+
+// Cached shadow cascades: copy a cascade's static-caster tile into the frame
+// atlas as depth, before that frame's dynamic casters draw on top (see
+// Renderer::ComposeStaticShadow). Both atlases share one layout, so the
+// fragment's own atlas texel is the source; gl_FragCoord sidesteps the
+// per-backend UV flip and the tile origin.
+SAMPLER2D(s_shadowStatic, 0);
+
+// x = 1 / atlas size.
+uniform vec4 u_shadowCopyParams;
+
+void main()
+{
+	gl_FragColor = vec4_splat(0.0);
+	gl_FragDepth = texture2DLod(s_shadowStatic, gl_FragCoord.xy * u_shadowCopyParams.x, 0.0).x;
+}
@@ -7,12 +7,21 @@ $input v_texcoord0
 // output LINEAR light; this pass owns the sRGB gamma encode for the final image.
 SAMPLER2D(s_hdr, 0);
 
-// x = exposure multiplier, y = operator (0 None, 1 Reinhard, 2 ACES filmic).
+// x = exposure multiplier, y = operator (0 None, 1 Reinhard, 2 ACES filmic),
+// zw = half a source texel in UV (0 when the whole texture is the scene).
 uniform vec4 u_tonemapParams;
 
+// Region of s_hdr the scene covers (dynamic resolution): xy = UV scale,
+// zw = UV offset. The output's UVs map onto it, i.e. the region is upscaled.
+uniform vec4 u_tonemapRegion;
+
 void main()
 {
-	vec3 color = texture2D(s_hdr, v_texcoord0).xyz;
+	vec2 uvMin = u_tonemapRegion.zw + u_tonemapParams.zw;
+	vec2 uvMax = u_tonemapRegion.zw + u_tonemapRegion.xy - u_tonemapParams.zw;
+	vec2 uv = clamp(v_texcoord0 * u_tonemapRegion.xy + u_tonemapRegion.zw, uvMin, uvMax);
+
+	vec3 color = texture2D(s_hdr, uv).xyz;
 	color *= u_tonemapParams.x;
 
 	int op = int(u_tonemapParams.y + 0.5);
@@ -0,0 +1,43 @@
+#ifndef __SERAPH_VERTEX_SH__
+#define __SERAPH_VERTEX_SH__
+
+// Mesh vertex decode, for every vertex shader that reads mesh geometry. The
+// renderer sets u_meshDecode per draw from the Mesh (Renderer::BindVertexDecode),
+// so one program draws both the float and the compressed import formats
+// (MeshVertexFormat):
+//   u_meshDecode[0].xyz  position scale   (quantized: stored snorm16 in [-1, 1])
+//   u_meshDecode[0].w    1: a_normal.xy / a_tangent.xy are octahedral-encoded
+//   u_meshDecode[1].xyz  position offset
+// Float meshes get scale 1, offset 0, w 0.
+//
+// Compressed tangents are unorm8: xy the octahedral tangent remapped to [0, 1],
+// z the bitangent sign (0 -> -1, 1 -> +1).
+
+uniform vec4 u_meshDecode[2];
+
+vec3 octDecode(vec2 e)
+{
+	vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+	// Unfold the lower hemisphere (n.z < 0) back over the diagonals.
+	float t = max(-n.z, 0.0);
+	n.xy -= t * (step(vec2_splat(0.0), n.xy) * 2.0 - 1.0);
+	return normalize(n);
+}
+
+vec3 decodePosition(vec3 position)
+{
+	return position * u_meshDecode[0].xyz + u_meshDecode[1].xyz;
+}
+
+vec3 decodeNormal(vec3 normal)
+{
+	return mix(normal, octDecode(normal.xy), u_meshDecode[0].w);
+}
+
+vec4 decodeTangent(vec4 tangent)
+{
+	vec4 octahedral = vec4(octDecode(tangent.xy * 2.0 - 1.0), tangent.z * 2.0 - 1.0);
+	return mix(tangent, octahedral, u_meshDecode[0].w);
+}
+
+#endif // __SERAPH_VERTEX_SH__